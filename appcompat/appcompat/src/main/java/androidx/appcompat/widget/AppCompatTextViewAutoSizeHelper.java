@@ -23,12 +23,15 @@ import android.content.Context;
 import android.content.res.Resources;
 import android.content.res.TypedArray;
 import android.graphics.RectF;
+import android.graphics.Typeface;
 import android.os.Build;
 import android.text.Layout;
+import android.text.Spanned;
 import android.text.StaticLayout;
 import android.text.TextDirectionHeuristic;
 import android.text.TextDirectionHeuristics;
 import android.text.TextPaint;
+import android.text.TextUtils;
 import android.text.method.TransformationMethod;
 import android.util.AttributeSet;
 import android.util.DisplayMetrics;
@@ -42,6 +45,7 @@ import androidx.annotation.RequiresApi;
 import androidx.annotation.RestrictTo;
 import androidx.annotation.VisibleForTesting;
 import androidx.appcompat.R;
+import androidx.collection.LruCache;
 import androidx.core.view.ViewCompat;
 import androidx.core.widget.TextViewCompat;
 
@@ -50,6 +54,7 @@ import java.util.ArrayList;
 import java.util.Arrays;
 import java.util.Collections;
 import java.util.List;
+import java.util.Locale;
 
 /**
  * Utility class which encapsulates the logic for the TextView auto-size text feature added to
@@ -77,6 +82,11 @@ class AppCompatTextViewAutoSizeHelper {
     // Ported from TextView#VERY_WIDE. Represents a maximum width in pixels the TextView takes when
     // horizontal scrolling is activated.
     private static final int VERY_WIDE = 1024 * 1024;
+    // Sizes found by findLargestTextSizeWhichFits for texts without spans, shared by all views
+    // so that list rows showing the same text in the same space skip the search.
+    private static final LruCache<FitKey, Integer> sFittedTextSizeCache = new LruCache<>(100);
+    // Lookup key filled on every search, guarded by TEMP_RECTF.
+    private static final FitKey TEMP_FIT_KEY = new FitKey();
     // Auto-size text type.
     private int mAutoSizeTextType = TextViewCompat.AUTO_SIZE_TEXT_TYPE_NONE;
     // Specify if auto-size text is needed.
@@ -95,6 +105,11 @@ class AppCompatTextViewAutoSizeHelper {
     // mAutoSizeStepGranularityInPx.
     private boolean mHasPresetAutoSizeValues = false;
     private TextPaint mTempTextPaint;
+    // The inputs of the last search of this view, or null if they could not be cached, and the
+    // size it found, which also seeds the next search.
+    @Nullable
+    private FitKey mLastFitKey;
+    private int mLastFitTextSizeInPx;
 
     @NonNull
     private final TextView mTextView;
@@ -672,8 +687,10 @@ class AppCompatTextViewAutoSizeHelper {
     }
 
     /**
-     * Performs a binary search to find the largest text size that will still fit within the size
-     * available to this view.
+     * Finds the largest text size that will still fit within the size available to this view.
+     * The result is looked up first in the results of previous searches with the same text,
+     * space and paint configuration, and otherwise searched for starting from the size the last
+     * search of this view found.
      */
     private int findLargestTextSizeWhichFits(RectF availableSpace) {
         final int sizesCount = mAutoSizeTextSizesInPx.length;
@@ -681,22 +698,80 @@ class AppCompatTextViewAutoSizeHelper {
             throw new IllegalStateException("No available text sizes to choose from.");
         }
 
+        final FitKey key = TEMP_FIT_KEY;
+        final boolean cacheable = key.set(getTransformedText(), availableSpace, mTextView,
+                mAutoSizeTextSizesInPx);
+        if (cacheable && key.equals(mLastFitKey)) {
+            key.mText = null;
+            return mLastFitTextSizeInPx;
+        }
+
+        final Integer cachedSize = cacheable ? sFittedTextSizeCache.get(key) : null;
+        final int textSize;
+        if (cachedSize != null) {
+            textSize = cachedSize;
+        } else {
+            textSize = mAutoSizeTextSizesInPx[findLargestTextSizeIndexWhichFits(availableSpace)];
+        }
+        if (cacheable) {
+            mLastFitKey = key.copy();
+            if (cachedSize == null) {
+                sFittedTextSizeCache.put(mLastFitKey, textSize);
+            }
+        } else {
+            mLastFitKey = null;
+        }
+        // Do not keep the view's text alive from the static key.
+        key.mText = null;
+        mLastFitTextSizeInPx = textSize;
+        return textSize;
+    }
+
+    /**
+     * Performs a binary search to find the index of the largest text size that will still fit
+     * within the size available to this view. The size of the previous search and its neighbours
+     * are tried first, as a relayout or a rebind with similar text usually ends up there.
+     */
+    private int findLargestTextSizeIndexWhichFits(RectF availableSpace) {
+        final int[] sizes = mAutoSizeTextSizesInPx;
         int bestSizeIndex = 0;
         int lowIndex = bestSizeIndex + 1;
-        int highIndex = sizesCount - 1;
+        int highIndex = sizes.length - 1;
+
+        final int seedIndex = Arrays.binarySearch(sizes, mLastFitTextSizeInPx);
+        if (seedIndex > 0) {
+            if (suggestedSizeFitsInSpace(sizes[seedIndex], availableSpace)) {
+                bestSizeIndex = seedIndex;
+                lowIndex = seedIndex + 1;
+                if (lowIndex <= highIndex) {
+                    if (!suggestedSizeFitsInSpace(sizes[lowIndex], availableSpace)) {
+                        return bestSizeIndex;
+                    }
+                    bestSizeIndex = lowIndex++;
+                }
+            } else {
+                highIndex = seedIndex - 1;
+                if (highIndex >= lowIndex) {
+                    if (suggestedSizeFitsInSpace(sizes[highIndex], availableSpace)) {
+                        return highIndex;
+                    }
+                    highIndex--;
+                }
+            }
+        }
+
         int sizeToTryIndex;
         while (lowIndex <= highIndex) {
             sizeToTryIndex = (lowIndex + highIndex) / 2;
-            if (suggestedSizeFitsInSpace(mAutoSizeTextSizesInPx[sizeToTryIndex], availableSpace)) {
-                bestSizeIndex = lowIndex;
+            if (suggestedSizeFitsInSpace(sizes[sizeToTryIndex], availableSpace)) {
+                bestSizeIndex = sizeToTryIndex;
                 lowIndex = sizeToTryIndex + 1;
             } else {
                 highIndex = sizeToTryIndex - 1;
-                bestSizeIndex = highIndex;
             }
         }
 
-        return mAutoSizeTextSizesInPx[bestSizeIndex];
+        return bestSizeIndex;
     }
 
     @VisibleForTesting
@@ -736,7 +811,7 @@ class AppCompatTextViewAutoSizeHelper {
         }
     }
 
-    private boolean suggestedSizeFitsInSpace(int suggestedSizeInPx, RectF availableSpace) {
+    private CharSequence getTransformedText() {
         CharSequence text = mTextView.getText();
         TransformationMethod transformationMethod = mTextView.getTransformationMethod();
         if (transformationMethod != null) {
@@ -745,7 +820,11 @@ class AppCompatTextViewAutoSizeHelper {
                 text = transformedText;
             }
         }
+        return text;
+    }
 
+    private boolean suggestedSizeFitsInSpace(int suggestedSizeInPx, RectF availableSpace) {
+        final CharSequence text = getTransformedText();
         final int maxLines = mTextView.getMaxLines();
         initTempTextPaint(suggestedSizeInPx);
 
@@ -832,6 +911,173 @@ class AppCompatTextViewAutoSizeHelper {
         return !(mTextView instanceof AppCompatEditText);
     }
 
+    /**
+     * The inputs of {@link #findLargestTextSizeWhichFits}: the text, the available space and
+     * everything about the view and its paint that changes how the text breaks into lines,
+     * except the text size being searched for.
+     */
+    private static final class FitKey {
+        // A String in copies, the view's text itself in TEMP_FIT_KEY.
+        CharSequence mText;
+        int mWidth;
+        int mHeight;
+        int mMaxLines;
+        int[] mTextSizes;
+        Typeface mTypeface;
+        int mPaintFlags;
+        float mTextScaleX;
+        float mTextSkewX;
+        float mLetterSpacing;
+        String mFontFeatureSettings;
+        String mFontVariationSettings;
+        Locale mTextLocale;
+        float mLineSpacingExtra;
+        float mLineSpacingMultiplier;
+        boolean mIncludeFontPadding;
+        int mBreakStrategy;
+        int mHyphenationFrequency;
+        int mTextDirection;
+        int mLayoutDirection;
+        int mHashCode;
+
+        FitKey() {
+        }
+
+        /**
+         * Fills this key from the view, returning false if the text has spans, whose styles it
+         * cannot compare.
+         */
+        boolean set(@NonNull CharSequence text, @NonNull RectF availableSpace,
+                @NonNull TextView textView, @NonNull int[] textSizes) {
+            mText = text;
+            if (text instanceof Spanned) {
+                return false;
+            }
+            final TextPaint paint = textView.getPaint();
+            mWidth = Math.round(availableSpace.right);
+            mHeight = Math.round(availableSpace.bottom);
+            mMaxLines = textView.getMaxLines();
+            mTextSizes = textSizes;
+            mTypeface = paint.getTypeface();
+            mPaintFlags = paint.getFlags();
+            mTextScaleX = paint.getTextScaleX();
+            mTextSkewX = paint.getTextSkewX();
+            if (Build.VERSION.SDK_INT >= 21) {
+                mLetterSpacing = Api21Impl.getLetterSpacing(paint);
+                mFontFeatureSettings = Api21Impl.getFontFeatureSettings(paint);
+            }
+            if (Build.VERSION.SDK_INT >= 26) {
+                mFontVariationSettings = Api26Impl.getFontVariationSettings(paint);
+            }
+            mTextLocale = paint.getTextLocale();
+            mLineSpacingExtra = textView.getLineSpacingExtra();
+            mLineSpacingMultiplier = textView.getLineSpacingMultiplier();
+            mIncludeFontPadding = textView.getIncludeFontPadding();
+            if (Build.VERSION.SDK_INT >= 23) {
+                mBreakStrategy = textView.getBreakStrategy();
+                mHyphenationFrequency = textView.getHyphenationFrequency();
+            }
+            mTextDirection = textView.getTextDirection();
+            mLayoutDirection = textView.getLayoutDirection();
+
+            int hash = text.length();
+            for (int i = 0, length = text.length(); i < length; i++) {
+                hash = 31 * hash + text.charAt(i);
+            }
+            hash = 31 * hash + mWidth;
+            hash = 31 * hash + mHeight;
+            hash = 31 * hash + mMaxLines;
+            hash = 31 * hash + Arrays.hashCode(textSizes);
+            hash = 31 * hash + (mTypeface != null ? mTypeface.hashCode() : 0);
+            hash = 31 * hash + mPaintFlags;
+            hash = 31 * hash + Float.floatToIntBits(mLetterSpacing);
+            mHashCode = hash;
+            return true;
+        }
+
+        @NonNull
+        FitKey copy() {
+            final FitKey copy = new FitKey();
+            copy.mText = mText.toString();
+            copy.mWidth = mWidth;
+            copy.mHeight = mHeight;
+            copy.mMaxLines = mMaxLines;
+            copy.mTextSizes = mTextSizes;
+            copy.mTypeface = mTypeface;
+            copy.mPaintFlags = mPaintFlags;
+            copy.mTextScaleX = mTextScaleX;
+            copy.mTextSkewX = mTextSkewX;
+            copy.mLetterSpacing = mLetterSpacing;
+            copy.mFontFeatureSettings = mFontFeatureSettings;
+            copy.mFontVariationSettings = mFontVariationSettings;
+            copy.mTextLocale = mTextLocale;
+            copy.mLineSpacingExtra = mLineSpacingExtra;
+            copy.mLineSpacingMultiplier = mLineSpacingMultiplier;
+            copy.mIncludeFontPadding = mIncludeFontPadding;
+            copy.mBreakStrategy = mBreakStrategy;
+            copy.mHyphenationFrequency = mHyphenationFrequency;
+            copy.mTextDirection = mTextDirection;
+            copy.mLayoutDirection = mLayoutDirection;
+            copy.mHashCode = mHashCode;
+            return copy;
+        }
+
+        @Override
+        public boolean equals(Object o) {
+            if (this == o) {
+                return true;
+            }
+            if (!(o instanceof FitKey)) {
+                return false;
+            }
+            final FitKey other = (FitKey) o;
+            return mHashCode == other.mHashCode
+                    && mWidth == other.mWidth
+                    && mHeight == other.mHeight
+                    && mMaxLines == other.mMaxLines
+                    && mTypeface == other.mTypeface
+                    && mPaintFlags == other.mPaintFlags
+                    && mTextScaleX == other.mTextScaleX
+                    && mTextSkewX == other.mTextSkewX
+                    && mLetterSpacing == other.mLetterSpacing
+                    && mLineSpacingExtra == other.mLineSpacingExtra
+                    && mLineSpacingMultiplier == other.mLineSpacingMultiplier
+                    && mIncludeFontPadding == other.mIncludeFontPadding
+                    && mBreakStrategy == other.mBreakStrategy
+                    && mHyphenationFrequency == other.mHyphenationFrequency
+                    && mTextDirection == other.mTextDirection
+                    && mLayoutDirection == other.mLayoutDirection
+                    && TextUtils.equals(mFontFeatureSettings, other.mFontFeatureSettings)
+                    && TextUtils.equals(mFontVariationSettings, other.mFontVariationSettings)
+                    && (mTextLocale == null ? other.mTextLocale == null
+                            : mTextLocale.equals(other.mTextLocale))
+                    && (mTextSizes == other.mTextSizes
+                            || Arrays.equals(mTextSizes, other.mTextSizes))
+                    && TextUtils.equals(mText, other.mText);
+        }
+
+        @Override
+        public int hashCode() {
+            return mHashCode;
+        }
+    }
+
+    @RequiresApi(21)
+    private static final class Api21Impl {
+        private Api21Impl() {
+            // This class is not instantiable.
+        }
+
+        static float getLetterSpacing(@NonNull TextPaint paint) {
+            return paint.getLetterSpacing();
+        }
+
+        @Nullable
+        static String getFontFeatureSettings(@NonNull TextPaint paint) {
+            return paint.getFontFeatureSettings();
+        }
+    }
+
     @RequiresApi(23)
     private static final class Api23Impl {
         private Api23Impl() {
@@ -871,4 +1117,16 @@ class AppCompatTextViewAutoSizeHelper {
             return layoutBuilder.build();
         }
     }
+
+    @RequiresApi(26)
+    private static final class Api26Impl {
+        private Api26Impl() {
+            // This class is not instantiable.
+        }
+
+        @Nullable
+        static String getFontVariationSettings(@NonNull TextPaint paint) {
+            return paint.getFontVariationSettings();
+        }
+    }
 }
@@ -1354,10 +1354,14 @@ public class SeslProgressBar extends View {
         }
     }
 
+    /**
+     * Defers to {@link #postInvalidateOnAnimation()}, so that any number of calls made before the
+     * next frame, from any thread, result in a single invalidate on that frame.
+     */
     @Override
     public void postInvalidate() {
         if (!mNoInvalidate) {
-            super.postInvalidate();
+            super.postInvalidateOnAnimation();
         }
     }
 
@@ -1524,10 +1528,19 @@ public class SeslProgressBar extends View {
                 mRefreshProgressRunnable = new RefreshProgressRunnable();
             }
 
-            final RefreshData rd = RefreshData.obtain(id, progress, fromUser, animate);
-            mRefreshData.add(rd);
+            // Only the latest of several updates made to the same indicator before the next frame
+            // is applied, so a worker thread reporting progress faster than the display refreshes
+            // costs one refresh per frame.
+            final int count = mRefreshData.size();
+            final RefreshData last = count > 0 ? mRefreshData.get(count - 1) : null;
+            if (last != null && last.id == id && last.fromUser == fromUser
+                    && last.animate == animate) {
+                last.progress = progress;
+            } else {
+                mRefreshData.add(RefreshData.obtain(id, progress, fromUser, animate));
+            }
             if (mAttached && !mRefreshIsPosted) {
-                post(mRefreshProgressRunnable);
+                postOnAnimation(mRefreshProgressRunnable);
                 mRefreshIsPosted = true;
             }
         }
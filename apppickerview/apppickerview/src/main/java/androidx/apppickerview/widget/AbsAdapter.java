@@ -37,11 +37,15 @@ import androidx.annotation.NonNull;
 import androidx.annotation.Nullable;
 import androidx.annotation.RestrictTo;
 import androidx.core.content.ContextCompat;
+import androidx.recyclerview.widget.DiffUtil;
 import androidx.recyclerview.widget.RecyclerView;
 import androidx.reflect.text.SeslTextUtilsReflector;
 
+import java.text.CollationKey;
 import java.text.Collator;
 import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.Collections;
 import java.util.Comparator;
 import java.util.HashMap;
 import java.util.List;
@@ -68,6 +72,14 @@ public abstract class AbsAdapter extends RecyclerView.Adapter<RecyclerView.ViewH
     final List<AppPickerView.AppLabelInfo> mDataSet = new ArrayList<>();
     final List<AppPickerView.AppLabelInfo> mDataSetFiltered = new ArrayList<>();
     private final Map<String, Integer> mSectionMap = new HashMap<>();
+    // Section label of each app label, for the locales in mSectionLocales
+    private final Map<String, String> mSectionLabelCache = new HashMap<>();
+    private LocaleList mSectionLocales;
+    private AlphabeticIndex.ImmutableIndex<Integer> mSectionIndex;
+    // Copy of mDataSetFiltered that the filter diffs its results against
+    volatile List<AppPickerView.AppLabelInfo> mFilteredSnapshot = Collections.emptyList();
+    volatile SearchIndex mSearchIndex = new SearchIndex(Collections.emptyList());
+    private Filter mFilter;
     private String[] mSections = new String[0];
     String mSearchText = "";
 
@@ -77,6 +89,8 @@ public abstract class AbsAdapter extends RecyclerView.Adapter<RecyclerView.ViewH
     private int mOrder;
     private int[] mPositionToSectionIndex;
     protected int mType;
+    // Drops async label results of superseded resetPackages calls
+    private int mResetGeneration = 0;
 
     public AbsAdapter(@NonNull Context context, int type, int order, @Nullable AppPickerIconLoader iconLoader, boolean showDivider) {
         mContext = context;
@@ -114,14 +128,39 @@ public abstract class AbsAdapter extends RecyclerView.Adapter<RecyclerView.ViewH
             List<AppPickerView.AppLabelInfo> labelInfoList,
             List<ComponentName> activityNamesList) {
         Log.i(TAG, "Start resetpackage dataSetchanged : " + dataSetchanged);
+        mResetGeneration++;
+        setDataSet(DataManager.resetPackages(mContext, packageNamesList, labelInfoList,
+                activityNamesList), dataSetchanged);
+        Log.i(TAG, "End resetpackage");
+    }
+
+    /**
+     * Like {@link #resetPackages(List, boolean, List, List)}, but shows the cached labels right
+     * away and refreshes the list once the missing labels were loaded in the background.
+     */
+    void resetPackagesAsync(List<String> packageNamesList,
+            List<AppPickerView.AppLabelInfo> labelInfoList,
+            List<ComponentName> activityNamesList) {
+        final int generation = ++mResetGeneration;
+        setDataSet(DataManager.resetPackagesAsync(mContext, packageNamesList, labelInfoList,
+                activityNamesList, new DataManager.OnLabelsLoadedListener() {
+                    @Override
+                    public void onLabelsLoaded(
+                            @NonNull List<AppPickerView.AppLabelInfo> appLabelInfoList) {
+                        if (generation == mResetGeneration) {
+                            setDataSet(appLabelInfoList, true);
+                        }
+                    }
+                }), true);
+    }
 
+    private void setDataSet(List<AppPickerView.AppLabelInfo> appLabelInfoList,
+            boolean dataSetchanged) {
         mDataSet.clear();
-        mDataSet.addAll(DataManager.resetPackages(mContext, packageNamesList, labelInfoList, activityNamesList));
+        mDataSet.addAll(appLabelInfoList);
 
         if (Build.VERSION.SDK_INT >= 24) {
-            if (getAppLabelComparator(mOrder) != null) {
-                mDataSet.sort(getAppLabelComparator(mOrder));
-            }
+            sortByLabel(mDataSet, mOrder);
         }
 
         if (hasAllAppsInList()) {
@@ -133,14 +172,13 @@ public abstract class AbsAdapter extends RecyclerView.Adapter<RecyclerView.ViewH
         }
         mDataSetFiltered.clear();
         mDataSetFiltered.addAll(mDataSet);
+        mSearchIndex = new SearchIndex(mDataSet);
 
         refreshSectionMap();
 
         if (dataSetchanged) {
             notifyDataSetChanged();
         }
-
-        Log.i(TAG, "End resetpackage");
     }
 
     void addPackage(int position, String label) {
@@ -148,6 +186,7 @@ public abstract class AbsAdapter extends RecyclerView.Adapter<RecyclerView.ViewH
                 new AppPickerView.AppLabelInfo("", label, ""));
         mDataSetFiltered.clear();
         mDataSetFiltered.addAll(mDataSet);
+        mSearchIndex = new SearchIndex(mDataSet);
 
         refreshSectionMap();
         notifyItemInserted(position);
@@ -159,6 +198,7 @@ public abstract class AbsAdapter extends RecyclerView.Adapter<RecyclerView.ViewH
                         "", "").setSeparator(true));
         mDataSetFiltered.clear();
         mDataSetFiltered.addAll(mDataSet);
+        mSearchIndex = new SearchIndex(mDataSet);
 
         refreshSectionMap();
         notifyItemInserted(position);
@@ -167,27 +207,57 @@ public abstract class AbsAdapter extends RecyclerView.Adapter<RecyclerView.ViewH
     public void setOrder(int order) {
         mOrder = order;
         if (Build.VERSION.SDK_INT >= 24) {
-            if (getAppLabelComparator(order) != null) {
-                mDataSet.sort(getAppLabelComparator(order));
-                mDataSetFiltered.sort(getAppLabelComparator(order));
-            }
+            sortByLabel(mDataSet, order);
+            sortByLabel(mDataSetFiltered, order);
         }
+        mSearchIndex = new SearchIndex(mDataSet);
         refreshSectionMap();
         notifyDataSetChanged();
     }
 
-    private Comparator<AppPickerView.AppLabelInfo> getAppLabelComparator(int order) {
+    /**
+     * Sorts by label in the given order. Collation keys are computed once per label instead of
+     * collating both labels on every comparison.
+     */
+    private static void sortByLabel(List<AppPickerView.AppLabelInfo> list, int order) {
+        final int strength;
+        final boolean descending;
         switch (order) {
             case AppPickerView.ORDER_ASCENDING:
-                return APP_LABEL_ASCENDING;
+                strength = Collator.TERTIARY;
+                descending = false;
+                break;
             case AppPickerView.ORDER_ASCENDING_IGNORE_CASE:
-                return APP_LABEL_ASCENDING_IGNORE_CASE;
+                strength = Collator.PRIMARY;
+                descending = false;
+                break;
             case AppPickerView.ORDER_DESCENDING:
-                return APP_LABEL_DESCENDING;
+                strength = Collator.TERTIARY;
+                descending = true;
+                break;
             case AppPickerView.ORDER_DESCENDING_IGNORE_CASE:
-                return APP_LABEL_DESCENDING_IGNORE_CASE;
+                strength = Collator.PRIMARY;
+                descending = true;
+                break;
+            default:
+                return;
         }
-        return null;
+
+        final Collator collator = Collator.getInstance(Locale.getDefault());
+        collator.setStrength(strength);
+        final HashMap<AppPickerView.AppLabelInfo, CollationKey> keys =
+                new HashMap<>(list.size() * 2);
+        for (AppPickerView.AppLabelInfo labelInfo : list) {
+            final String label = labelInfo.getLabel();
+            keys.put(labelInfo, collator.getCollationKey(label != null ? label : ""));
+        }
+        final Comparator<AppPickerView.AppLabelInfo> comparator = new Comparator<>() {
+            public int compare(AppPickerView.AppLabelInfo a, AppPickerView.AppLabelInfo b) {
+                final int result = keys.get(a).compareTo(keys.get(b));
+                return descending ? -result : result;
+            }
+        };
+        Collections.sort(list, comparator);
     }
 
     @Override
@@ -291,43 +361,58 @@ public abstract class AbsAdapter extends RecyclerView.Adapter<RecyclerView.ViewH
 
     @Override
     public Filter getFilter() {
-        return new Filter() {
+        // Reuse one Filter so that keystrokes are filtered in order on its single worker thread
+        if (mFilter != null) {
+            return mFilter;
+        }
+        mFilter = new Filter() {
             @Override
             protected FilterResults performFiltering(CharSequence constraint) {
                 final String searchText = constraint.toString();
+                final String previousSearchText = mSearchText;
+                final List<AppPickerView.AppLabelInfo> oldList = mFilteredSnapshot;
+                final SearchIndex searchIndex = mSearchIndex;
                 Filter.FilterResults results = new Filter.FilterResults();
 
+                final List<AppPickerView.AppLabelInfo> newList;
                 if (searchText.isEmpty()) {
                     mSearchText = "";
-                    results.values = mDataSet;
+                    newList = searchIndex.getItems();
                 } else {
                     mSearchText = searchText;
+                    newList = searchIndex.filter(searchText);
+                }
 
-                    ArrayList<AppPickerView.AppLabelInfo> dataSetFiltered = new ArrayList<>();
-                    for (AppPickerView.AppLabelInfo labelInfo : mDataSet) {
-                        if (!AppPickerView.ALL_APPS_STRING.equals(labelInfo.getPackageName())) {
-                            final String label = labelInfo.getLabel();
-                            if (!TextUtils.isEmpty(label)) {
-                                StringTokenizer tokenizer = new StringTokenizer(searchText.toLowerCase());
-                                boolean showItem = true;
-                                String lowerCase = label.toLowerCase();
-
-                                while (tokenizer.hasMoreTokens()) {
-                                    if (!lowerCase.contains(tokenizer.nextToken())) {
-                                        showItem = false;
-                                        break;
-                                    }
-                                }
-
-                                if (showItem) {
-                                    dataSetFiltered.add(labelInfo);
-                                }
+                // the highlighted part of the labels changes with the search text
+                final boolean rebindItems = !previousSearchText.equals(mSearchText);
+                final DiffUtil.DiffResult diffResult =
+                        DiffUtil.calculateDiff(new DiffUtil.Callback() {
+                            @Override
+                            public int getOldListSize() {
+                                return oldList.size();
                             }
-                        }
-                    }
 
-                    results.values = dataSetFiltered;
-                }
+                            @Override
+                            public int getNewListSize() {
+                                return newList.size();
+                            }
+
+                            @Override
+                            public boolean areItemsTheSame(int oldItemPosition,
+                                    int newItemPosition) {
+                                return oldList.get(oldItemPosition)
+                                        == newList.get(newItemPosition);
+                            }
+
+                            @Override
+                            public boolean areContentsTheSame(int oldItemPosition,
+                                    int newItemPosition) {
+                                return !rebindItems;
+                            }
+                        }, false);
+
+                results.values = new FilteredDataSet(oldList, newList, diffResult);
+                results.count = newList.size();
                 return results;
             }
 
@@ -338,17 +423,162 @@ public abstract class AbsAdapter extends RecyclerView.Adapter<RecyclerView.ViewH
                 } else {
                     mHideAllApps = true;
                 }
+                final FilteredDataSet filtered = (FilteredDataSet) results.values;
+                // the diff only applies if the list was not changed while filtering
+                final boolean diffValid = filtered.mOldList == mFilteredSnapshot;
                 mDataSetFiltered.clear();
-                mDataSetFiltered.addAll((ArrayList<AppPickerView.AppLabelInfo>) results.values);
+                mDataSetFiltered.addAll(filtered.mNewList);
 
                 refreshSectionMap();
-                notifyDataSetChanged();
+                if (diffValid) {
+                    filtered.mDiffResult.dispatchUpdatesTo(AbsAdapter.this);
+                } else {
+                    notifyDataSetChanged();
+                }
 
                 if (mOnSearchFilterListener != null) {
                     mOnSearchFilterListener.onSearchFilterCompleted(getItemCount());
                 }
             }
         };
+        return mFilter;
+    }
+
+    private static final class FilteredDataSet {
+        final List<AppPickerView.AppLabelInfo> mOldList;
+        final List<AppPickerView.AppLabelInfo> mNewList;
+        final DiffUtil.DiffResult mDiffResult;
+
+        FilteredDataSet(List<AppPickerView.AppLabelInfo> oldList,
+                List<AppPickerView.AppLabelInfo> newList, DiffUtil.DiffResult diffResult) {
+            mOldList = oldList;
+            mNewList = newList;
+            mDiffResult = diffResult;
+        }
+    }
+
+    /**
+     * Search index over a snapshot of the data set: lowercase labels and a trigram index that
+     * narrows the labels to check for a query. When a query extends the previous one, only the
+     * previous results are checked again, since they are a superset of the new ones.
+     */
+    static final class SearchIndex {
+        private static final int TRIGRAM_LENGTH = 3;
+
+        private final AppPickerView.AppLabelInfo[] mItems;
+        private String[] mLowerCaseLabels;
+        private HashMap<Long, int[]> mTrigrams;
+        private String mLastQuery;
+        private int[] mLastMatches;
+        private int mLastMatchCount;
+
+        SearchIndex(List<AppPickerView.AppLabelInfo> items) {
+            mItems = items.toArray(new AppPickerView.AppLabelInfo[0]);
+        }
+
+        List<AppPickerView.AppLabelInfo> getItems() {
+            final ArrayList<AppPickerView.AppLabelInfo> items = new ArrayList<>(mItems.length);
+            Collections.addAll(items, mItems);
+            return items;
+        }
+
+        private static long trigramKey(String text, int start) {
+            return ((long) text.charAt(start) << 32) | ((long) text.charAt(start + 1) << 16)
+                    | text.charAt(start + 2);
+        }
+
+        // Built lazily on the filter thread
+        private void ensureBuilt() {
+            if (mLowerCaseLabels != null) {
+                return;
+            }
+            mLowerCaseLabels = new String[mItems.length];
+            final HashMap<Long, int[]> postings = new HashMap<>();
+            // posting lists are grown in place, their last slot holds their size
+            for (int i = 0; i < mItems.length; i++) {
+                final String label = mItems[i].getLabel();
+                if (TextUtils.isEmpty(label)
+                        || AppPickerView.ALL_APPS_STRING.equals(mItems[i].getPackageName())) {
+                    continue;
+                }
+                final String lowerCase = label.toLowerCase();
+                mLowerCaseLabels[i] = lowerCase;
+                for (int j = 0; j + TRIGRAM_LENGTH <= lowerCase.length(); j++) {
+                    final Long key = trigramKey(lowerCase, j);
+                    int[] posting = postings.get(key);
+                    if (posting == null) {
+                        posting = new int[4];
+                    }
+                    final int size = posting[posting.length - 1];
+                    if (size > 0 && posting[size - 1] == i) {
+                        continue;
+                    }
+                    if (size == posting.length - 1) {
+                        posting = Arrays.copyOf(posting, posting.length * 2);
+                        posting[posting.length - 1] = size;
+                    }
+                    posting[size] = i;
+                    posting[posting.length - 1] = size + 1;
+                    postings.put(key, posting);
+                }
+            }
+            mTrigrams = postings;
+        }
+
+        synchronized List<AppPickerView.AppLabelInfo> filter(String searchText) {
+            ensureBuilt();
+            final String query = searchText.toLowerCase();
+            final ArrayList<String> tokens = new ArrayList<>();
+            StringTokenizer tokenizer = new StringTokenizer(query);
+            while (tokenizer.hasMoreTokens()) {
+                tokens.add(tokenizer.nextToken());
+            }
+
+            // candidates are either the previous matches or the rarest trigram of the query
+            int[] candidates = null;
+            int candidateCount = mItems.length;
+            if (mLastQuery != null && query.startsWith(mLastQuery)) {
+                candidates = mLastMatches;
+                candidateCount = mLastMatchCount;
+            }
+            for (String token : tokens) {
+                for (int j = 0; j + TRIGRAM_LENGTH <= token.length(); j++) {
+                    final int[] posting = mTrigrams.get(trigramKey(token, j));
+                    final int size = posting != null ? posting[posting.length - 1] : 0;
+                    if (size < candidateCount) {
+                        candidates = posting;
+                        candidateCount = size;
+                    }
+                }
+            }
+
+            final int[] matches = new int[candidateCount];
+            int matchCount = 0;
+            final ArrayList<AppPickerView.AppLabelInfo> result = new ArrayList<>();
+            for (int c = 0; c < candidateCount; c++) {
+                final int index = candidates != null ? candidates[c] : c;
+                final String lowerCase = mLowerCaseLabels[index];
+                if (lowerCase == null) {
+                    continue;
+                }
+                boolean showItem = true;
+                for (int t = 0; t < tokens.size(); t++) {
+                    if (!lowerCase.contains(tokens.get(t))) {
+                        showItem = false;
+                        break;
+                    }
+                }
+                if (showItem) {
+                    matches[matchCount++] = index;
+                    result.add(mItems[index]);
+                }
+            }
+
+            mLastQuery = query;
+            mLastMatches = matches;
+            mLastMatchCount = matchCount;
+            return result;
+        }
     }
 
     @Override
@@ -372,7 +602,11 @@ public abstract class AbsAdapter extends RecyclerView.Adapter<RecyclerView.ViewH
         return mSections;
     }
 
+    /**
+     * Called after every change of mDataSetFiltered.
+     */
     void refreshSectionMap() {
+        mFilteredSnapshot = new ArrayList<>(mDataSetFiltered);
         mSectionMap.clear();
         ArrayList<String> sections = new ArrayList<>();
         if (Build.VERSION.SDK_INT >= 24) {
@@ -381,14 +615,18 @@ public abstract class AbsAdapter extends RecyclerView.Adapter<RecyclerView.ViewH
                 locales = new LocaleList(Locale.ENGLISH);
             }
 
-            AlphabeticIndex<Integer> alphabeticIndex = new AlphabeticIndex<>(locales.get(0));
-            for (int i = 1; i < locales.size(); i++) {
-                alphabeticIndex.addLabels(locales.get(i));
-            }
-            alphabeticIndex.addLabels(Locale.ENGLISH);
+            if (mSectionIndex == null || !locales.equals(mSectionLocales)) {
+                AlphabeticIndex<Integer> alphabeticIndex = new AlphabeticIndex<>(locales.get(0));
+                for (int i = 1; i < locales.size(); i++) {
+                    alphabeticIndex.addLabels(locales.get(i));
+                }
+                alphabeticIndex.addLabels(Locale.ENGLISH);
 
-            AlphabeticIndex.ImmutableIndex<Integer> immutableIndex =
-                    alphabeticIndex.buildImmutableIndex();
+                mSectionIndex = alphabeticIndex.buildImmutableIndex();
+                mSectionLocales = locales;
+                mSectionLabelCache.clear();
+            }
+            final AlphabeticIndex.ImmutableIndex<Integer> immutableIndex = mSectionIndex;
 
             mPositionToSectionIndex = new int[mDataSetFiltered.size()];
 
@@ -397,7 +635,13 @@ public abstract class AbsAdapter extends RecyclerView.Adapter<RecyclerView.ViewH
                 if (TextUtils.isEmpty(label)) {
                     label = "";
                 }
-                label = immutableIndex.getBucket(immutableIndex.getBucketIndex(label)).getLabel();
+                String sectionLabel = mSectionLabelCache.get(label);
+                if (sectionLabel == null) {
+                    sectionLabel = immutableIndex.getBucket(
+                            immutableIndex.getBucketIndex(label)).getLabel();
+                    mSectionLabelCache.put(label, sectionLabel);
+                }
+                label = sectionLabel;
                 if (!mSectionMap.containsKey(label)) {
                     sections.add(label);
                     mSectionMap.put(label, i);
@@ -431,40 +675,4 @@ public abstract class AbsAdapter extends RecyclerView.Adapter<RecyclerView.ViewH
             textView.setMinHeight(Math.round((limitFontScale * 2.0f) + 0.5f));
         }
     }
-
-    private static final Comparator<AppPickerView.AppLabelInfo> APP_LABEL_ASCENDING
-            = new Comparator<>() {
-        public int compare(AppPickerView.AppLabelInfo a, AppPickerView.AppLabelInfo b) {
-            Collator collator = Collator.getInstance(Locale.getDefault());
-            collator.setStrength(Collator.TERTIARY);
-            return collator.compare(a.getLabel(), b.getLabel());
-        }
-    };
-
-    private static final Comparator<AppPickerView.AppLabelInfo> APP_LABEL_ASCENDING_IGNORE_CASE
-            = new Comparator<>() {
-        public int compare(AppPickerView.AppLabelInfo a, AppPickerView.AppLabelInfo b) {
-            Collator collator = Collator.getInstance(Locale.getDefault());
-            collator.setStrength(Collator.PRIMARY);
-            return collator.compare(a.getLabel(), b.getLabel());
-        }
-    };
-
-    private static final Comparator<AppPickerView.AppLabelInfo> APP_LABEL_DESCENDING
-            = new Comparator<AppPickerView.AppLabelInfo>() {
-        public int compare(AppPickerView.AppLabelInfo a, AppPickerView.AppLabelInfo b) {
-            Collator collator = Collator.getInstance(Locale.getDefault());
-            collator.setStrength(Collator.TERTIARY);
-            return collator.compare(b.getLabel(), a.getLabel());
-        }
-    };
-
-    private static final Comparator<AppPickerView.AppLabelInfo> APP_LABEL_DESCENDING_IGNORE_CASE
-            = new Comparator<>() {
-        public int compare(AppPickerView.AppLabelInfo a, AppPickerView.AppLabelInfo b) {
-            Collator collator = Collator.getInstance(Locale.getDefault());
-            collator.setStrength(Collator.PRIMARY);
-            return collator.compare(b.getLabel(), a.getLabel());
-        }
-    };
 }
@@ -16,40 +16,206 @@
 
 package androidx.apppickerview.widget;
 
+import android.app.ActivityManager;
+import android.content.BroadcastReceiver;
 import android.content.ComponentName;
 import android.content.Context;
+import android.content.Intent;
+import android.content.IntentFilter;
 import android.content.pm.PackageManager;
+import android.content.res.Configuration;
+import android.graphics.Bitmap;
+import android.graphics.Canvas;
+import android.graphics.drawable.BitmapDrawable;
 import android.graphics.drawable.Drawable;
-import android.os.AsyncTask;
+import android.net.Uri;
+import android.os.Handler;
+import android.os.Looper;
+import android.os.Process;
 import android.text.TextUtils;
+import android.util.LruCache;
+import android.view.ViewGroup;
 import android.widget.ImageView;
 
+import androidx.annotation.NonNull;
+import androidx.core.content.ContextCompat;
 import androidx.reflect.app.SeslApplicationPackageManagerReflector;
 
+import java.util.HashMap;
+import java.util.Iterator;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.Future;
+import java.util.concurrent.ThreadFactory;
+import java.util.concurrent.atomic.AtomicInteger;
+
 /*
  * Original code by Samsung, all rights reserved to the original author.
  */
 
 public class AppPickerIconLoader {
     private static final String THREAD_NAME = "AppPickerIconLoader";
+    private static final int LOADER_THREAD_COUNT = 2;
+    // Upper bound of the icon cache, the cache also never exceeds 1/16 of the heap
+    private static final int MAX_ICON_CACHE_BYTES = 8 * 1024 * 1024;
+
+    // Keyed by package/activity@size:density:night mode, so that configuration changes use
+    // new entries. Entries of a package are dropped when it changes, see sPackageReceiver.
+    private static LruCache<String, Bitmap> sIconCache;
+    private static ExecutorService sLoaderExecutor;
+    private static boolean sPackageReceiverRegistered = false;
+
+    private static final BroadcastReceiver sPackageReceiver = new BroadcastReceiver() {
+        @Override
+        public void onReceive(Context context, Intent intent) {
+            final Uri data = intent.getData();
+            if (data != null) {
+                evictPackage(data.getSchemeSpecificPart());
+            }
+        }
+    };
+
     private Context mContext;
     private PackageManager mPackageManager;
-    private LoadIconTask mLoadIconTask;
+    private final Handler mMainHandler = new Handler(Looper.getMainLooper());
+    // Loads in flight for this loader, by target view. Only accessed on the main thread.
+    private final HashMap<ImageView, LoadIconTask> mPendingLoads = new HashMap<>();
+    private final int mDefaultIconSize;
 
     public AppPickerIconLoader(Context context) {
         mContext = context;
         mPackageManager = context.getPackageManager();
+        final ActivityManager am =
+                (ActivityManager) context.getSystemService(Context.ACTIVITY_SERVICE);
+        mDefaultIconSize = am.getLauncherLargeIconSize();
+        registerPackageReceiver(context.getApplicationContext());
     }
 
     public void loadIcon(String packageName, String activityName,
                          ImageView imageView) {
         if (!TextUtils.isEmpty(packageName) && imageView != null) {
             imageView.setTag(packageName);
+            cancelLoad(imageView);
+
+            final int size = getTargetIconSize(imageView);
+            final Configuration config = mContext.getResources().getConfiguration();
+            final String key = packageName + "/" + activityName + "@" + size + ":"
+                    + config.densityDpi + ":"
+                    + (config.uiMode & Configuration.UI_MODE_NIGHT_MASK);
+            final Bitmap cached = getIconCache().get(key);
+            if (cached != null) {
+                imageView.setImageDrawable(
+                        new BitmapDrawable(mContext.getResources(), cached));
+                return;
+            }
 
             IconInfo iconInfo = new IconInfo(packageName, activityName, imageView);
-            new LoadIconTask(iconInfo)
-                    .executeOnExecutor(AsyncTask.THREAD_POOL_EXECUTOR);
+            LoadIconTask task = new LoadIconTask(iconInfo, key, size);
+            mPendingLoads.put(imageView, task);
+            task.mFuture = getLoaderExecutor().submit(task);
+        }
+    }
+
+    /**
+     * Cancels the pending icon load for the given view, e.g. when its holder is recycled.
+     */
+    public void cancelLoad(@NonNull ImageView imageView) {
+        final LoadIconTask task = mPendingLoads.remove(imageView);
+        if (task != null) {
+            task.cancel();
+        }
+    }
+
+    private int getTargetIconSize(ImageView imageView) {
+        final ViewGroup.LayoutParams lp = imageView.getLayoutParams();
+        if (lp != null && lp.width > 0 && lp.height > 0) {
+            return Math.max(lp.width, lp.height);
+        }
+        return mDefaultIconSize;
+    }
+
+    private static synchronized LruCache<String, Bitmap> getIconCache() {
+        if (sIconCache == null) {
+            final int maxBytes = (int) Math.min(MAX_ICON_CACHE_BYTES,
+                    Runtime.getRuntime().maxMemory() / 16);
+            sIconCache = new LruCache<String, Bitmap>(maxBytes) {
+                @Override
+                protected int sizeOf(String key, Bitmap value) {
+                    return value.getAllocationByteCount();
+                }
+            };
+        }
+        return sIconCache;
+    }
+
+    private static synchronized void registerPackageReceiver(Context context) {
+        if (sPackageReceiverRegistered) {
+            return;
+        }
+        sPackageReceiverRegistered = true;
+        IntentFilter packageFilter = new IntentFilter();
+        packageFilter.addAction(Intent.ACTION_PACKAGE_ADDED);
+        packageFilter.addAction(Intent.ACTION_PACKAGE_CHANGED);
+        packageFilter.addAction(Intent.ACTION_PACKAGE_REMOVED);
+        packageFilter.addAction(Intent.ACTION_PACKAGE_REPLACED);
+        packageFilter.addDataScheme("package");
+        ContextCompat.registerReceiver(context, sPackageReceiver, packageFilter,
+                ContextCompat.RECEIVER_NOT_EXPORTED);
+    }
+
+    /**
+     * Drops the cached icons of all activities of a package, e.g. after it was updated.
+     */
+    static void evictPackage(String packageName) {
+        final LruCache<String, Bitmap> cache = getIconCache();
+        final String prefix = packageName + "/";
+        for (String key : cache.snapshot().keySet()) {
+            if (key.startsWith(prefix)) {
+                cache.remove(key);
+            }
+        }
+    }
+
+    private static synchronized ExecutorService getLoaderExecutor() {
+        if (sLoaderExecutor == null) {
+            sLoaderExecutor = Executors.newFixedThreadPool(LOADER_THREAD_COUNT,
+                    new ThreadFactory() {
+                        private final AtomicInteger mCount = new AtomicInteger(1);
+
+                        @Override
+                        public Thread newThread(final Runnable r) {
+                            final Thread thread = new Thread(new Runnable() {
+                                @Override
+                                public void run() {
+                                    Process.setThreadPriority(
+                                            Process.THREAD_PRIORITY_BACKGROUND);
+                                    r.run();
+                                }
+                            }, THREAD_NAME + " #" + mCount.getAndIncrement());
+                            thread.setDaemon(true);
+                            return thread;
+                        }
+                    });
+        }
+        return sLoaderExecutor;
+    }
+
+    /**
+     * Renders the icon into a bitmap of the size it is displayed at, so that the cache does not
+     * hold full size adaptive icon drawables.
+     */
+    static Bitmap renderIcon(Drawable drawable, int size) {
+        if (drawable instanceof BitmapDrawable) {
+            final Bitmap bitmap = ((BitmapDrawable) drawable).getBitmap();
+            if (bitmap != null && bitmap.getWidth() <= size && bitmap.getHeight() <= size) {
+                return bitmap;
+            }
         }
+        final Bitmap bitmap = Bitmap.createBitmap(size, size, Bitmap.Config.ARGB_8888);
+        final Canvas canvas = new Canvas(bitmap);
+        drawable.setBounds(0, 0, size, size);
+        drawable.draw(canvas);
+        return bitmap;
     }
 
     Drawable getAppIcon(String packageName, String activityName) {
@@ -89,6 +255,11 @@ public class AppPickerIconLoader {
     }
 
     public void stopIconLoaderThread() {
+        final Iterator<LoadIconTask> it = mPendingLoads.values().iterator();
+        while (it.hasNext()) {
+            it.next().cancel();
+            it.remove();
+        }
     }
 
     private static class IconInfo {
@@ -105,23 +276,58 @@ public class AppPickerIconLoader {
         }
     }
 
-    class LoadIconTask extends AsyncTask<Void, Void, Drawable> {
+    class LoadIconTask implements Runnable {
         private final IconInfo mIconInfo;
+        private final String mKey;
+        private final int mSize;
+        Future<?> mFuture;
+        private volatile boolean mCancelled = false;
 
-        LoadIconTask(IconInfo iconInfo) {
+        LoadIconTask(IconInfo iconInfo, String key, int size) {
             mIconInfo = iconInfo;
+            mKey = key;
+            mSize = size;
         }
 
-        protected Drawable doInBackground(Void... params) {
-            return getAppIcon(mIconInfo.packageName, mIconInfo.activityName);
+        void cancel() {
+            mCancelled = true;
+            if (mFuture != null) {
+                mFuture.cancel(false);
+            }
         }
 
-        protected void onPostExecute(Drawable result) {
-            if (mIconInfo != null) {
-                if (mIconInfo.imageView != null && result != null) {
-                    mIconInfo.imageView.setImageDrawable(result);
+        @Override
+        public void run() {
+            if (mCancelled) {
+                return;
+            }
+            // another picker may have loaded the same icon meanwhile
+            Bitmap icon = getIconCache().get(mKey);
+            if (icon == null) {
+                final Drawable drawable = getAppIcon(mIconInfo.packageName,
+                        mIconInfo.activityName);
+                if (drawable == null || mCancelled) {
+                    return;
+                }
+                icon = renderIcon(drawable, mSize);
+                getIconCache().put(mKey, icon);
+            }
+            final Bitmap result = icon;
+            mMainHandler.post(new Runnable() {
+                @Override
+                public void run() {
+                    onPostExecute(result);
                 }
+            });
+        }
+
+        private void onPostExecute(Bitmap result) {
+            if (mCancelled || mPendingLoads.get(mIconInfo.imageView) != this) {
+                return;
             }
+            mPendingLoads.remove(mIconInfo.imageView);
+            mIconInfo.imageView.setImageDrawable(
+                    new BitmapDrawable(mContext.getResources(), result));
         }
     }
 }
@@ -358,6 +358,24 @@ public class AppPickerView extends RecyclerView
         mAdapter.resetPackages(null, true, labelInfoList, activityNamesList);
     }
 
+    /**
+     * Like {@link #resetPackages(List, List)}, but shows the cached app labels immediately and
+     * updates the list once the missing labels were loaded in the background.
+     */
+    public void resetPackagesAsync(@NonNull List<String> packageNamesList,
+                                   @Nullable List<AppLabelInfo> labelInfoList) {
+        mAdapter.resetPackagesAsync(packageNamesList, labelInfoList, null);
+    }
+
+    /**
+     * Like {@link #resetComponentName(List, List)}, but shows the cached activity labels
+     * immediately and updates the list once the missing labels were loaded in the background.
+     */
+    public void resetComponentNameAsync(@NonNull List<ComponentName> activityNamesList,
+                                        @Nullable List<AppLabelInfo> labelInfoList) {
+        mAdapter.resetPackagesAsync(null, labelInfoList, activityNamesList);
+    }
+
     public void setSearchFilter(@NonNull String constraint) {
         setSearchFilter(constraint, null);
     }
@@ -379,8 +397,11 @@ public class AppPickerView extends RecyclerView
         }
 
         ImageView appIcon = vh.getAppIcon();
-        if (appIcon != null && appIcon.hasOnClickListeners()) {
-            appIcon.setOnClickListener(null);
+        if (appIcon != null) {
+            mAppPickerIconLoader.cancelLoad(appIcon);
+            if (appIcon.hasOnClickListeners()) {
+                appIcon.setOnClickListener(null);
+            }
         }
 
         CheckBox checkBox = vh.getCheckBox();
@@ -19,23 +19,40 @@ package androidx.apppickerview.widget;
 import static androidx.annotation.RestrictTo.Scope.LIBRARY_GROUP_PREFIX;
 
 import android.annotation.SuppressLint;
+import android.content.BroadcastReceiver;
 import android.content.ComponentName;
 import android.content.Context;
+import android.content.Intent;
+import android.content.IntentFilter;
+import android.content.SharedPreferences;
 import android.content.pm.ActivityInfo;
 import android.content.pm.ApplicationInfo;
+import android.content.pm.PackageInfo;
 import android.content.pm.PackageManager;
 import android.database.Cursor;
 import android.net.Uri;
 import android.os.Build;
 import android.os.Bundle;
+import android.os.Handler;
+import android.os.Looper;
+import android.text.TextUtils;
 import android.util.Log;
 
+import androidx.annotation.NonNull;
 import androidx.annotation.RequiresApi;
 import androidx.annotation.RestrictTo;
+import androidx.core.content.ContextCompat;
+import androidx.core.content.pm.PackageInfoCompat;
 
 import java.util.ArrayList;
 import java.util.HashMap;
+import java.util.HashSet;
+import java.util.Iterator;
 import java.util.List;
+import java.util.Locale;
+import java.util.Map;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
 
 /*
  * Original code by Samsung, all rights reserved to the original author.
@@ -55,6 +72,14 @@ class DataManager {
     private static final boolean sIsSupportQUERY = Build.VERSION.SDK_INT >= 26;
     private static final boolean sIsSupportSCS = Build.VERSION.SDK_INT > 29;
 
+    private static final String UNKNOWN_LABEL = "Unknown";
+
+    private static ExecutorService sLabelExecutor;
+
+    interface OnLabelsLoadedListener {
+        void onLabelsLoaded(@NonNull List<AppPickerView.AppLabelInfo> appLabelInfoList);
+    }
+
     DataManager() {
     }
 
@@ -72,11 +97,76 @@ class DataManager {
             List<String> packageNamesList,
             List<AppPickerView.AppLabelInfo> appLabelInfoList,
             List<ComponentName> componentNameList) {
+        return resetPackages(new LabelResolver(context, componentNameList != null, false),
+                packageNamesList, appLabelInfoList, componentNameList);
+    }
+
+    /**
+     * Returns the cached labels without querying the label providers, using the package name
+     * for the others, and resolves the complete list on a background thread. The listener is
+     * called on the main thread, and only if some labels were missing or differ from the cached
+     * ones. The background pass also runs once per process when every label is cached, since
+     * the labels of the Settings provider and SCS may change without a package update.
+     */
+    static List<AppPickerView.AppLabelInfo> resetPackagesAsync(final Context context,
+            final List<String> packageNamesList,
+            final List<AppPickerView.AppLabelInfo> appLabelInfoList,
+            final List<ComponentName> componentNameList,
+            final OnLabelsLoadedListener listener) {
+        final LabelResolver cachedResolver =
+                new LabelResolver(context, componentNameList != null, true);
+        final List<AppPickerView.AppLabelInfo> cachedList = resetPackages(cachedResolver,
+                packageNamesList, appLabelInfoList, componentNameList);
+        final LabelCache labelCache = LabelCache.getInstance(context);
+        if (cachedResolver.mHasMissingLabels || !labelCache.isVerified()) {
+            final Handler mainHandler = new Handler(Looper.getMainLooper());
+            getLabelExecutor().execute(new Runnable() {
+                @Override
+                public void run() {
+                    final List<AppPickerView.AppLabelInfo> list = resetPackages(context,
+                            packageNamesList, appLabelInfoList, componentNameList);
+                    labelCache.setVerified();
+                    if (hasSameLabels(cachedList, list)) {
+                        return;
+                    }
+                    mainHandler.post(new Runnable() {
+                        @Override
+                        public void run() {
+                            listener.onLabelsLoaded(list);
+                        }
+                    });
+                }
+            });
+        }
+        return cachedList;
+    }
+
+    private static boolean hasSameLabels(List<AppPickerView.AppLabelInfo> list,
+            List<AppPickerView.AppLabelInfo> other) {
+        if (list.size() != other.size()) {
+            return false;
+        }
+        for (int i = 0; i < list.size(); i++) {
+            if (!TextUtils.equals(list.get(i).getLabel(), other.get(i).getLabel())) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    private static synchronized ExecutorService getLabelExecutor() {
+        if (sLabelExecutor == null) {
+            sLabelExecutor = Executors.newSingleThreadExecutor();
+        }
+        return sLabelExecutor;
+    }
+
+    private static List<AppPickerView.AppLabelInfo> resetPackages(LabelResolver resolver,
+            List<String> packageNamesList,
+            List<AppPickerView.AppLabelInfo> appLabelInfoList,
+            List<ComponentName> componentNameList) {
         HashMap<String, String> appLabelMap;
         boolean isComponentListNotNull = componentNameList != null;
-        HashMap<String, String> labelFromSettingsOrSCS = sIsSupportQUERY
-                ? getLabelFromSCS(context, isComponentListNotNull)
-                : isComponentListNotNull ? null : loadLabelFromSettings(context);
 
         if (appLabelInfoList != null) {
             appLabelMap = new HashMap<>();
@@ -98,11 +188,9 @@ class DataManager {
             for (ComponentName componentName : componentNameList) {
                 String packageAndActivityName = componentName.getPackageName() + "/" + componentName.getClassName();
                 String appLabel = appLabelMap != null ? appLabelMap.get(packageAndActivityName) : null;
-                if (appLabel == null && labelFromSettingsOrSCS != null) {
-                    appLabel = labelFromSettingsOrSCS.get(packageAndActivityName);
-                }
                 if (appLabel == null) {
-                    appLabel = getLabelFromPackageManager(context, componentName);
+                    appLabel = resolver.resolve(packageAndActivityName,
+                            componentName.getPackageName(), componentName);
                 }
                 updatedLabelInfoList.add(
                         new AppPickerView.AppLabelInfo(componentName.getPackageName(),
@@ -111,18 +199,282 @@ class DataManager {
         } else {
             for (String packageName : packageNamesList) {
                 String label = appLabelMap != null ? appLabelMap.get(packageName) : null;
-                if (label == null && labelFromSettingsOrSCS != null) {
-                    label = labelFromSettingsOrSCS.get(packageName);
-                }
                 if (label == null) {
-                    label = getLabelFromPackageManager(context, packageName);
+                    label = resolver.resolve(packageName, packageName, null);
                 }
                 updatedLabelInfoList.add(new AppPickerView.AppLabelInfo(packageName, label, ""));
             }
         }
+        resolver.applyCacheWrites();
         return updatedLabelInfoList;
     }
 
+    /**
+     * Resolves labels from the Settings provider or SCS, queried once when the first label is
+     * resolved, then from the {@link LabelCache}, then from the PackageManager. Cached labels
+     * only stand in for the PackageManager, so a label the providers changed or no longer
+     * override is picked up again. In the cached only mode, nothing but the cache is used.
+     */
+    private static class LabelResolver {
+        private final Context mContext;
+        private final LabelCache mLabelCache;
+        private final boolean mIsComponentNameIncluded;
+        private final boolean mCachedOnly;
+        private HashMap<String, String> mLabelFromSettingsOrSCS;
+        private SharedPreferences.Editor mCacheWrites;
+        private boolean mQueried = false;
+        boolean mHasMissingLabels = false;
+
+        LabelResolver(Context context, boolean isComponentNameIncluded, boolean cachedOnly) {
+            mContext = context;
+            mLabelCache = LabelCache.getInstance(context);
+            mIsComponentNameIncluded = isComponentNameIncluded;
+            mCachedOnly = cachedOnly;
+        }
+
+        String resolve(String key, String packageName, ComponentName componentName) {
+            final String cachedLabel = mLabelCache.get(key);
+            if (mCachedOnly) {
+                if (cachedLabel == null) {
+                    mHasMissingLabels = true;
+                    return packageName;
+                }
+                return cachedLabel;
+            }
+
+            if (!mQueried) {
+                mQueried = true;
+                mLabelFromSettingsOrSCS = sIsSupportQUERY
+                        ? getLabelFromSCS(mContext, mIsComponentNameIncluded)
+                        : mIsComponentNameIncluded ? null : loadLabelFromSettings(mContext);
+            }
+            String label = mLabelFromSettingsOrSCS != null
+                    ? mLabelFromSettingsOrSCS.get(key) : null;
+            final boolean fromProvider = label != null;
+            if (!fromProvider) {
+                if (cachedLabel != null && !mLabelCache.isProviderLabel(key)) {
+                    return cachedLabel;
+                }
+                label = componentName != null
+                        ? getLabelFromPackageManager(mContext, componentName)
+                        : getLabelFromPackageManager(mContext, packageName);
+                if (UNKNOWN_LABEL.equals(label)) {
+                    return label;
+                }
+            }
+            if (!label.equals(cachedLabel) || fromProvider != mLabelCache.isProviderLabel(key)) {
+                if (mCacheWrites == null) {
+                    mCacheWrites = mLabelCache.edit();
+                }
+                mLabelCache.put(key, packageName, label, fromProvider, mCacheWrites);
+            }
+            return label;
+        }
+
+        /**
+         * Writes the labels resolved so far to the cache file, all at once.
+         */
+        void applyCacheWrites() {
+            if (mCacheWrites != null) {
+                mCacheWrites.apply();
+                mCacheWrites = null;
+            }
+        }
+    }
+
+    /**
+     * Process wide label cache persisted in a SharedPreferences file. Each entry is stamped with
+     * the lastUpdateTime and version code of its package and dropped when they change, and the
+     * package change broadcasts keep the cache current while the process runs. Entries also
+     * record whether their label came from the Settings provider or SCS. The whole cache is
+     * dropped when its version or the locale changes.
+     * <p>
+     * The file is read and checked against the installed packages when the cache is first used,
+     * so the first picker of a process already shows the persisted labels.
+     */
+    private static final class LabelCache {
+        private static final String PREFS_NAME = "sesl_app_picker_label_cache";
+        private static final String KEY_CACHE_VERSION = "cache_version";
+        private static final int CACHE_VERSION = 2;
+        private static final char SOURCE_PROVIDER = 'P';
+        private static final char SOURCE_PACKAGE_MANAGER = 'M';
+
+        private static LabelCache sInstance;
+
+        private final Context mContext;
+        private final SharedPreferences mPrefs;
+        private final HashMap<String, String> mLabels = new HashMap<>();
+        // Keys whose label came from the Settings provider or SCS
+        private final HashSet<String> mProviderLabels = new HashSet<>();
+        // "<lastUpdateTime>/<versionCode>" by package name
+        private final HashMap<String, String> mStamps = new HashMap<>();
+        // Whether the provider labels were checked since the process started or the locale changed
+        private boolean mVerified = false;
+
+        private final BroadcastReceiver mPackageReceiver = new BroadcastReceiver() {
+            @Override
+            public void onReceive(Context context, Intent intent) {
+                if (Intent.ACTION_LOCALE_CHANGED.equals(intent.getAction())) {
+                    clear();
+                    return;
+                }
+                final Uri data = intent.getData();
+                if (data != null) {
+                    invalidatePackage(data.getSchemeSpecificPart());
+                }
+            }
+        };
+
+        static synchronized LabelCache getInstance(Context context) {
+            if (sInstance == null) {
+                sInstance = new LabelCache(context.getApplicationContext());
+            }
+            return sInstance;
+        }
+
+        private LabelCache(Context context) {
+            mContext = context;
+            mPrefs = context.getSharedPreferences(PREFS_NAME, Context.MODE_PRIVATE);
+            load();
+
+            IntentFilter packageFilter = new IntentFilter();
+            packageFilter.addAction(Intent.ACTION_PACKAGE_ADDED);
+            packageFilter.addAction(Intent.ACTION_PACKAGE_CHANGED);
+            packageFilter.addAction(Intent.ACTION_PACKAGE_REMOVED);
+            packageFilter.addAction(Intent.ACTION_PACKAGE_REPLACED);
+            packageFilter.addDataScheme("package");
+            ContextCompat.registerReceiver(context, mPackageReceiver, packageFilter,
+                    ContextCompat.RECEIVER_NOT_EXPORTED);
+            ContextCompat.registerReceiver(context, mPackageReceiver,
+                    new IntentFilter(Intent.ACTION_LOCALE_CHANGED),
+                    ContextCompat.RECEIVER_NOT_EXPORTED);
+        }
+
+        private static String getCacheVersion() {
+            return CACHE_VERSION + ":" + Locale.getDefault().toLanguageTag();
+        }
+
+        private static String getStamp(PackageInfo packageInfo) {
+            return packageInfo.lastUpdateTime + "/"
+                    + PackageInfoCompat.getLongVersionCode(packageInfo);
+        }
+
+        private void load() {
+            if (!getCacheVersion().equals(mPrefs.getString(KEY_CACHE_VERSION, null))) {
+                mPrefs.edit().clear().putString(KEY_CACHE_VERSION, getCacheVersion()).apply();
+                return;
+            }
+            final Map<String, ?> entries = mPrefs.getAll();
+            if (entries.size() <= 1) {
+                return;
+            }
+            for (PackageInfo packageInfo : mContext.getPackageManager().getInstalledPackages(0)) {
+                mStamps.put(packageInfo.packageName, getStamp(packageInfo));
+            }
+
+            SharedPreferences.Editor staleEntries = null;
+            for (Map.Entry<String, ?> entry : entries.entrySet()) {
+                final String key = entry.getKey();
+                if (KEY_CACHE_VERSION.equals(key) || !(entry.getValue() instanceof String)) {
+                    continue;
+                }
+                // stored as "<stamp>:<source>:<label>"
+                final String value = (String) entry.getValue();
+                final int separator = value.indexOf(':');
+                final String stamp = mStamps.get(getPackageName(key));
+                if (separator > 0 && value.length() > separator + 2
+                        && value.charAt(separator + 2) == ':'
+                        && value.substring(0, separator).equals(stamp)) {
+                    mLabels.put(key, value.substring(separator + 3));
+                    if (value.charAt(separator + 1) == SOURCE_PROVIDER) {
+                        mProviderLabels.add(key);
+                    }
+                } else {
+                    if (staleEntries == null) {
+                        staleEntries = mPrefs.edit();
+                    }
+                    staleEntries.remove(key);
+                }
+            }
+            if (staleEntries != null) {
+                staleEntries.apply();
+            }
+        }
+
+        private static String getPackageName(String key) {
+            final int slash = key.indexOf('/');
+            return slash >= 0 ? key.substring(0, slash) : key;
+        }
+
+        SharedPreferences.Editor edit() {
+            return mPrefs.edit();
+        }
+
+        synchronized String get(String key) {
+            return mLabels.get(key);
+        }
+
+        synchronized boolean isProviderLabel(String key) {
+            return mProviderLabels.contains(key);
+        }
+
+        synchronized boolean isVerified() {
+            return mVerified;
+        }
+
+        synchronized void setVerified() {
+            mVerified = true;
+        }
+
+        /**
+         * Caches the label and stores it with the given editor, which the caller applies once it
+         * is done resolving labels.
+         */
+        synchronized void put(String key, String packageName, String label, boolean fromProvider,
+                SharedPreferences.Editor editor) {
+            String stamp = mStamps.get(packageName);
+            if (stamp == null) {
+                try {
+                    stamp = getStamp(mContext.getPackageManager().getPackageInfo(packageName, 0));
+                } catch (PackageManager.NameNotFoundException e) {
+                    return;
+                }
+                mStamps.put(packageName, stamp);
+            }
+            mLabels.put(key, label);
+            if (fromProvider) {
+                mProviderLabels.add(key);
+            } else {
+                mProviderLabels.remove(key);
+            }
+            editor.putString(key, stamp + ":"
+                    + (fromProvider ? SOURCE_PROVIDER : SOURCE_PACKAGE_MANAGER) + ":" + label);
+        }
+
+        synchronized void invalidatePackage(String packageName) {
+            mStamps.remove(packageName);
+            final SharedPreferences.Editor editor = mPrefs.edit();
+            final Iterator<String> it = mLabels.keySet().iterator();
+            while (it.hasNext()) {
+                final String key = it.next();
+                if (key.equals(packageName) || key.startsWith(packageName + "/")) {
+                    it.remove();
+                    mProviderLabels.remove(key);
+                    editor.remove(key);
+                }
+            }
+            editor.apply();
+        }
+
+        synchronized void clear() {
+            mLabels.clear();
+            mProviderLabels.clear();
+            mStamps.clear();
+            mVerified = false;
+            mPrefs.edit().clear().putString(KEY_CACHE_VERSION, getCacheVersion()).apply();
+        }
+    }
+
     @SuppressLint("Range")
     private static HashMap<String, String> loadLabelFromSettings(Context context) {
         Cursor query = context.getContentResolver().query(APP_LIST_PROVIDER_CONTENT_URI,
@@ -189,10 +541,10 @@ class DataManager {
             PackageManager packageManager = context.getPackageManager();
             ApplicationInfo applicationInfo = packageManager.getApplicationInfo(packageName, 0);
             return applicationInfo != null ?
-                    (String) packageManager.getApplicationLabel(applicationInfo) : "Unknown";
+                    (String) packageManager.getApplicationLabel(applicationInfo) : UNKNOWN_LABEL;
         } catch (PackageManager.NameNotFoundException unused) {
             Log.i(TAG, "can't find label for " + packageName);
-            return "Unknown";
+            return UNKNOWN_LABEL;
         }
     }
 
@@ -201,10 +553,10 @@ class DataManager {
             PackageManager packageManager = context.getPackageManager();
             ActivityInfo activityInfo = packageManager.getActivityInfo(componentName, 0);
             return activityInfo != null ?
-                    activityInfo.loadLabel(packageManager).toString() : "Unknown";
+                    activityInfo.loadLabel(packageManager).toString() : UNKNOWN_LABEL;
         } catch (PackageManager.NameNotFoundException unused) {
             Log.i(TAG, "can't find label for " + componentName);
-            return "Unknown";
+            return UNKNOWN_LABEL;
         }
     }
 }
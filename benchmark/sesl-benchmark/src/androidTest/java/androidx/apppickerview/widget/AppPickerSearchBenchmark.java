@@ -0,0 +1,86 @@
+/*
+ * Copyright 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package androidx.apppickerview.widget;
+
+import android.content.Context;
+
+import androidx.benchmark.BenchmarkState;
+import androidx.benchmark.junit4.BenchmarkRule;
+import androidx.sesl.benchmark.BenchmarkUtils;
+import androidx.test.ext.junit.runners.AndroidJUnit4;
+import androidx.test.filters.LargeTest;
+
+import org.junit.Before;
+import org.junit.Rule;
+import org.junit.Test;
+import org.junit.runner.RunWith;
+
+import java.util.ArrayList;
+import java.util.List;
+import java.util.Random;
+
+/**
+ * Loads and searches an app list of the size of a device with many apps installed. The labels
+ * are passed in, so neither depends on the apps installed on the device.
+ */
+@LargeTest
+@RunWith(AndroidJUnit4.class)
+public class AppPickerSearchBenchmark {
+    private static final int APP_COUNT = 1500;
+    private static final String[] QUERIES = {"c", "ca", "cam", "came", "camer", "camera"};
+
+    @Rule
+    public BenchmarkRule mBenchmarkRule = new BenchmarkRule();
+
+    private final List<String> mPackageNames = new ArrayList<>(APP_COUNT);
+    private final List<AppPickerView.AppLabelInfo> mLabelInfos = new ArrayList<>(APP_COUNT);
+
+    @Before
+    public void setUp() {
+        final String[] words = {"Camera", "Calendar", "Gallery", "Messages", "Music", "Notes",
+                "Phone", "Settings", "Weather", "Clock", "Contacts", "Browser", "Files"};
+        final Random random = new Random(0);
+        for (int i = 0; i < APP_COUNT; i++) {
+            final String packageName = "com.example.app" + i;
+            final String label = words[random.nextInt(words.length)] + " "
+                    + words[random.nextInt(words.length)] + " " + i;
+            mPackageNames.add(packageName);
+            mLabelInfos.add(new AppPickerView.AppLabelInfo(packageName, label, ""));
+        }
+    }
+
+    @Test
+    public void resetPackages() {
+        final Context context = BenchmarkUtils.getThemedContext();
+        final BenchmarkState state = mBenchmarkRule.getState();
+        while (state.keepRunning()) {
+            DataManager.resetPackages(context, mPackageNames, mLabelInfos, null);
+        }
+    }
+
+    @Test
+    public void searchWhileTyping() {
+        final BenchmarkState state = mBenchmarkRule.getState();
+        while (state.keepRunning()) {
+            // A new list builds a new index, as resetting the packages does
+            final AbsAdapter.SearchIndex index = new AbsAdapter.SearchIndex(mLabelInfos);
+            for (String query : QUERIES) {
+                index.filter(query);
+            }
+        }
+    }
+}
@@ -0,0 +1,88 @@
+/*
+ * Copyright 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package androidx.indexscroll.widget;
+
+import android.database.MatrixCursor;
+
+import androidx.benchmark.BenchmarkState;
+import androidx.benchmark.junit4.BenchmarkRule;
+import androidx.test.ext.junit.runners.AndroidJUnit4;
+import androidx.test.filters.LargeTest;
+
+import org.junit.Before;
+import org.junit.Rule;
+import org.junit.Test;
+import org.junit.runner.RunWith;
+
+import java.util.Arrays;
+import java.util.Random;
+
+/**
+ * Builds the index of a large contact like cursor, and resolves the index of every position as
+ * scrubbing the index bar along the list does.
+ */
+@LargeTest
+@RunWith(AndroidJUnit4.class)
+public class SeslCursorIndexerBenchmark {
+    private static final int ITEM_COUNT = 20000;
+    private static final String INDEX_CHARACTERS = "ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+
+    @Rule
+    public BenchmarkRule mBenchmarkRule = new BenchmarkRule();
+
+    private MatrixCursor mCursor;
+
+    @Before
+    public void setUp() {
+        final Random random = new Random(0);
+        final String[] names = new String[ITEM_COUNT];
+        final char[] name = new char[8];
+        for (int i = 0; i < ITEM_COUNT; i++) {
+            for (int j = 0; j < name.length; j++) {
+                name[j] = (char) ((j == 0 ? 'A' : 'a') + random.nextInt(26));
+            }
+            names[i] = new String(name);
+        }
+        Arrays.sort(names);
+
+        mCursor = new MatrixCursor(new String[] {"_id", "name"}, ITEM_COUNT);
+        for (int i = 0; i < ITEM_COUNT; i++) {
+            mCursor.addRow(new Object[] {i, names[i]});
+        }
+    }
+
+    @Test
+    public void cacheIndexInfo() {
+        final BenchmarkState state = mBenchmarkRule.getState();
+        while (state.keepRunning()) {
+            new SeslCursorIndexer(mCursor, 1, INDEX_CHARACTERS).cacheIndexInfo();
+        }
+    }
+
+    @Test
+    public void getIndexByPosition_scrub() {
+        final SeslCursorIndexer indexer = new SeslCursorIndexer(mCursor, 1, INDEX_CHARACTERS);
+        indexer.cacheIndexInfo();
+
+        final BenchmarkState state = mBenchmarkRule.getState();
+        while (state.keepRunning()) {
+            for (int position = 0; position < ITEM_COUNT; position += 50) {
+                indexer.getCachingValue(indexer.getIndexByPosition(position));
+            }
+        }
+    }
+}
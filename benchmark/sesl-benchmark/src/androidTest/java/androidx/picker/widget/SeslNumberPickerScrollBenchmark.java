@@ -0,0 +1,79 @@
+/*
+ * Copyright 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package androidx.picker.widget;
+
+import android.graphics.Canvas;
+
+import androidx.benchmark.BenchmarkState;
+import androidx.benchmark.junit4.BenchmarkRule;
+import androidx.sesl.benchmark.BenchmarkUtils;
+import androidx.test.annotation.UiThreadTest;
+import androidx.test.ext.junit.runners.AndroidJUnit4;
+import androidx.test.filters.LargeTest;
+
+import org.junit.Rule;
+import org.junit.Test;
+import org.junit.runner.RunWith;
+
+/**
+ * Scrolls the selector wheel by a fling-sized step per frame and draws it.
+ */
+@LargeTest
+@RunWith(AndroidJUnit4.class)
+public class SeslNumberPickerScrollBenchmark {
+    private static final int WIDTH = 400;
+    private static final int HEIGHT = 700;
+    private static final int SCROLL_STEP = 45;
+
+    @Rule
+    public BenchmarkRule mBenchmarkRule = new BenchmarkRule();
+
+    @UiThreadTest
+    @Test
+    public void scroll() {
+        benchmarkScroll(null);
+    }
+
+    @UiThreadTest
+    @Test
+    public void scroll_displayedValues() {
+        final String[] values = new String[1001];
+        for (int i = 0; i < values.length; i++) {
+            values[i] = "Value " + i;
+        }
+        benchmarkScroll(values);
+    }
+
+    private void benchmarkScroll(String[] displayedValues) {
+        final SeslNumberPicker picker =
+                new SeslNumberPicker(BenchmarkUtils.getThemedContext());
+        picker.setMinValue(0);
+        picker.setMaxValue(1000);
+        if (displayedValues != null) {
+            picker.setDisplayedValues(displayedValues);
+        }
+        picker.setWrapSelectorWheel(true);
+        BenchmarkUtils.layout(picker, WIDTH, HEIGHT);
+        final Canvas canvas = BenchmarkUtils.createCanvas(WIDTH, HEIGHT);
+
+        final BenchmarkState state = mBenchmarkRule.getState();
+        while (state.keepRunning()) {
+            picker.scrollBy(0, SCROLL_STEP);
+            picker.draw(canvas);
+        }
+    }
+}
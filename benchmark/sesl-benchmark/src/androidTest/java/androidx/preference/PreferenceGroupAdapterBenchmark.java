@@ -0,0 +1,90 @@
+/*
+ * Copyright 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package androidx.preference;
+
+import android.content.Context;
+
+import androidx.benchmark.BenchmarkState;
+import androidx.benchmark.junit4.BenchmarkRule;
+import androidx.sesl.benchmark.BenchmarkUtils;
+import androidx.test.annotation.UiThreadTest;
+import androidx.test.ext.junit.runners.AndroidJUnit4;
+import androidx.test.filters.LargeTest;
+
+import org.junit.Before;
+import org.junit.Rule;
+import org.junit.Test;
+import org.junit.runner.RunWith;
+
+/**
+ * Flattens a large preference hierarchy, as every change to it or to the visibility of one of
+ * its preferences does.
+ */
+@LargeTest
+@RunWith(AndroidJUnit4.class)
+public class PreferenceGroupAdapterBenchmark {
+    private static final int CATEGORY_COUNT = 50;
+    private static final int PREFERENCES_PER_CATEGORY = 40;
+
+    @Rule
+    public BenchmarkRule mBenchmarkRule = new BenchmarkRule();
+
+    private PreferenceScreen mScreen;
+    private PreferenceGroupAdapter mAdapter;
+
+    @Before
+    public void setUp() {
+        final Context context = BenchmarkUtils.getThemedContext();
+        context.getTheme().applyStyle(R.style.PreferenceThemeOverlay, true);
+        final PreferenceManager preferenceManager = new PreferenceManager(context);
+        mScreen = preferenceManager.createPreferenceScreen(context);
+        for (int i = 0; i < CATEGORY_COUNT; i++) {
+            final PreferenceCategory category = new PreferenceCategory(context);
+            category.setTitle("Category " + i);
+            mScreen.addPreference(category);
+            for (int j = 0; j < PREFERENCES_PER_CATEGORY; j++) {
+                final Preference preference = new Preference(context);
+                preference.setPersistent(false);
+                preference.setKey("preference_" + i + "_" + j);
+                preference.setTitle("Preference " + j);
+                category.addPreference(preference);
+            }
+        }
+    }
+
+    @UiThreadTest
+    @Test
+    public void updatePreferences() {
+        mAdapter = new PreferenceGroupAdapter(mScreen);
+        final BenchmarkState state = mBenchmarkRule.getState();
+        while (state.keepRunning()) {
+            mAdapter.updatePreferences();
+        }
+    }
+
+    @UiThreadTest
+    @Test
+    public void updatePreferences_withComparisonCallback() {
+        mScreen.getPreferenceManager().setPreferenceComparisonCallback(
+                new PreferenceManager.SimplePreferenceComparisonCallback());
+        mAdapter = new PreferenceGroupAdapter(mScreen);
+        final BenchmarkState state = mBenchmarkRule.getState();
+        while (state.keepRunning()) {
+            mAdapter.updatePreferences();
+        }
+    }
+}
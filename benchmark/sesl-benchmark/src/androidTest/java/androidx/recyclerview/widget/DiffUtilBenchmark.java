@@ -0,0 +1,118 @@
+/*
+ * Copyright 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package androidx.recyclerview.widget;
+
+import androidx.benchmark.BenchmarkState;
+import androidx.benchmark.junit4.BenchmarkRule;
+import androidx.test.ext.junit.runners.AndroidJUnit4;
+import androidx.test.filters.LargeTest;
+
+import org.junit.Rule;
+import org.junit.Test;
+import org.junit.runner.RunWith;
+
+import java.util.ArrayList;
+import java.util.Collections;
+import java.util.List;
+import java.util.Random;
+
+@LargeTest
+@RunWith(AndroidJUnit4.class)
+public class DiffUtilBenchmark {
+    private static final int LARGE_LIST_SIZE = 10000;
+    private static final int SHUFFLED_LIST_SIZE = 1000;
+
+    @Rule
+    public BenchmarkRule mBenchmarkRule = new BenchmarkRule();
+
+    @Test
+    public void calculateDiff_largeListFewChanges() {
+        benchmarkDiff(createList(LARGE_LIST_SIZE), editList(createList(LARGE_LIST_SIZE)), false);
+    }
+
+    @Test
+    public void calculateDiff_largeListFewChangesDetectMoves() {
+        benchmarkDiff(createList(LARGE_LIST_SIZE), editList(createList(LARGE_LIST_SIZE)), true);
+    }
+
+    @Test
+    public void calculateDiff_largeListUnchanged() {
+        benchmarkDiff(createList(LARGE_LIST_SIZE), createList(LARGE_LIST_SIZE), true);
+    }
+
+    @Test
+    public void calculateDiff_shuffledList() {
+        final List<Integer> newList = createList(SHUFFLED_LIST_SIZE);
+        Collections.shuffle(newList, new Random(0));
+        benchmarkDiff(createList(SHUFFLED_LIST_SIZE), newList, true);
+    }
+
+    private void benchmarkDiff(final List<Integer> oldList, final List<Integer> newList,
+            boolean detectMoves) {
+        final DiffUtil.Callback callback = new DiffUtil.Callback() {
+            @Override
+            public int getOldListSize() {
+                return oldList.size();
+            }
+
+            @Override
+            public int getNewListSize() {
+                return newList.size();
+            }
+
+            @Override
+            public boolean areItemsTheSame(int oldItemPosition, int newItemPosition) {
+                return oldList.get(oldItemPosition).equals(newList.get(newItemPosition));
+            }
+
+            @Override
+            public boolean areContentsTheSame(int oldItemPosition, int newItemPosition) {
+                return true;
+            }
+        };
+
+        final BenchmarkState state = mBenchmarkRule.getState();
+        while (state.keepRunning()) {
+            DiffUtil.calculateDiff(callback, detectMoves);
+        }
+    }
+
+    private static List<Integer> createList(int size) {
+        final List<Integer> list = new ArrayList<>(size);
+        for (int i = 0; i < size; i++) {
+            list.add(i);
+        }
+        return list;
+    }
+
+    /**
+     * Removes every 100th item, inserts a new one every 250 items and moves a few, like a feed
+     * that was refreshed.
+     */
+    private static List<Integer> editList(List<Integer> list) {
+        for (int i = list.size() - 1; i >= 0; i -= 100) {
+            list.remove(i);
+        }
+        for (int i = 0; i < list.size(); i += 250) {
+            list.add(i, -i - 1);
+        }
+        for (int i = 0; i < 10; i++) {
+            list.add(list.remove(i * 37));
+        }
+        return list;
+    }
+}
@@ -0,0 +1,135 @@
+/*
+ * Copyright 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package androidx.recyclerview.widget;
+
+import static androidx.sesl.benchmark.BenchmarkUtils.SCREEN_HEIGHT;
+import static androidx.sesl.benchmark.BenchmarkUtils.SCREEN_WIDTH;
+
+import android.content.Context;
+import android.graphics.Canvas;
+import android.view.View;
+import android.view.ViewGroup;
+import android.widget.TextView;
+
+import androidx.annotation.NonNull;
+import androidx.benchmark.BenchmarkState;
+import androidx.benchmark.junit4.BenchmarkRule;
+import androidx.sesl.benchmark.BenchmarkUtils;
+import androidx.test.annotation.UiThreadTest;
+import androidx.test.ext.junit.runners.AndroidJUnit4;
+import androidx.test.filters.LargeTest;
+import androidx.test.filters.SdkSuppress;
+
+import org.junit.Before;
+import org.junit.Rule;
+import org.junit.Test;
+import org.junit.runner.RunWith;
+
+/**
+ * Scrolls a long list by a fling-sized step per frame and draws it, which is the per frame work
+ * of a fling minus the scroller itself, and swipes one of its rows.
+ */
+@LargeTest
+@RunWith(AndroidJUnit4.class)
+public class RecyclerViewScrollBenchmark {
+    private static final int ITEM_COUNT = 10000;
+    private static final int ITEM_HEIGHT = 180;
+    private static final int SCROLL_STEP = 120;
+
+    @Rule
+    public BenchmarkRule mBenchmarkRule = new BenchmarkRule();
+
+    private Context mContext;
+    private RecyclerView mRecyclerView;
+    private Canvas mCanvas;
+
+    @Before
+    public void setUp() {
+        mContext = BenchmarkUtils.getThemedContext();
+        mRecyclerView = new RecyclerView(mContext);
+        mRecyclerView.setLayoutManager(new LinearLayoutManager(mContext));
+        mRecyclerView.setAdapter(new TextAdapter());
+        mCanvas = BenchmarkUtils.createCanvas(SCREEN_WIDTH, SCREEN_HEIGHT);
+    }
+
+    @UiThreadTest
+    @Test
+    public void scroll() {
+        benchmarkScroll();
+    }
+
+    @SdkSuppress(minSdkVersion = 24)
+    @UiThreadTest
+    @Test
+    public void scroll_withFastScroller() {
+        mRecyclerView.seslSetFastScrollerEnabled(true);
+        benchmarkScroll();
+    }
+
+    @UiThreadTest
+    @Test
+    public void swipeRow() {
+        BenchmarkUtils.layout(mRecyclerView, SCREEN_WIDTH, SCREEN_HEIGHT);
+        final SeslSwipeListAnimator animator = new SeslSwipeListAnimator(mRecyclerView, mContext);
+        animator.setSwipeConfiguration(new SeslSwipeListAnimator.SwipeConfiguration());
+        final View row = mRecyclerView.getChildAt(2);
+
+        final BenchmarkState state = mBenchmarkRule.getState();
+        float deltaX = 0;
+        while (state.keepRunning()) {
+            deltaX = (deltaX + 40) % SCREEN_WIDTH;
+            animator.doMoveAction(mCanvas, row, deltaX, true);
+        }
+        animator.clearSwipeAnimation(row);
+    }
+
+    private void benchmarkScroll() {
+        BenchmarkUtils.layout(mRecyclerView, SCREEN_WIDTH, SCREEN_HEIGHT);
+        final BenchmarkState state = mBenchmarkRule.getState();
+        int direction = 1;
+        while (state.keepRunning()) {
+            if (!mRecyclerView.canScrollVertically(direction)) {
+                direction = -direction;
+            }
+            mRecyclerView.scrollBy(0, direction * SCROLL_STEP);
+            mRecyclerView.draw(mCanvas);
+        }
+    }
+
+    private static class TextAdapter extends RecyclerView.Adapter<RecyclerView.ViewHolder> {
+        @NonNull
+        @Override
+        public RecyclerView.ViewHolder onCreateViewHolder(@NonNull ViewGroup parent,
+                int viewType) {
+            final TextView textView = new TextView(parent.getContext());
+            textView.setLayoutParams(new RecyclerView.LayoutParams(
+                    ViewGroup.LayoutParams.MATCH_PARENT, ITEM_HEIGHT));
+            return new RecyclerView.ViewHolder(textView) {
+            };
+        }
+
+        @Override
+        public void onBindViewHolder(@NonNull RecyclerView.ViewHolder holder, int position) {
+            ((TextView) holder.itemView).setText("Item " + position);
+        }
+
+        @Override
+        public int getItemCount() {
+            return ITEM_COUNT;
+        }
+    }
+}
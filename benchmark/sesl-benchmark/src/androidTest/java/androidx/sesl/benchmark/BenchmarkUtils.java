@@ -0,0 +1,68 @@
+/*
+ * Copyright 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package androidx.sesl.benchmark;
+
+import android.content.Context;
+import android.graphics.Bitmap;
+import android.graphics.Canvas;
+import android.view.View;
+import android.view.ViewGroup;
+
+import androidx.annotation.NonNull;
+import androidx.appcompat.view.ContextThemeWrapper;
+import androidx.test.platform.app.InstrumentationRegistry;
+
+/**
+ * Shared setup of the sesl benchmarks.
+ */
+public final class BenchmarkUtils {
+    public static final int SCREEN_WIDTH = 1080;
+    public static final int SCREEN_HEIGHT = 2340;
+
+    private BenchmarkUtils() {
+    }
+
+    /**
+     * @return the target context with the sesl AppCompat theme applied, as apps use it
+     */
+    @NonNull
+    public static Context getThemedContext() {
+        return new ContextThemeWrapper(
+                InstrumentationRegistry.getInstrumentation().getTargetContext(),
+                androidx.appcompat.R.style.Theme_AppCompat_DayNight);
+    }
+
+    /**
+     * Measures and lays out a view that is not attached to a window at the given size.
+     */
+    public static void layout(@NonNull View view, int width, int height) {
+        if (view.getLayoutParams() == null) {
+            view.setLayoutParams(new ViewGroup.LayoutParams(width, height));
+        }
+        view.measure(View.MeasureSpec.makeMeasureSpec(width, View.MeasureSpec.EXACTLY),
+                View.MeasureSpec.makeMeasureSpec(height, View.MeasureSpec.EXACTLY));
+        view.layout(0, 0, width, height);
+    }
+
+    /**
+     * @return a canvas backed by a bitmap of the given size, to draw views into in software
+     */
+    @NonNull
+    public static Canvas createCanvas(int width, int height) {
+        return new Canvas(Bitmap.createBitmap(width, height, Bitmap.Config.ARGB_8888));
+    }
+}
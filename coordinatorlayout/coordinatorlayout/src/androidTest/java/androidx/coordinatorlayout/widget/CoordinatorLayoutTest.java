@@ -357,6 +357,100 @@ public class CoordinatorLayoutTest {
         verify(behavior, times(1)).onDependentViewChanged(col, viewB, viewA);
     }
 
+    @Test
+    public void testDependentViewChangedAfterTransform() throws Throwable {
+        final Instrumentation instrumentation = getInstrumentation();
+        final CoordinatorLayout col = mActivityTestRule.getActivity().mCoordinatorLayout;
+
+        // Add three views, A, B & C, where B follows A and C depends on B
+        final View viewA = new View(col.getContext());
+        final CoordinatorLayout.LayoutParams lpA = col.generateDefaultLayoutParams();
+        lpA.width = 100;
+        lpA.height = 100;
+
+        final View viewB = new View(col.getContext());
+        final CoordinatorLayout.LayoutParams lpB = col.generateDefaultLayoutParams();
+        lpB.width = 100;
+        lpB.height = 100;
+        final CoordinatorLayout.Behavior behaviorB = spy(new FollowingBehavior(viewA));
+        lpB.setBehavior(behaviorB);
+
+        final View viewC = new View(col.getContext());
+        final CoordinatorLayout.LayoutParams lpC = col.generateDefaultLayoutParams();
+        lpC.width = 100;
+        lpC.height = 100;
+        final CoordinatorLayout.Behavior behaviorC = spy(new DependentBehavior(viewB));
+        lpC.setBehavior(behaviorC);
+
+        mActivityTestRule.runOnUiThread(new Runnable() {
+            @Override
+            public void run() {
+                col.addView(viewA, lpA);
+                col.addView(viewB, lpB);
+                col.addView(viewC, lpC);
+            }
+        });
+        instrumentation.waitForIdleSync();
+        reset(behaviorB, behaviorC);
+
+        // Translating view A changes its geometry without a layout pass
+        mActivityTestRule.runOnUiThread(new Runnable() {
+            @Override
+            public void run() {
+                viewA.setTranslationX(20);
+            }
+        });
+        instrumentation.waitForIdleSync();
+
+        // Both the direct and the transitive dependent are told about the change
+        verify(behaviorB, times(1)).onDependentViewChanged(col, viewB, viewA);
+        verify(behaviorC, atLeastOnce()).onDependentViewChanged(col, viewC, viewB);
+        assertEquals(20f, viewB.getTranslationX(), 0f);
+    }
+
+    @Test
+    public void testInvalidateWithoutGeometryChangeSkipsDependents() throws Throwable {
+        final Instrumentation instrumentation = getInstrumentation();
+        final CoordinatorLayout col = mActivityTestRule.getActivity().mCoordinatorLayout;
+
+        // Add two views, A & B, where B depends on A
+        final View viewA = new View(col.getContext());
+        final CoordinatorLayout.LayoutParams lpA = col.generateDefaultLayoutParams();
+        lpA.width = 100;
+        lpA.height = 100;
+
+        final View viewB = new View(col.getContext());
+        final CoordinatorLayout.LayoutParams lpB = col.generateDefaultLayoutParams();
+        lpB.width = 100;
+        lpB.height = 100;
+        final CoordinatorLayout.Behavior behavior = spy(new DependentBehavior(viewA));
+        lpB.setBehavior(behavior);
+
+        mActivityTestRule.runOnUiThread(new Runnable() {
+            @Override
+            public void run() {
+                col.addView(viewA, lpA);
+                col.addView(viewB, lpB);
+            }
+        });
+        instrumentation.waitForIdleSync();
+        reset(behavior);
+
+        // Redraw view A and the other children without moving any of them
+        mActivityTestRule.runOnUiThread(new Runnable() {
+            @Override
+            public void run() {
+                viewA.setBackgroundColor(0xFF00FF00);
+                viewA.invalidate();
+                viewB.invalidate();
+            }
+        });
+        instrumentation.waitForIdleSync();
+
+        verify(behavior, never()).onDependentViewChanged(any(CoordinatorLayout.class),
+                any(View.class), any(View.class));
+    }
+
     @Test
     public void testDependentViewRemoved() throws Throwable {
         final Instrumentation instrumentation = getInstrumentation();
@@ -835,6 +929,19 @@ public class CoordinatorLayoutTest {
         }
     }
 
+    public static class FollowingBehavior extends DependentBehavior {
+        public FollowingBehavior(View dependency) {
+            super(dependency);
+        }
+
+        @Override
+        public boolean onDependentViewChanged(@NonNull CoordinatorLayout parent,
+                @NonNull View child, @NonNull View dependency) {
+            child.setTranslationX(dependency.getTranslationX());
+            return true;
+        }
+    }
+
     public static class DodgeBoundsBehavior extends CoordinatorLayout.Behavior<View> {
         @Override
         public boolean getInsetDodgeRect(CoordinatorLayout parent, View child, Rect rect) {
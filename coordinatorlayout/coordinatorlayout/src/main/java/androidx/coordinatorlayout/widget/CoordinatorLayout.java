@@ -53,6 +53,7 @@ import androidx.annotation.IdRes;
 import androidx.annotation.IntDef;
 import androidx.annotation.NonNull;
 import androidx.annotation.Nullable;
+import androidx.annotation.RequiresApi;
 import androidx.annotation.RestrictTo;
 import androidx.annotation.VisibleForTesting;
 import androidx.coordinatorlayout.R;
@@ -202,6 +203,9 @@ public class CoordinatorLayout extends ViewGroup implements NestedScrollingParen
 
     private OnPreDrawListener mOnPreDrawListener;
     private boolean mNeedsPreDrawListener;
+    // Whether a child may have moved, resized or been transformed since the last pre-draw
+    // dispatch, see markChildGeometryChanged(View).
+    private boolean mHasChildGeometryChanges = true;
 
     private WindowInsetsCompat mLastInsets;
     private boolean mDrawStatusBarBackground;
@@ -979,6 +983,32 @@ public class CoordinatorLayout extends ViewGroup implements NestedScrollingParen
                 onLayoutChild(child, layoutDirection);
             }
         }
+
+        for (int i = 0; i < childCount; i++) {
+            markChildGeometryChanged(mDependencySortedChildren.get(i));
+        }
+    }
+
+    /**
+     * Records that the bounds or transformation of the given child may have changed, so that
+     * the next pre-draw dispatch of {@link #onChildViewsChanged(int)} compares its rect again
+     * and updates its dependents if it moved.
+     */
+    void markChildGeometryChanged(View child) {
+        final ViewGroup.LayoutParams params = child.getLayoutParams();
+        if (params instanceof LayoutParams) {
+            ((LayoutParams) params).mGeometryChanged = true;
+            mHasChildGeometryChanges = true;
+        }
+    }
+
+    @RequiresApi(26)
+    @Override
+    public void onDescendantInvalidated(@NonNull View child, @NonNull View target) {
+        super.onDescendantInvalidated(child, target);
+        // In a hardware accelerated window, offsetting, laying out or transforming a child
+        // damages it through here, which is what lets pre-draw skip the children that did not.
+        markChildGeometryChanged(child);
     }
 
     @Override
@@ -1366,6 +1396,20 @@ public class CoordinatorLayout extends ViewGroup implements NestedScrollingParen
     final void onChildViewsChanged(@DispatchChangeEvent final int type) {
         final int layoutDirection = getLayoutDirection();
         final int childCount = mDependencySortedChildren.size();
+
+        // Pre-draw only needs to visit the children that were marked as changed and the
+        // dependents of those that did move. Only hardware accelerated windows report child
+        // damage through onDescendantInvalidated, and invisible children are not damaged at
+        // all, so those are always visited.
+        final boolean skipUnchanged = type == EVENT_PRE_DRAW
+                && Build.VERSION.SDK_INT >= 26 && isHardwareAccelerated();
+        if (skipUnchanged) {
+            if (!mHasChildGeometryChanges && !hasInvisibleChild()) {
+                return;
+            }
+            mHasChildGeometryChanges = false;
+        }
+
         final Rect inset = acquireTempRect();
         final Rect drawRect = acquireTempRect();
         final Rect lastDrawRect = acquireTempRect();
@@ -1378,6 +1422,13 @@ public class CoordinatorLayout extends ViewGroup implements NestedScrollingParen
                 continue;
             }
 
+            if (skipUnchanged && !lp.mGeometryChanged && child.getVisibility() == View.VISIBLE) {
+                // Its rect is still the last recorded one, which later children may dodge.
+                accumulateInsetEdge(lp, lp.getLastChildRect(), inset, layoutDirection);
+                continue;
+            }
+            lp.mGeometryChanged = false;
+
             // Check child views before for anchor
             for (int j = 0; j < i; j++) {
                 final View checkChild = mDependencySortedChildren.get(j);
@@ -1391,26 +1442,7 @@ public class CoordinatorLayout extends ViewGroup implements NestedScrollingParen
             getChildRect(child, true, drawRect);
 
             // Accumulate inset sizes
-            if (lp.insetEdge != Gravity.NO_GRAVITY && !drawRect.isEmpty()) {
-                final int absInsetEdge = GravityCompat.getAbsoluteGravity(
-                        lp.insetEdge, layoutDirection);
-                switch (absInsetEdge & Gravity.VERTICAL_GRAVITY_MASK) {
-                    case Gravity.TOP:
-                        inset.top = Math.max(inset.top, drawRect.bottom);
-                        break;
-                    case Gravity.BOTTOM:
-                        inset.bottom = Math.max(inset.bottom, getHeight() - drawRect.top);
-                        break;
-                }
-                switch (absInsetEdge & Gravity.HORIZONTAL_GRAVITY_MASK) {
-                    case Gravity.LEFT:
-                        inset.left = Math.max(inset.left, drawRect.right);
-                        break;
-                    case Gravity.RIGHT:
-                        inset.right = Math.max(inset.right, getWidth() - drawRect.left);
-                        break;
-                }
-            }
+            accumulateInsetEdge(lp, drawRect, inset, layoutDirection);
 
             // Dodge inset edges if necessary
             if (lp.dodgeInsetEdges != Gravity.NO_GRAVITY && child.getVisibility() == View.VISIBLE) {
@@ -1432,6 +1464,11 @@ public class CoordinatorLayout extends ViewGroup implements NestedScrollingParen
                 final LayoutParams checkLp = (LayoutParams) checkChild.getLayoutParams();
                 final Behavior b = checkLp.getBehavior();
 
+                if (skipUnchanged && checkLp.dependsOn(this, checkChild, child)) {
+                    // It may need to follow its anchor or dodge a new inset.
+                    checkLp.mGeometryChanged = true;
+                }
+
                 if (b != null && b.layoutDependsOn(this, checkChild, child)) {
                     if (type == EVENT_PRE_DRAW && checkLp.getChangedAfterNestedScroll()) {
                         // If this is from a pre-draw and we have already been changed
@@ -1468,6 +1505,39 @@ public class CoordinatorLayout extends ViewGroup implements NestedScrollingParen
         releaseTempRect(lastDrawRect);
     }
 
+    private boolean hasInvisibleChild() {
+        for (int i = 0, childCount = mDependencySortedChildren.size(); i < childCount; i++) {
+            if (mDependencySortedChildren.get(i).getVisibility() == View.INVISIBLE) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    private void accumulateInsetEdge(LayoutParams lp, Rect drawRect, Rect inset,
+            int layoutDirection) {
+        if (lp.insetEdge != Gravity.NO_GRAVITY && !drawRect.isEmpty()) {
+            final int absInsetEdge = GravityCompat.getAbsoluteGravity(
+                    lp.insetEdge, layoutDirection);
+            switch (absInsetEdge & Gravity.VERTICAL_GRAVITY_MASK) {
+                case Gravity.TOP:
+                    inset.top = Math.max(inset.top, drawRect.bottom);
+                    break;
+                case Gravity.BOTTOM:
+                    inset.bottom = Math.max(inset.bottom, getHeight() - drawRect.top);
+                    break;
+            }
+            switch (absInsetEdge & Gravity.HORIZONTAL_GRAVITY_MASK) {
+                case Gravity.LEFT:
+                    inset.left = Math.max(inset.left, drawRect.right);
+                    break;
+                case Gravity.RIGHT:
+                    inset.right = Math.max(inset.right, getWidth() - drawRect.left);
+                    break;
+            }
+        }
+    }
+
     @SuppressWarnings("unchecked")
     private void offsetChildByInset(final View child, final Rect inset, final int layoutDirection) {
         if (!child.isLaidOut()) {
@@ -2950,6 +3020,8 @@ public class CoordinatorLayout extends ViewGroup implements NestedScrollingParen
         private boolean mDidAcceptNestedScrollTouch;
         private boolean mDidAcceptNestedScrollNonTouch;
         private boolean mDidChangeAfterNestedScroll;
+        // Whether the view may have moved since the last pre-draw dispatch compared its rect.
+        boolean mGeometryChanged = true;
 
         final Rect mLastChildRect = new Rect();
 
@@ -25,8 +25,9 @@ import android.util.Log;
 import androidx.annotation.NonNull;
 import androidx.annotation.Nullable;
 import androidx.annotation.RestrictTo;
+import androidx.collection.LruCache;
 
-import java.util.ArrayList;
+import java.util.Arrays;
 
 // This class is a duplicate from the PathParser.java of frameworks/base, with slight
 // update on incompatible API like copyOfRange().
@@ -36,6 +37,19 @@ import java.util.ArrayList;
 public final class PathParser {
     private static final String LOGTAG = "PathParser";
 
+    // Parsed path data by path string, shared by everything that parses the same strings, such as
+    // the same vector drawable inflated again. Entries are never handed out; callers get copies.
+    private static final LruCache<String, PackedPathData> sPathDataCache = new LruCache<>(100);
+
+    // The current point, control point and segment start addCommand works with, so that drawing
+    // a path does not allocate.
+    private static final ThreadLocal<float[]> sCurrentPoints = new ThreadLocal<>();
+
+    // The powers of ten that are exact floats, used to parse short decimal numbers.
+    private static final float[] POWERS_OF_TEN = {
+            1f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f
+    };
+
     // Copy from Arrays.copyOfRange() which is only available from API level 9.
 
     /**
@@ -76,9 +90,9 @@ public final class PathParser {
     @NonNull
     public static Path createPathFromPathData(@NonNull String pathData) {
         Path path = new Path();
-        PathDataNode[] nodes = createNodesFromPathData(pathData);
+        PackedPathData data = getPathData(pathData);
         try {
-            PathDataNode.nodesToPath(nodes, path);
+            data.toPath(path);
         } catch (RuntimeException e) {
             throw new RuntimeException("Error in parsing " + pathData, e);
         }
@@ -92,25 +106,39 @@ public final class PathParser {
     @SuppressWarnings("ArrayReturn")
     @NonNull
     public static PathDataNode[] createNodesFromPathData(@NonNull String pathData) {
-        int start = 0;
-        int end = 1;
-
-        ArrayList<PathDataNode> list = new ArrayList<PathDataNode>();
-        while (end < pathData.length()) {
-            end = nextStart(pathData, end);
-            String s = pathData.substring(start, end).trim();
-            if (!s.isEmpty()) {
-                float[] val = getFloats(s);
-                addNode(list, s.charAt(0), val);
-            }
-
-            start = end;
-            end++;
+        final PackedPathData data = getPathData(pathData);
+        final PathDataNode[] nodes = new PathDataNode[data.mCommands.length];
+        int paramStart = 0;
+        for (int i = 0; i < nodes.length; i++) {
+            final int paramEnd = data.mParamEnds[i];
+            nodes[i] = new PathDataNode((char) data.mCommands[i],
+                    copyOfRange(data.mParams, paramStart, paramEnd));
+            paramStart = paramEnd;
         }
-        if ((end - start) == 1 && start < pathData.length()) {
-            addNode(list, pathData.charAt(start), new float[0]);
+        return nodes;
+    }
+
+    /**
+     * Parses a string representation of an SVG path into a {@link PackedPathData}, which holds
+     * all commands and parameters in flat arrays rather than one {@link PathDataNode} each.
+     *
+     * @param pathData The string representing a path, the same as "d" string in svg file.
+     * @return the parsed path data, which the caller may modify.
+     */
+    @NonNull
+    public static PackedPathData createPackedPathData(@NonNull String pathData) {
+        return new PackedPathData(getPathData(pathData));
+    }
+
+    private static PackedPathData getPathData(String pathData) {
+        PackedPathData data = sPathDataCache.get(pathData);
+        if (data == null) {
+            final Parser parser = new Parser(pathData);
+            parser.parse();
+            data = parser.toPathData();
+            sPathDataCache.put(pathData, data);
         }
-        return list.toArray(new PathDataNode[0]);
+        return data;
     }
 
     /**
@@ -169,9 +197,8 @@ public final class PathParser {
     ) {
         for (int i = 0; i < source.length; i++) {
             target[i].mType = source[i].mType;
-            for (int j = 0; j < source[i].mParams.length; j++) {
-                target[i].mParams[j] = source[i].mParams[j];
-            }
+            System.arraycopy(source[i].mParams, 0, target[i].mParams, 0,
+                    source[i].mParams.length);
         }
     }
 
@@ -193,117 +220,231 @@ public final class PathParser {
         return end;
     }
 
-    private static void addNode(ArrayList<PathDataNode> list, char cmd, float[] val) {
-        list.add(new PathDataNode(cmd, val));
-    }
+    /**
+     * Parses a path string in one pass into flat arrays of commands and parameters, reading the
+     * numbers in place instead of through substrings.
+     */
+    private static final class Parser {
+        private final String mPathData;
+        private byte[] mCommands = new byte[16];
+        private int[] mParamEnds = new int[16];
+        private float[] mParams = new float[32];
+        private int mCommandCount;
+        private int mParamCount;
+        // Whether the number extract() stopped at starts the next number, being a '-' or '.'.
+        private boolean mEndWithNegOrDot;
+
+        Parser(String pathData) {
+            mPathData = pathData;
+        }
 
-    private static class ExtractFloatResult {
-        // We need to return the position of the next separator and whether the
-        // next float starts with a '-' or a '.'.
-        int mEndPosition;
-        boolean mEndWithNegOrDot;
+        void parse() {
+            final String s = mPathData;
+            final int length = s.length();
+            // Every command starts at a letter, or at the start of the string, and runs until
+            // the next letter.
+            int start = 0;
+            while (start < length) {
+                final int end = nextStart(s, start + 1);
+                int commandIndex = start;
+                while (commandIndex < end && s.charAt(commandIndex) <= ' ') {
+                    commandIndex++;
+                }
+                if (commandIndex < end) {
+                    final char command = s.charAt(commandIndex);
+                    if (command != 'z' && command != 'Z') {
+                        // trailing whitespace is not a number, like in the trimmed command
+                        int paramsEnd = end;
+                        while (s.charAt(paramsEnd - 1) <= ' ') {
+                            paramsEnd--;
+                        }
+                        parseFloats(commandIndex, paramsEnd);
+                    }
+                    addCommand(command);
+                }
+                start = end;
+            }
+        }
 
-        ExtractFloatResult() {
+        PackedPathData toPathData() {
+            return new PackedPathData(Arrays.copyOf(mCommands, mCommandCount),
+                    Arrays.copyOf(mParamEnds, mCommandCount),
+                    Arrays.copyOf(mParams, mParamCount));
         }
-    }
 
-    /**
-     * Parse the floats in the string.
-     * This is an optimized version of parseFloat(s.split(",|\\s"));
-     *
-     * @param s the string containing a command and list of floats
-     * @return array of floats
-     */
-    private static float[] getFloats(String s) {
-        if (s.charAt(0) == 'z' || s.charAt(0) == 'Z') {
-            return new float[0];
+        private void addCommand(char command) {
+            if (mCommandCount == mCommands.length) {
+                mCommands = Arrays.copyOf(mCommands, mCommandCount * 2);
+                mParamEnds = Arrays.copyOf(mParamEnds, mCommandCount * 2);
+            }
+            mCommands[mCommandCount] = (byte) command;
+            mParamEnds[mCommandCount] = mParamCount;
+            mCommandCount++;
         }
-        try {
-            float[] results = new float[s.length()];
-            int count = 0;
-            int startPosition = 1;
-            int endPosition = 0;
 
-            ExtractFloatResult result = new ExtractFloatResult();
-            int totalLength = s.length();
+        private void addParam(float value) {
+            if (mParamCount == mParams.length) {
+                mParams = Arrays.copyOf(mParams, mParamCount * 2);
+            }
+            mParams[mParamCount++] = value;
+        }
 
+        /**
+         * Parses the floats following the command at {@code commandIndex}, up to {@code end}.
+         */
+        private void parseFloats(int commandIndex, int end) {
+            final String s = mPathData;
+            int startPosition = commandIndex + 1;
             // The startPosition should always be the first character of the
             // current number, and endPosition is the character after the current
             // number.
-            while (startPosition < totalLength) {
-                extract(s, startPosition, result);
-                endPosition = result.mEndPosition;
+            while (startPosition < end) {
+                final int endPosition = extract(startPosition, end);
 
                 if (startPosition < endPosition) {
-                    results[count++] = Float.parseFloat(
-                            s.substring(startPosition, endPosition));
+                    try {
+                        addParam(parseFloat(s, startPosition, endPosition));
+                    } catch (NumberFormatException e) {
+                        throw new RuntimeException("error in parsing \""
+                                + s.substring(commandIndex, end).trim() + "\"", e);
+                    }
                 }
 
-                if (result.mEndWithNegOrDot) {
+                if (mEndWithNegOrDot) {
                     // Keep the '-' or '.' sign with next number.
                     startPosition = endPosition;
                 } else {
                     startPosition = endPosition + 1;
                 }
             }
-            return copyOfRange(results, 0, count);
-        } catch (NumberFormatException e) {
-            throw new RuntimeException("error in parsing \"" + s + "\"", e);
         }
-    }
 
-    /**
-     * Calculate the position of the next comma or space or negative sign
-     *
-     * @param s      the string to search
-     * @param start  the position to start searching
-     * @param result the result of the extraction, including the position of the
-     *               the starting position of next number, whether it is ending with a '-'.
-     */
-    private static void extract(String s, int start, ExtractFloatResult result) {
-        // Now looking for ' ', ',', '.' or '-' from the start.
-        int currentIndex = start;
-        boolean foundSeparator = false;
-        result.mEndWithNegOrDot = false;
-        boolean secondDot = false;
-        boolean isExponential = false;
-        for (; currentIndex < s.length(); currentIndex++) {
-            boolean isPrevExponential = isExponential;
-            isExponential = false;
-            char currentChar = s.charAt(currentIndex);
-            switch (currentChar) {
-                case ' ':
-                case ',':
-                    foundSeparator = true;
-                    break;
-                case '-':
-                    // The negative sign following a 'e' or 'E' is not a separator.
-                    if (currentIndex != start && !isPrevExponential) {
+        /**
+         * Calculate the position of the next comma or space or negative sign
+         *
+         * @param start the position to start searching
+         * @param end   the end of the current command
+         * @return the position after the number starting at {@code start}
+         */
+        private int extract(int start, int end) {
+            final String s = mPathData;
+            // Now looking for ' ', ',', '.' or '-' from the start.
+            int currentIndex = start;
+            boolean foundSeparator = false;
+            mEndWithNegOrDot = false;
+            boolean secondDot = false;
+            boolean isExponential = false;
+            for (; currentIndex < end; currentIndex++) {
+                boolean isPrevExponential = isExponential;
+                isExponential = false;
+                char currentChar = s.charAt(currentIndex);
+                switch (currentChar) {
+                    case ' ':
+                    case ',':
                         foundSeparator = true;
-                        result.mEndWithNegOrDot = true;
-                    }
+                        break;
+                    case '-':
+                        // The negative sign following a 'e' or 'E' is not a separator.
+                        if (currentIndex != start && !isPrevExponential) {
+                            foundSeparator = true;
+                            mEndWithNegOrDot = true;
+                        }
+                        break;
+                    case '.':
+                        if (!secondDot) {
+                            secondDot = true;
+                        } else {
+                            // This is the second dot, and it is considered as a separator.
+                            foundSeparator = true;
+                            mEndWithNegOrDot = true;
+                        }
+                        break;
+                    case 'e':
+                    case 'E':
+                        isExponential = true;
+                        break;
+                }
+                if (foundSeparator) {
                     break;
-                case '.':
-                    if (!secondDot) {
-                        secondDot = true;
-                    } else {
-                        // This is the second dot, and it is considered as a separator.
-                        foundSeparator = true;
-                        result.mEndWithNegOrDot = true;
+                }
+            }
+            // When there is nothing found, then we put the end position to the end
+            // of the command.
+            return currentIndex;
+        }
+
+        /**
+         * Parses the number between {@code start} and {@code end} like
+         * {@link Float#parseFloat(String)} does. Numbers with at most 7 significant digits and
+         * a decimal exponent of at most 10 are read in place: their digits and the power of ten
+         * are exact floats, so one correctly rounded multiplication or division gives the same
+         * result as {@link Float#parseFloat(String)}. Other numbers go through it.
+         */
+        private static float parseFloat(String s, int start, int end) {
+            int i = start;
+            boolean negative = false;
+            char c = s.charAt(i);
+            if (c == '-' || c == '+') {
+                negative = c == '-';
+                i++;
+            }
+            long mantissa = 0;
+            int exponent = 0;
+            boolean hasDigits = false;
+            boolean fastPath = true;
+            boolean inFraction = false;
+            for (; i < end; i++) {
+                c = s.charAt(i);
+                if (c >= '0' && c <= '9') {
+                    hasDigits = true;
+                    mantissa = mantissa * 10 + (c - '0');
+                    if (inFraction) {
+                        exponent--;
                     }
+                    if (mantissa >= 1 << 24) {
+                        fastPath = false;
+                        break;
+                    }
+                } else if (c == '.' && !inFraction) {
+                    inFraction = true;
+                } else {
                     break;
-                case 'e':
-                case 'E':
-                    isExponential = true;
-                    break;
+                }
+            }
+            if (fastPath && hasDigits && i < end && (c == 'e' || c == 'E')) {
+                i++;
+                boolean negativeExponent = false;
+                if (i < end && (s.charAt(i) == '-' || s.charAt(i) == '+')) {
+                    negativeExponent = s.charAt(i) == '-';
+                    i++;
+                }
+                int explicitExponent = 0;
+                final int exponentStart = i;
+                for (; i < end; i++) {
+                    c = s.charAt(i);
+                    if (c < '0' || c > '9' || explicitExponent > 1000) {
+                        break;
+                    }
+                    explicitExponent = explicitExponent * 10 + (c - '0');
+                }
+                if (i == exponentStart) {
+                    fastPath = false;
+                }
+                exponent += negativeExponent ? -explicitExponent : explicitExponent;
             }
-            if (foundSeparator) {
-                break;
+            if (fastPath && hasDigits && i == end) {
+                if (mantissa == 0) {
+                    return negative ? -0f : 0f;
+                }
+                if (exponent >= -10 && exponent <= 10) {
+                    final float value = exponent < 0
+                            ? (float) mantissa / POWERS_OF_TEN[-exponent]
+                            : (float) mantissa * POWERS_OF_TEN[exponent];
+                    return negative ? -value : value;
+                }
             }
+            return Float.parseFloat(s.substring(start, end));
         }
-        // When there is nothing found, then we put the end position to the end
-        // of the string.
-        result.mEndPosition = currentIndex;
     }
 
     /**
@@ -378,15 +519,168 @@ public final class PathParser {
             @SuppressWarnings("ArrayReturn") @NonNull PathDataNode[] node,
             @NonNull Path path
     ) {
-        float[] current = new float[6];
+        float[] current = obtainCurrentPoints();
         char previousCommand = 'm';
         for (PathDataNode pathDataNode : node) {
             PathDataNode.addCommand(path, current, previousCommand, pathDataNode.mType,
-                    pathDataNode.mParams);
+                    pathDataNode.mParams, 0, pathDataNode.mParams.length);
             previousCommand = pathDataNode.mType;
         }
     }
 
+    private static float[] obtainCurrentPoints() {
+        float[] current = sCurrentPoints.get();
+        if (current == null) {
+            current = new float[6];
+            sCurrentPoints.set(current);
+        } else {
+            Arrays.fill(current, 0);
+        }
+        return current;
+    }
+
+    /**
+     * The commands and parameters of a whole "d" attribute of an svg file, each kept in one flat
+     * array instead of one {@link PathDataNode} per command. Morphing animations can
+     * {@link #interpolate} and {@link #set} it in place and draw it with {@link #toPath} without
+     * allocating.
+     *
+     * @see #createPackedPathData(String)
+     */
+    public static final class PackedPathData {
+        // One command letter per node.
+        final byte[] mCommands;
+        // The end of the parameters of each node in mParams; each node's start is the previous
+        // node's end.
+        final int[] mParamEnds;
+        final float[] mParams;
+
+        PackedPathData(byte[] commands, int[] paramEnds, float[] params) {
+            mCommands = commands;
+            mParamEnds = paramEnds;
+            mParams = params;
+        }
+
+        /**
+         * Creates a deep copy of {@code source}.
+         */
+        public PackedPathData(@NonNull PackedPathData source) {
+            mCommands = source.mCommands.clone();
+            mParamEnds = source.mParamEnds.clone();
+            mParams = source.mParams.clone();
+        }
+
+        /**
+         * @return the number of commands, which is the number of {@link PathDataNode}s
+         * {@link PathParser#createNodesFromPathData(String)} returns for the same string.
+         */
+        public int getCommandCount() {
+            return mCommands.length;
+        }
+
+        /**
+         * @return whether this path data can morph into {@code other}, that is, both have the
+         * same commands with the same numbers of parameters.
+         */
+        public boolean canMorph(@Nullable PackedPathData other) {
+            return other != null
+                    && Arrays.equals(mCommands, other.mCommands)
+                    && Arrays.equals(mParamEnds, other.mParamEnds);
+        }
+
+        /**
+         * Copies the parameters of {@code source} into this path data.
+         *
+         * @throws IllegalArgumentException if {@link #canMorph(PackedPathData)} is false for
+         *                                  {@code source}
+         */
+        public void set(@NonNull PackedPathData source) {
+            if (!canMorph(source)) {
+                throw new IllegalArgumentException("Can't set incompatible pathData");
+            }
+            System.arraycopy(source.mParams, 0, mParams, 0, mParams.length);
+        }
+
+        /**
+         * Sets the parameters of this path data to the interpolation between {@code from} and
+         * {@code to} at {@code fraction}.
+         *
+         * @param from     The path data when fraction is 0
+         * @param to       The path data when fraction is 1
+         * @param fraction A float fraction value in the range of 0 to 1
+         * @throws IllegalArgumentException if this, {@code from} and {@code to} can't morph into
+         *                                  each other
+         */
+        public void interpolate(@NonNull PackedPathData from, @NonNull PackedPathData to,
+                float fraction) {
+            if (!canMorph(from) || !from.canMorph(to)) {
+                throw new IllegalArgumentException(
+                        "Can't interpolate between two incompatible pathData");
+            }
+            final float[] params = mParams;
+            final float[] fromParams = from.mParams;
+            final float[] toParams = to.mParams;
+            for (int i = 0; i < params.length; i++) {
+                params[i] = fromParams[i] * (1 - fraction) + toParams[i] * fraction;
+            }
+        }
+
+        /**
+         * Adds the commands of this path data to {@code path}.
+         *
+         * @param path The target Path object.
+         */
+        public void toPath(@NonNull Path path) {
+            final float[] current = obtainCurrentPoints();
+            char previousCommand = 'm';
+            int paramStart = 0;
+            for (int i = 0; i < mCommands.length; i++) {
+                final char command = (char) mCommands[i];
+                final int paramEnd = mParamEnds[i];
+                final int paramsPerSegment = getParamsPerSegment(command);
+                if (paramsPerSegment > 0 && (paramEnd - paramStart) % paramsPerSegment != 0) {
+                    // A PathDataNode would run past the end of its own parameters here.
+                    throw new ArrayIndexOutOfBoundsException("Command " + command + " has "
+                            + (paramEnd - paramStart) + " parameters");
+                }
+                PathDataNode.addCommand(path, current, previousCommand, command, mParams,
+                        paramStart, paramEnd);
+                previousCommand = command;
+                paramStart = paramEnd;
+            }
+        }
+
+        private static int getParamsPerSegment(char command) {
+            switch (command) {
+                case 'm':
+                case 'M':
+                case 'l':
+                case 'L':
+                case 't':
+                case 'T':
+                    return 2;
+                case 'h':
+                case 'H':
+                case 'v':
+                case 'V':
+                    return 1;
+                case 'c':
+                case 'C':
+                    return 6;
+                case 's':
+                case 'S':
+                case 'q':
+                case 'Q':
+                    return 4;
+                case 'a':
+                case 'A':
+                    return 7;
+                default:
+                    return 0;
+            }
+        }
+    }
+
     /**
      * Each PathDataNode represents one command in the "d" attribute of the svg
      * file.
@@ -457,7 +751,7 @@ public final class PathParser {
         }
 
         private static void addCommand(Path path, float[] current,
-                char previousCmd, char cmd, float[] val) {
+                char previousCmd, char cmd, float[] val, int start, int end) {
 
             int incr = 2;
             float currentX = current[0];
@@ -512,12 +806,12 @@ public final class PathParser {
                     break;
             }
 
-            for (int k = 0; k < val.length; k += incr) {
+            for (int k = start; k < end; k += incr) {
                 switch (cmd) {
                     case 'm': // moveto - Start a new sub-path (relative)
                         currentX += val[k + 0];
                         currentY += val[k + 1];
-                        if (k > 0) {
+                        if (k > start) {
                             // According to the spec, if a moveto is followed by multiple
                             // pairs of coordinates, the subsequent pairs are treated as
                             // implicit lineto commands.
@@ -531,7 +825,7 @@ public final class PathParser {
                     case 'M': // moveto - Start a new sub-path
                         currentX = val[k + 0];
                         currentY = val[k + 1];
-                        if (k > 0) {
+                        if (k > start) {
                             // According to the spec, if a moveto is followed by multiple
                             // pairs of coordinates, the subsequent pairs are treated as
                             // implicit lineto commands.
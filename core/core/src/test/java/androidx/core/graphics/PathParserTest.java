@@ -0,0 +1,251 @@
+/*
+ * Copyright 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package androidx.core.graphics;
+
+import static org.junit.Assert.assertArrayEquals;
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertFalse;
+import static org.junit.Assert.assertTrue;
+
+import org.junit.Test;
+import org.junit.runner.RunWith;
+import org.junit.runners.JUnit4;
+
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.List;
+import java.util.Random;
+
+@RunWith(JUnit4.class)
+public class PathParserTest {
+
+    private static final String[] PATHS = {
+            "M1,2L3,4",
+            "M1,2 \tL3,4",
+            "M1,2 L3,4 \n",
+            "\n M 1 2\tL 3 4\n z \n",
+            "m0,0l-1-2h.5.5v-.25e1-1E-1Z",
+            "M12.5,3.25c1.75e-3,-2 4.5E2,6 7,8s-9,10,11,12z",
+            "M0 0a1.5 1.5 0 1 0 3 3Q1 2 3 4t5 6Z",
+            "M1\t,2L3,\t4",
+            "M123456789,0.000000001L1e11,1e-11",
+            "M-0,-0.0L+1,+2",
+            "z",
+            "M1,1z",
+    };
+
+    @Test
+    public void nodesMatchThePreviousParser() {
+        for (String path : PATHS) {
+            assertNodesEqual(path, parseLikeBefore(path),
+                    PathParser.createNodesFromPathData(path));
+        }
+    }
+
+    @Test
+    public void numbersMatchFloatParseFloat() {
+        // covers the in-place conversion as well as the numbers that fall back to parseFloat
+        final Random random = new Random(23);
+        for (int run = 0; run < 20000; run++) {
+            final String number = randomNumber(random);
+            final PathParser.PathDataNode[] nodes =
+                    PathParser.createNodesFromPathData("L" + number + " " + number);
+            final float expected = Float.parseFloat(number);
+            assertEquals(number, Float.floatToIntBits(expected),
+                    Float.floatToIntBits(nodes[0].getParams()[0]));
+            assertEquals(number, Float.floatToIntBits(expected),
+                    Float.floatToIntBits(nodes[0].getParams()[1]));
+        }
+    }
+
+    @Test
+    public void packedPathDataMatchesNodes() {
+        for (String path : PATHS) {
+            final PathParser.PackedPathData data = PathParser.createPackedPathData(path);
+            final PathParser.PathDataNode[] nodes = PathParser.createNodesFromPathData(path);
+            assertEquals(path, nodes.length, data.getCommandCount());
+            int paramStart = 0;
+            for (int i = 0; i < nodes.length; i++) {
+                assertEquals(path, nodes[i].getType(), (char) data.mCommands[i]);
+                assertArrayEquals(path, nodes[i].getParams(),
+                        Arrays.copyOfRange(data.mParams, paramStart, data.mParamEnds[i]), 0f);
+                paramStart = data.mParamEnds[i];
+            }
+        }
+    }
+
+    @Test
+    public void packedPathDataIsACopy() {
+        final PathParser.PackedPathData first = PathParser.createPackedPathData("M1,2L3,4");
+        first.mParams[0] = 100f;
+        final PathParser.PackedPathData second = PathParser.createPackedPathData("M1,2L3,4");
+        assertEquals(1f, second.mParams[0], 0f);
+
+        final PathParser.PackedPathData copy = new PathParser.PackedPathData(second);
+        copy.mParams[1] = 100f;
+        assertEquals(2f, second.mParams[1], 0f);
+    }
+
+    @Test
+    public void packedPathDataMorphsInPlace() {
+        final PathParser.PackedPathData from = PathParser.createPackedPathData("M0,0L10,20z");
+        final PathParser.PackedPathData to = PathParser.createPackedPathData("M10,10L30,0z");
+        final PathParser.PackedPathData target = new PathParser.PackedPathData(from);
+        assertTrue(target.canMorph(to));
+        assertFalse(target.canMorph(PathParser.createPackedPathData("M0,0L10,20")));
+        assertFalse(target.canMorph(PathParser.createPackedPathData("M0,0C1,2,3,4,5,6z")));
+        assertFalse(target.canMorph(null));
+
+        target.interpolate(from, to, 0.5f);
+        assertArrayEquals(new float[]{5, 5, 20, 10}, target.mParams, 0f);
+
+        target.set(to);
+        assertArrayEquals(to.mParams, target.mParams, 0f);
+    }
+
+    @Test(expected = IllegalArgumentException.class)
+    public void packedPathDataRejectsIncompatibleSource() {
+        PathParser.createPackedPathData("M0,0L1,1").set(
+                PathParser.createPackedPathData("M0,0L1,1L2,2"));
+    }
+
+    private static void assertNodesEqual(String path, List<PathParser.PathDataNode> expected,
+            PathParser.PathDataNode[] actual) {
+        assertEquals(path, expected.size(), actual.length);
+        for (int i = 0; i < actual.length; i++) {
+            assertEquals(path, expected.get(i).getType(), actual[i].getType());
+            assertArrayEquals(path, expected.get(i).getParams(), actual[i].getParams(), 0f);
+        }
+    }
+
+    private static String randomNumber(Random random) {
+        final StringBuilder number = new StringBuilder();
+        if (random.nextInt(3) == 0) {
+            number.append('-');
+        }
+        final int digits = 1 + random.nextInt(10);
+        final int dot = random.nextInt(digits + 2) - 1;
+        for (int i = 0; i < digits; i++) {
+            if (i == dot) {
+                number.append('.');
+            }
+            number.append((char) ('0' + random.nextInt(10)));
+        }
+        if (random.nextInt(3) == 0) {
+            number.append(random.nextBoolean() ? 'e' : 'E');
+            if (random.nextBoolean()) {
+                number.append('-');
+            }
+            number.append(random.nextInt(14));
+        }
+        return number.toString();
+    }
+
+    /**
+     * The parser from before path data was packed, which cut each command out of the string,
+     * trimmed it, and read every number from its own substring.
+     */
+    private static List<PathParser.PathDataNode> parseLikeBefore(String pathData) {
+        int start = 0;
+        int end = 1;
+        final List<PathParser.PathDataNode> list = new ArrayList<>();
+        while (end < pathData.length()) {
+            end = nextStart(pathData, end);
+            final String s = pathData.substring(start, end).trim();
+            if (!s.isEmpty()) {
+                list.add(new PathParser.PathDataNode(s.charAt(0), getFloats(s)));
+            }
+            start = end;
+            end++;
+        }
+        if ((end - start) == 1 && start < pathData.length()) {
+            list.add(new PathParser.PathDataNode(pathData.charAt(start), new float[0]));
+        }
+        return list;
+    }
+
+    private static int nextStart(String s, int end) {
+        while (end < s.length()) {
+            final char c = s.charAt(end);
+            if ((((c - 'A') * (c - 'Z') <= 0) || ((c - 'a') * (c - 'z') <= 0))
+                    && c != 'e' && c != 'E') {
+                return end;
+            }
+            end++;
+        }
+        return end;
+    }
+
+    private static float[] getFloats(String s) {
+        if (s.charAt(0) == 'z' || s.charAt(0) == 'Z') {
+            return new float[0];
+        }
+        final float[] results = new float[s.length()];
+        int count = 0;
+        int startPosition = 1;
+        final boolean[] endWithNegOrDot = new boolean[1];
+        while (startPosition < s.length()) {
+            final int endPosition = extract(s, startPosition, endWithNegOrDot);
+            if (startPosition < endPosition) {
+                results[count++] = Float.parseFloat(s.substring(startPosition, endPosition));
+            }
+            startPosition = endWithNegOrDot[0] ? endPosition : endPosition + 1;
+        }
+        return Arrays.copyOf(results, count);
+    }
+
+    private static int extract(String s, int start, boolean[] endWithNegOrDot) {
+        int currentIndex = start;
+        boolean foundSeparator = false;
+        endWithNegOrDot[0] = false;
+        boolean secondDot = false;
+        boolean isExponential = false;
+        for (; currentIndex < s.length(); currentIndex++) {
+            final boolean isPrevExponential = isExponential;
+            isExponential = false;
+            final char currentChar = s.charAt(currentIndex);
+            switch (currentChar) {
+                case ' ':
+                case ',':
+                    foundSeparator = true;
+                    break;
+                case '-':
+                    if (currentIndex != start && !isPrevExponential) {
+                        foundSeparator = true;
+                        endWithNegOrDot[0] = true;
+                    }
+                    break;
+                case '.':
+                    if (!secondDot) {
+                        secondDot = true;
+                    } else {
+                        foundSeparator = true;
+                        endWithNegOrDot[0] = true;
+                    }
+                    break;
+                case 'e':
+                case 'E':
+                    isExponential = true;
+                    break;
+            }
+            if (foundSeparator) {
+                break;
+            }
+        }
+        return currentIndex;
+    }
+}
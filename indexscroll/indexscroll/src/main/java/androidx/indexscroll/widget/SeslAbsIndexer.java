@@ -22,15 +22,21 @@ import static androidx.recyclerview.widget.LinearLayoutManager.INVALID_OFFSET;
 import android.database.DataSetObservable;
 import android.database.DataSetObserver;
 import android.os.Bundle;
+import android.os.Handler;
+import android.os.Looper;
+import android.os.Process;
+import android.text.TextUtils;
 import android.util.Log;
 import android.util.SparseIntArray;
 
 import androidx.annotation.NonNull;
+import androidx.annotation.Nullable;
 import androidx.annotation.RestrictTo;
 import androidx.indexscroll.widget.SeslIndexScrollView.IndexScroll;
 
 import java.text.Collator;
-import java.util.HashMap;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
 
 /*
  * Original code by Samsung, all rights reserved to the original author.
@@ -52,6 +58,13 @@ public abstract class SeslAbsIndexer extends DataSetObserver {
     static final String INDEXSCROLL_INDEX_COUNTS = "indexscroll_index_counts";
     static final String INDEXSCROLL_INDEX_TITLES = "indexscroll_index_titles";
 
+    private static final String INDEX_STATE_ALPHABET = "indexscroll_state_alphabet";
+    private static final String INDEX_STATE_POSITIONS = "indexscroll_state_positions";
+    private static final String INDEX_STATE_ITEMS = "indexscroll_state_items";
+    private static final String INDEX_STATE_PREV_ITEMS = "indexscroll_state_prev_items";
+
+    private static ExecutorService sIndexExecutor;
+
     private SparseIntArray mAlphaMap;
     private CharSequence mAlphabet;
     private String[] mAlphabetArray;
@@ -74,6 +87,15 @@ public abstract class SeslAbsIndexer extends DataSetObserver {
     private boolean mUseDigitIndex = false;
     private boolean mIsInitialized = false;
 
+    private final Handler mMainHandler = new Handler(Looper.getMainLooper());
+    private boolean mAsyncIndexing = false;
+    // Bumped whenever a published or in flight index is superseded
+    private volatile int mIndexGeneration = 0;
+    // Items at and right before each cached position, used to validate them on rebuild
+    private String[] mBoundaryItems;
+    private String[] mBoundaryPrevItems;
+    private Bundle mRestoredIndexState;
+
     protected abstract Bundle getBundle();
 
     protected abstract String getItemAt(int pos);
@@ -199,6 +221,10 @@ public abstract class SeslAbsIndexer extends DataSetObserver {
                     + ((Object) alphabet));
         }
 
+        mIndexGeneration++;
+        mBoundaryItems = null;
+        mBoundaryPrevItems = null;
+
         mAlphabet = alphabet;
         mAlphabetLength = alphabet.length();
         mCachingValue = new int[mAlphabetLength];
@@ -228,8 +254,59 @@ public abstract class SeslAbsIndexer extends DataSetObserver {
         return mAlphabetArray;
     }
 
-    private int compare(String word, String indexString) {
-        return mCollator.compare(word, indexString);
+    /**
+     * Builds the index on a background thread and publishes it when done instead of collating
+     * on the calling thread. The data source must then allow {@link #getItemAt(int)} from a
+     * worker thread. The index is also rebuilt whenever {@link #onChanged()} is received,
+     * reusing the positions that are still valid.
+     */
+    void setAsyncIndexing(boolean enabled) {
+        mAsyncIndexing = enabled;
+    }
+
+    /**
+     * Returns the last built index, to be passed to {@link #restoreIndexState(Bundle)} by a
+     * later indexer over the same data, or null if the index was not built yet.
+     */
+    @Nullable
+    Bundle saveIndexState() {
+        if (mBoundaryItems == null) {
+            return null;
+        }
+        final Bundle state = new Bundle();
+        state.putString(INDEX_STATE_ALPHABET, mAlphabet.toString());
+        state.putIntArray(INDEX_STATE_POSITIONS, mCachingValue.clone());
+        state.putStringArray(INDEX_STATE_ITEMS, mBoundaryItems);
+        state.putStringArray(INDEX_STATE_PREV_ITEMS, mBoundaryPrevItems);
+        return state;
+    }
+
+    /**
+     * Seeds the next {@link #cacheIndexInfo()} with a state saved by
+     * {@link #saveIndexState()}. The saved positions are used right away and only those whose
+     * neighbouring items changed are searched again.
+     */
+    void restoreIndexState(@Nullable Bundle state) {
+        mRestoredIndexState = state;
+    }
+
+    private void applyRestoredIndexState() {
+        final Bundle state = mRestoredIndexState;
+        mRestoredIndexState = null;
+        if (state == null || !mAlphabet.toString().equals(state.getString(INDEX_STATE_ALPHABET))) {
+            return;
+        }
+        final int[] positions = state.getIntArray(INDEX_STATE_POSITIONS);
+        final String[] items = state.getStringArray(INDEX_STATE_ITEMS);
+        final String[] prevItems = state.getStringArray(INDEX_STATE_PREV_ITEMS);
+        if (positions == null || items == null || prevItems == null
+                || positions.length != mAlphabetLength || items.length != mAlphabetLength
+                || prevItems.length != mAlphabetLength) {
+            return;
+        }
+        System.arraycopy(positions, 0, mCachingValue, 0, mAlphabetLength);
+        mBoundaryItems = items;
+        mBoundaryPrevItems = prevItems;
     }
 
     void cacheIndexInfo() {
@@ -244,22 +321,132 @@ public abstract class SeslAbsIndexer extends DataSetObserver {
                 }
             }
 
-            onBeginTransaction();
-            for (int i = 0; i < mAlphabetLength; i++) {
-                mCachingValue[i] = getPositionForString("" + mAlphabet.charAt(i));
+            applyRestoredIndexState();
+            final IndexBuild build = new IndexBuild();
+            if (mAsyncIndexing) {
+                getIndexExecutor().execute(build);
+                return;
             }
+
+            onBeginTransaction();
+            build.buildIndex(mAlphaMap, mCollator);
             onEndTransaction();
+            build.publish();
         }
     }
 
-    private int getPositionForString(String searchString) {
+    private static synchronized ExecutorService getIndexExecutor() {
+        if (sIndexExecutor == null) {
+            sIndexExecutor = Executors.newSingleThreadExecutor(r -> {
+                final Thread thread = new Thread(() -> {
+                    Process.setThreadPriority(Process.THREAD_PRIORITY_BACKGROUND);
+                    r.run();
+                }, TAG);
+                thread.setDaemon(true);
+                return thread;
+            });
+        }
+        return sIndexExecutor;
+    }
 
-        if (mAlphabet == null) return 0;
+    /**
+     * One pass over the data that computes the position of every index character. Built off the
+     * main thread in async mode and published there atomically, unless superseded meanwhile.
+     */
+    private final class IndexBuild implements Runnable {
+        final int mGeneration = mIndexGeneration;
+        final CharSequence mBuildAlphabet = mAlphabet;
+        final int mFirstIndexedItem = mProfileItemCount + mFavoriteItemCount + mGroupItemCount;
+        final int[] mHintPositions = mBoundaryItems != null ? mCachingValue.clone() : null;
+        final String[] mHintItems = mBoundaryItems;
+        final String[] mHintPrevItems = mBoundaryPrevItems;
+
+        final int[] mPositions = new int[mBuildAlphabet.length()];
+        final String[] mItems = new String[mBuildAlphabet.length()];
+        final String[] mPrevItems = new String[mBuildAlphabet.length()];
+
+        @Override
+        public void run() {
+            if (mGeneration != mIndexGeneration || !isDataToBeIndexedAvailable()) {
+                return;
+            }
+            // Collator is not thread safe, so do not share the one used on the main thread
+            final Collator collator = (Collator) mCollator.clone();
+            final boolean built;
+            onBeginTransaction();
+            try {
+                built = buildIndex(new SparseIntArray(mBuildAlphabet.length()), collator);
+            } finally {
+                onEndTransaction();
+            }
+            if (built) {
+                mMainHandler.post(() -> {
+                    if (mGeneration == mIndexGeneration) {
+                        publish();
+                        mDataSetObservable.notifyChanged();
+                    }
+                });
+            }
+        }
 
-        int totalItems = getItemCount();
-        if (totalItems == 0 || searchString == null || searchString.isEmpty()) return totalItems ;
+        boolean buildIndex(SparseIntArray alphaMap, Collator collator) {
+            final int totalItems = getItemCount();
+            final int lastIndexedItem = totalItems - mDigitItemCount;
+            for (int i = 0; i < mPositions.length; i++) {
+                if (mGeneration != mIndexGeneration) {
+                    return false;
+                }
+                final char indexChar = mBuildAlphabet.charAt(i);
+                int position;
+                if (isHintValid(i, indexChar, totalItems, lastIndexedItem)) {
+                    position = mHintPositions[i];
+                    alphaMap.put(indexChar, position);
+                } else {
+                    position = getPositionForString(String.valueOf(indexChar), mBuildAlphabet,
+                            alphaMap, collator, totalItems);
+                }
+                mPositions[i] = position;
+                mItems[i] = position >= 0 && position < totalItems ? getItemAt(position) : null;
+                mPrevItems[i] = position > mFirstIndexedItem && position <= totalItems
+                        ? getItemAt(position - 1) : null;
+            }
+            return true;
+        }
+
+        /**
+         * A previous position of an alphabet character is still valid if the items around it did
+         * not change, since the data is sorted. This avoids collating when nothing moved.
+         */
+        private boolean isHintValid(int index, char indexChar, int totalItems,
+                int lastIndexedItem) {
+            if (mHintPositions == null || indexChar == FAVORITE_CHAR
+                    || indexChar == GROUP_CHECKER || indexChar == SYMBOL_CHAR
+                    || indexChar == DIGIT_CHAR) {
+                return false;
+            }
+            final int position = mHintPositions[index];
+            if (position < mFirstIndexedItem || position > lastIndexedItem) {
+                return false;
+            }
+            final String item = position < totalItems ? getItemAt(position) : null;
+            final String prevItem = position > mFirstIndexedItem ? getItemAt(position - 1) : null;
+            return TextUtils.equals(item, mHintItems[index])
+                    && TextUtils.equals(prevItem, mHintPrevItems[index]);
+        }
+
+        void publish() {
+            mCachingValue = mPositions;
+            mBoundaryItems = mItems;
+            mBoundaryPrevItems = mPrevItems;
+        }
+    }
+
+    private int getPositionForString(String searchString, CharSequence alphabet,
+            SparseIntArray cacheAlphaMap, Collator collator, int totalItems) {
 
-        SparseIntArray cacheAlphaMap = mAlphaMap;
+        if (alphabet == null) return 0;
+
+        if (totalItems == 0 || searchString == null || searchString.isEmpty()) return totalItems ;
 
         char indexChar = searchString.charAt(0);
         int cachedOffset = cacheAlphaMap.get(indexChar, INVALID_OFFSET);
@@ -273,11 +460,11 @@ public abstract class SeslAbsIndexer extends DataSetObserver {
         } else {
             int offsetFromAlphabets;
             findOffsetInAlphabets: {
-                calculatedOffset = mAlphabet.toString().indexOf(indexChar);
+                calculatedOffset = alphabet.toString().indexOf(indexChar);
                 if (calculatedOffset > 0) {
                     offsetFromAlphabets = calculatedOffset - 1;
-                    if (indexChar > mAlphabet.charAt(offsetFromAlphabets)) {
-                        offsetFromAlphabets = cacheAlphaMap.get(mAlphabet.charAt(offsetFromAlphabets), INVALID_OFFSET);
+                    if (indexChar > alphabet.charAt(offsetFromAlphabets)) {
+                        offsetFromAlphabets = cacheAlphaMap.get(alphabet.charAt(offsetFromAlphabets), INVALID_OFFSET);
                         if (offsetFromAlphabets != INVALID_OFFSET) {
                             offsetFromAlphabets = Math.abs(offsetFromAlphabets);
                             break findOffsetInAlphabets;
@@ -290,10 +477,10 @@ public abstract class SeslAbsIndexer extends DataSetObserver {
             cachedOffset = offsetFromAlphabets;
 
             adjustOffset: {
-                if (calculatedOffset <  mAlphabet.length() - 1) {
+                if (calculatedOffset <  alphabet.length() - 1) {
                     ++calculatedOffset;
-                    if (indexChar < mAlphabet.charAt(calculatedOffset)) {
-                        calculatedOffset = cacheAlphaMap.get(this.mAlphabet.charAt(calculatedOffset), INVALID_OFFSET);
+                    if (indexChar < alphabet.charAt(calculatedOffset)) {
+                        calculatedOffset = cacheAlphaMap.get(alphabet.charAt(calculatedOffset), INVALID_OFFSET);
                         if (calculatedOffset != INVALID_OFFSET) {
                             calculatedOffset = Math.abs(calculatedOffset);
                             break adjustOffset;
@@ -337,7 +524,7 @@ public abstract class SeslAbsIndexer extends DataSetObserver {
                     if (indexChar == 9733 || indexChar == SYMBOL_CHAR || indexChar == GROUP_CHECKER) {
                         areEquivalent = 1;
                     }else{
-                        areEquivalent = compare(item, searchKey);
+                        areEquivalent = collator.compare(item, searchKey);
                     }
 
                     adjustBounds: {
@@ -414,6 +601,10 @@ public abstract class SeslAbsIndexer extends DataSetObserver {
     public void onChanged() {
         super.onChanged();
         mAlphaMap.clear();
+        if (mAsyncIndexing) {
+            mIndexGeneration++;
+            cacheIndexInfo();
+        }
         mDataSetObservable.notifyChanged();
     }
 
@@ -421,6 +612,7 @@ public abstract class SeslAbsIndexer extends DataSetObserver {
     public void onInvalidated() {
         super.onInvalidated();
         mAlphaMap.clear();
+        mIndexGeneration++;
         mDataSetObservable.notifyInvalidated();
     }
 
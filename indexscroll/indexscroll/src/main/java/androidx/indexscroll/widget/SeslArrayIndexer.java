@@ -67,4 +67,29 @@ public class SeslArrayIndexer extends SeslAbsIndexer {
     protected boolean isDataToBeIndexedAvailable() {
         return getItemCount() > 0;
     }
+
+    /**
+     * Builds the index on a background thread, and rebuilds it incrementally whenever the
+     * data set changes. The list must not be modified while the index is being
+     * built.
+     */
+    public void setAsyncIndexingEnabled(boolean enabled) {
+        setAsyncIndexing(enabled);
+    }
+
+    /**
+     * Returns the built index so a later indexer over the same data can skip collating it
+     * again through {@link #restoreIndexState(Bundle)}, or null if it was not built yet.
+     */
+    @Nullable
+    public Bundle saveIndexState() {
+        return super.saveIndexState();
+    }
+
+    /**
+     * Restores an index saved by {@link #saveIndexState()}, before the indexer is set.
+     */
+    public void restoreIndexState(@Nullable Bundle state) {
+        super.restoreIndexState(state);
+    }
 }
@@ -23,6 +23,7 @@ import android.os.Bundle;
 import android.util.Log;
 
 import androidx.annotation.NonNull;
+import androidx.annotation.Nullable;
 import androidx.annotation.RestrictTo;
 
 /*
@@ -134,4 +135,29 @@ public class SeslCursorIndexer extends SeslAbsIndexer {
     public void setMiscItemsCount(int count) {
         setDigitItem(count);
     }
+
+    /**
+     * Builds the index on a background thread, and rebuilds it incrementally whenever the
+     * data set changes. The cursor must not be moved by other threads meanwhile,
+     * so use a cursor that is dedicated to the indexer.
+     */
+    public void setAsyncIndexingEnabled(boolean enabled) {
+        setAsyncIndexing(enabled);
+    }
+
+    /**
+     * Returns the built index so a later indexer over the same data can skip collating it
+     * again through {@link #restoreIndexState(Bundle)}, or null if it was not built yet.
+     */
+    @Nullable
+    public Bundle saveIndexState() {
+        return super.saveIndexState();
+    }
+
+    /**
+     * Restores an index saved by {@link #saveIndexState()}, before the indexer is set.
+     */
+    public void restoreIndexState(@Nullable Bundle state) {
+        super.restoreIndexState(state);
+    }
 }
@@ -29,6 +29,8 @@ import android.graphics.Color;
 import android.graphics.Paint;
 import android.graphics.PorterDuff;
 import android.graphics.Rect;
+import android.graphics.RecordingCanvas;
+import android.graphics.RenderNode;
 import android.graphics.Typeface;
 import android.graphics.drawable.Drawable;
 import android.os.Build;
@@ -49,6 +51,7 @@ import android.widget.FrameLayout;
 import androidx.annotation.IntDef;
 import androidx.annotation.NonNull;
 import androidx.annotation.Nullable;
+import androidx.annotation.RequiresApi;
 import androidx.annotation.RestrictTo;
 import androidx.appcompat.animation.SeslAnimationUtils;
 import androidx.core.content.res.ResourcesCompat;
@@ -212,8 +215,8 @@ public class SeslIndexScrollView extends FrameLayout {
             mIndexScroll.setDimensions(getWidth(), getHeight());
             if (mCurrentIndex != null
                     && !mCurrentIndex.isEmpty() && mIndexScrollPreview != null) {
+                // the preview invalidates itself when it changes
                 mIndexScrollPreview.setLayout(0, 0, getWidth(), getHeight());
-                mIndexScrollPreview.invalidate();
             }
             if (mIndexScroll != null
                     && mIndexScroll.isAlphabetInit()) {
@@ -664,6 +667,24 @@ public class SeslIndexScrollView extends FrameLayout {
 
         private boolean mBgRectParamsSet = false;
         boolean mEnableScrollThumb;
+        // setDimensions() inputs of the last index bar layout
+        private int mLaidOutWidth = -1;
+        private int mLaidOutHeight = -1;
+        private int mLaidOutTopMargin;
+        private int mLaidOutBottomMargin;
+        private String[] mLaidOutAlphabet;
+        private boolean mLaidOutTextMode;
+        // Display list of the alphabet characters, and its inputs when it was recorded
+        private RenderNode mAlphabetRenderNode;
+        private String[] mRecordedAlphabet;
+        private final Rect mRecordedBgRect = new Rect();
+        private int mRecordedCount = -1;
+        private float mRecordedSeparatorHeight;
+        private int mRecordedTextColor;
+        private int mRecordedTextSize;
+        private float mRecordedTop;
+        private boolean mRecordedTextMode;
+        private Paint mGroupCharPaint;
         boolean mEnableTextMode;
         private boolean mIsAlphabetInit = false;
 
@@ -806,6 +827,22 @@ public class SeslIndexScrollView extends FrameLayout {
 
         public void setDimensions(int width, int height) {
             if (mIsAlphabetInit) {
+                if (width == mLaidOutWidth && height == mLaidOutHeight
+                        && mScrollTopMargin == mLaidOutTopMargin
+                        && mScrollBottomMargin == mLaidOutBottomMargin
+                        && mAlphabetArray == mLaidOutAlphabet
+                        && mEnableTextMode == mLaidOutTextMode) {
+                    // called every frame, only the thumb can have moved
+                    setBgRectParams();
+                    return;
+                }
+                mLaidOutWidth = width;
+                mLaidOutHeight = height;
+                mLaidOutTopMargin = mScrollTopMargin;
+                mLaidOutBottomMargin = mScrollBottomMargin;
+                mLaidOutAlphabet = mAlphabetArray;
+                mLaidOutTextMode = mEnableTextMode;
+
                 mWidth = width;
                 mHeight = height
                         - (mScrollTop + mScrollBottom + mScrollTopMargin + mScrollBottomMargin);
@@ -1194,12 +1231,63 @@ public class SeslIndexScrollView extends FrameLayout {
         private void drawAlphabetCharacters(Canvas canvas) {
             mTextPaint.setColor(mTextColorDimmed);
             mTextPaint.setTextSize(mTextSize);
+            if (Build.VERSION.SDK_INT >= 29 && canvas.isHardwareAccelerated()) {
+                drawAlphabetRenderNode(canvas);
+            } else {
+                drawAlphabetCharactersInternal(canvas);
+            }
+        }
+
+        /**
+         * The characters only change with the layout of the index bar, so they are recorded once
+         * and replayed while scrubbing, instead of measuring and drawing every character on each
+         * frame.
+         */
+        @RequiresApi(29)
+        private void drawAlphabetRenderNode(Canvas canvas) {
+            if (mAlphabetRenderNode == null) {
+                mAlphabetRenderNode = new RenderNode("IndexScrollAlphabet");
+            }
+            final float top = mScrollTop + mScrollTopMargin;
+            if (!mAlphabetRenderNode.hasDisplayList()
+                    || mRecordedAlphabet != mIndexBarTextAttrs.alphabetArray
+                    || mRecordedCount != mIndexBarTextAttrs.count
+                    || mRecordedSeparatorHeight != mIndexBarTextAttrs.separatorHeight
+                    || mRecordedTextColor != mTextColorDimmed
+                    || mRecordedTextSize != mTextSize
+                    || mRecordedTop != top
+                    || mRecordedTextMode != mEnableTextMode
+                    || !mRecordedBgRect.equals(mBgRect)) {
+                mAlphabetRenderNode.setPosition(0, 0,
+                        SeslIndexScrollView.this.getWidth(), SeslIndexScrollView.this.getHeight());
+                final RecordingCanvas recordingCanvas = mAlphabetRenderNode.beginRecording();
+                try {
+                    drawAlphabetCharactersInternal(recordingCanvas);
+                } finally {
+                    mAlphabetRenderNode.endRecording();
+                }
+                mRecordedAlphabet = mIndexBarTextAttrs.alphabetArray;
+                mRecordedCount = mIndexBarTextAttrs.count;
+                mRecordedSeparatorHeight = mIndexBarTextAttrs.separatorHeight;
+                mRecordedTextColor = mTextColorDimmed;
+                mRecordedTextSize = mTextSize;
+                mRecordedTop = top;
+                mRecordedTextMode = mEnableTextMode;
+                mRecordedBgRect.set(mBgRect);
+            }
+            canvas.drawRenderNode(mAlphabetRenderNode);
+        }
+
+        private void drawAlphabetCharactersInternal(Canvas canvas) {
             if (mAlphabetArray != null && mIndexBarTextAttrs.count != 0) {
                 for (int index = 0; index < mIndexBarTextAttrs.count; index++) {
                     if (mEnableTextMode) {
                         String text = mIndexBarTextAttrs.alphabetArray[index];
                         if (text.equals(SeslIndexScrollView.GROUP_CHAR)) {
-                            Paint charPaint = new Paint();
+                            if (mGroupCharPaint == null) {
+                                mGroupCharPaint = new Paint();
+                            }
+                            final Paint charPaint = mGroupCharPaint;
                             charPaint.set(mTextPaint);
                             charPaint.setTypeface(mGroupIconFont);
                             charPaint.getTextBounds(text, 0, text.length(), mTextBounds);
@@ -1302,6 +1390,7 @@ public class SeslIndexScrollView extends FrameLayout {
         private Paint mShapePaint;
         private Rect mTextBounds;
         private Paint mTextPaint;
+        private Paint mGroupCharPaint;
 
         boolean mIsOpen = false;
 
@@ -1361,17 +1450,23 @@ public class SeslIndexScrollView extends FrameLayout {
         @Override
         public void setBackgroundColor(int bgColor) {
             mShapePaint.setColor(bgColor);
+            invalidate();
         }
 
         public void setTextColor(int txtColor) {
             mTextPaint.setColor(txtColor);
+            invalidate();
         }
 
         public void open(float y, String text) {
             int textSize = mTextSize;
+            final boolean changed = !mIsOpen || !mPreviewText.equals(text);
+            if (changed || mPreviewCenterY != y) {
+                invalidate();
+            }
             mPreviewCenterY = y;
 
-            if (!mIsOpen || !mPreviewText.equals(text)) {
+            if (changed) {
                 performHapticFeedback(mVibrateIndex);
             }
 
@@ -1423,7 +1518,10 @@ public class SeslIndexScrollView extends FrameLayout {
             if (mIsOpen) {
                 canvas.drawCircle(mPreviewCenterX, mPreviewCenterY, mPreviewRadius, mShapePaint);
                 if (mPreviewText.equals(GROUP_CHAR)) {
-                    Paint charPaint = new Paint();
+                    if (mGroupCharPaint == null) {
+                        mGroupCharPaint = new Paint();
+                    }
+                    final Paint charPaint = mGroupCharPaint;
                     charPaint.set(mTextPaint);
                     charPaint.setTypeface(mGroupIconFont);
                     charPaint.getTextBounds(mPreviewText, 0,
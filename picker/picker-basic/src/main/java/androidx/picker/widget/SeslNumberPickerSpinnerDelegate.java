@@ -136,6 +136,8 @@ class SeslNumberPickerSpinnerDelegate extends SeslNumberPicker.AbsNumberPickerDe
     private static final int SELECTOR_MAX_FLING_VELOCITY_ADJUSTMENT = 4;
     private static final int SELECTOR_MIDDLE_ITEM_INDEX = 2;
     private static final int SELECTOR_WHEEL_ITEM_COUNT = 5;
+    // The number of selector values whose text is kept once the wheel has scrolled past them.
+    private static final int SELECTOR_VALUE_CACHE_SIZE = 100;
 
     private static final int SIZE_UNSPECIFIED = -1;
 
@@ -184,7 +186,12 @@ class SeslNumberPickerSpinnerDelegate extends SeslNumberPicker.AbsNumberPickerDe
     private String mUnitValue;
     private VelocityTracker mVelocityTracker;
     private final Drawable mVirtualButtonFocusedDrawable;
+    // The text drawn for each selector index, including the unit. It is kept while the wheel
+    // scrolls and cleared when the range, the formatter, the displayed values, the unit or the
+    // default locale change. With a Formatter, which may format relative to the current value,
+    // it is also cleared on every value change.
     private final SparseArray<String> mSelectorIndexToStringCache = new SparseArray<>();
+    private Locale mSelectorIndexToStringCacheLocale;
 
     int mBottomSelectionDividerBottom;
     private int mCurrentScrollOffset;
@@ -580,6 +587,7 @@ class SeslNumberPickerSpinnerDelegate extends SeslNumberPicker.AbsNumberPickerDe
         } else {
             mUnitValue = "";
         }
+        mSelectorIndexToStringCache.clear();
     }
 
     @Override
@@ -1473,6 +1481,7 @@ class SeslNumberPickerSpinnerDelegate extends SeslNumberPicker.AbsNumberPickerDe
             return;
         }
         mFormatter = formatter;
+        mSelectorIndexToStringCache.clear();
         initializeSelectorWheelIndices();
         updateInputTextView();
     }
@@ -1652,6 +1661,7 @@ class SeslNumberPickerSpinnerDelegate extends SeslNumberPicker.AbsNumberPickerDe
                 mValue = mMinValue;
             }
             updateWrapSelectorWheel();
+            mSelectorIndexToStringCache.clear();
             initializeSelectorWheelIndices();
             updateInputTextView();
             tryComputeMaxWidth();
@@ -1680,6 +1690,7 @@ class SeslNumberPickerSpinnerDelegate extends SeslNumberPicker.AbsNumberPickerDe
                 mValue = mMaxValue;
             }
             updateWrapSelectorWheel();
+            mSelectorIndexToStringCache.clear();
             initializeSelectorWheelIndices();
             updateInputTextView();
             tryComputeMaxWidth();
@@ -1714,7 +1725,11 @@ class SeslNumberPickerSpinnerDelegate extends SeslNumberPicker.AbsNumberPickerDe
 
     @Override
     public void setDisplayedValues(String[] displayedValues) {
+        mSelectorIndexToStringCache.clear();
         if (mDisplayedValues == displayedValues) {
+            // the values may have been changed in place
+            updateInputTextView();
+            mDelegator.invalidate();
             return;
         }
         mDisplayedValues = displayedValues;
@@ -1985,14 +2000,7 @@ class SeslNumberPickerSpinnerDelegate extends SeslNumberPicker.AbsNumberPickerDe
 
         for(var3 = 0; var3 < var8.length; ++var3) {
             int var9 = var8[var3];
-            String var10 = (String)this.mSelectorIndexToStringCache.get(var9);
-            String var17 = var10;
-            if (!var10.isEmpty()) {
-                var17 = var10;
-                if (!this.mUnitValue.isEmpty()) {
-                    var17 = var10 + this.mUnitValue;
-                }
-            }
+            String var17 = this.ensureCachedScrollSelectorValue(var9);
 
             float var11 = this.mAlpha;
             float var12 = this.mIdleAlpha;
@@ -2105,7 +2113,6 @@ class SeslNumberPickerSpinnerDelegate extends SeslNumberPicker.AbsNumberPickerDe
     }
 
     private void initializeSelectorWheelIndices() {
-        mSelectorIndexToStringCache.clear();
         int[] selectorIndices = mSelectorIndices;
         int current = mIsStartingAnimation ? selectorIndices[2] : getValue();
         for (int i = 0; i < mSelectorIndices.length; i++) {
@@ -2133,6 +2140,9 @@ class SeslNumberPickerSpinnerDelegate extends SeslNumberPicker.AbsNumberPickerDe
             if (notifyChange) {
                 notifyChange(previous, current);
             }
+            if (mFormatter != null) {
+                mSelectorIndexToStringCache.clear();
+            }
             initializeSelectorWheelIndices();
             mDelegator.invalidate();
             if (mAccessibilityManager.isEnabled() && mDelegator.getParent() != null) {
@@ -2275,11 +2285,17 @@ class SeslNumberPickerSpinnerDelegate extends SeslNumberPicker.AbsNumberPickerDe
         ensureCachedScrollSelectorValue(nextScrollSelectorIndex);
     }
 
-    private void ensureCachedScrollSelectorValue(int selectorIndex) {
+    private String ensureCachedScrollSelectorValue(int selectorIndex) {
         SparseArray<String> cache = mSelectorIndexToStringCache;
+        final Locale locale = Locale.getDefault();
+        if (!locale.equals(mSelectorIndexToStringCacheLocale)) {
+            // Numbers are formatted with the default locale.
+            cache.clear();
+            mSelectorIndexToStringCacheLocale = locale;
+        }
         String scrollSelectorValue = cache.get(selectorIndex);
         if (scrollSelectorValue != null) {
-            return;
+            return scrollSelectorValue;
         }
         if (selectorIndex < mMinValue || selectorIndex > mMaxValue) {
             scrollSelectorValue = "";
@@ -2290,8 +2306,35 @@ class SeslNumberPickerSpinnerDelegate extends SeslNumberPicker.AbsNumberPickerDe
             } else {
                 scrollSelectorValue = formatNumber(selectorIndex);
             }
+            if (!scrollSelectorValue.isEmpty() && !TextUtils.isEmpty(mUnitValue)) {
+                scrollSelectorValue = scrollSelectorValue + mUnitValue;
+            }
+        }
+        if (cache.size() >= SELECTOR_VALUE_CACHE_SIZE) {
+            trimSelectorValueCache();
         }
         cache.put(selectorIndex, scrollSelectorValue);
+        return scrollSelectorValue;
+    }
+
+    /**
+     * Drops the cached text of the selector indices the wheel does not show.
+     */
+    private void trimSelectorValueCache() {
+        final SparseArray<String> cache = mSelectorIndexToStringCache;
+        for (int i = cache.size() - 1; i >= 0; i--) {
+            final int selectorIndex = cache.keyAt(i);
+            boolean visible = false;
+            for (int index : mSelectorIndices) {
+                if (index == selectorIndex) {
+                    visible = true;
+                    break;
+                }
+            }
+            if (!visible) {
+                cache.removeAt(i);
+            }
+        }
     }
 
     String formatNumber(int value) {
@@ -28,11 +28,15 @@ import android.content.res.TypedArray;
 import android.graphics.Canvas;
 import android.graphics.Paint;
 import android.graphics.Rect;
+import android.graphics.RecordingCanvas;
+import android.graphics.RenderNode;
+import android.os.Build;
 import android.os.Bundle;
 import android.provider.Settings;
 import android.text.format.DateUtils;
 import android.util.AttributeSet;
 import android.util.Log;
+import android.util.LruCache;
 import android.util.TypedValue;
 import android.view.MotionEvent;
 import android.view.SoundEffectConstants;
@@ -42,6 +46,7 @@ import android.view.accessibility.AccessibilityEvent;
 import android.view.accessibility.AccessibilityNodeInfo;
 
 import androidx.annotation.NonNull;
+import androidx.annotation.RequiresApi;
 import androidx.annotation.RestrictTo;
 import androidx.core.view.ViewCompat;
 import androidx.core.view.accessibility.AccessibilityNodeInfoCompat;
@@ -86,6 +91,16 @@ public class SeslSimpleMonthView extends View {
     private static final int YEAR_WEIGHT = 10000;
     private static final int MONTH_WEIGHT = 100;
 
+    private static final int MONTH_GRID_CACHE_SIZE = 24;
+
+    /**
+     * Day of week of the first day and length of a month, keyed by {@link #getMonthGridKey}.
+     * Adjacent pages of the pager ask for the same months over and over while swiping, and for
+     * lunar months both values come from the reflected converter.
+     */
+    private static final LruCache<Integer, MonthGrid> sMonthGridCache =
+            new LruCache<>(MONTH_GRID_CACHE_SIZE);
+
     private Paint mAbnormalSelectedDayPaint;
     private final Calendar mCalendar = Calendar.getInstance();
     Context mContext;
@@ -99,6 +114,8 @@ public class SeslSimpleMonthView extends View {
     PathClassLoader mPathClassLoader = null;
     Object mSolarLunarConverter;
     private Calendar mTempDate = Calendar.getInstance();
+    private RenderNode mDaysRenderNode;
+    private boolean mDaysDisplayListDirty = true;
     private final MonthViewTouchHelper mTouchHelper;
     int mWeekHeight;
     private int mWeekStart = DEFAULT_WEEK_START;
@@ -246,6 +263,7 @@ public class SeslSimpleMonthView extends View {
                 mDayColorSet[index] = mNormalTextColor;
             }
         }
+        mDaysDisplayListDirty = true;
     }
 
     @Override
@@ -290,14 +308,11 @@ public class SeslSimpleMonthView extends View {
                         onDeactivatedDayClick(nextYear,
                                 nextMonth, day - mNumCells,
                                 false);
-                    } else {
-                        Calendar calendar = Calendar.getInstance();
-                        calendar.clear();
-                        calendar.set(mYear, mMonth, mNumCells);
-                        calendar.add(Calendar.DAY_OF_MONTH, day - mNumCells);
-                        onDeactivatedDayClick(calendar.get(Calendar.YEAR),
-                                calendar.get(Calendar.MONTH), calendar.get(Calendar.DAY_OF_MONTH),
+                    } else if (mMonth == Calendar.DECEMBER) {
+                        onDeactivatedDayClick(mYear + 1, Calendar.JANUARY, day - mNumCells,
                                 false);
+                    } else {
+                        onDeactivatedDayClick(mYear, mMonth + 1, day - mNumCells, false);
                     }
                 } else {
                     onDayClick(mYear, mMonth, day);
@@ -313,14 +328,11 @@ public class SeslSimpleMonthView extends View {
                     onDeactivatedDayClick(prevYear, prevMonth,
                             getDaysInMonthLunar(prevMonth, prevYear, mIsPrevMonthLeap) + day,
                             true);
+                } else if (mMonth == Calendar.JANUARY) {
+                    onDeactivatedDayClick(mYear - 1, Calendar.DECEMBER,
+                            getDaysInPrevMonth() + day, true);
                 } else {
-                    Calendar calendar = Calendar.getInstance();
-                    calendar.clear();
-                    calendar.set(mYear, mMonth, 1);
-                    calendar.add(Calendar.DAY_OF_MONTH, day - 1);
-                    onDeactivatedDayClick(calendar.get(Calendar.YEAR),
-                            calendar.get(Calendar.MONTH), calendar.get(Calendar.DAY_OF_MONTH),
-                            true);
+                    onDeactivatedDayClick(mYear, mMonth - 1, getDaysInPrevMonth() + day, true);
                 }
             }
         }
@@ -349,11 +361,44 @@ public class SeslSimpleMonthView extends View {
         mDayNumberPaint.setFakeBoldText(false);
         mHcfEnabledDayNumberPaint = new Paint(mDayNumberPaint);
         mHcfEnabledDayNumberPaint.setTypeface(getBoldFontTypeface());
+        mDaysDisplayListDirty = true;
     }
 
     @Override
     protected void onDraw(@NonNull Canvas canvas) {
-        drawDays(canvas);
+        final boolean hcfEnabled = isHighContrastFontEnabled();
+        if (mIsHcfEnabled != hcfEnabled) {
+            mIsHcfEnabled = hcfEnabled;
+            mDaysDisplayListDirty = true;
+        }
+        if (Build.VERSION.SDK_INT >= 29 && canvas.isHardwareAccelerated()) {
+            drawDaysRenderNode(canvas);
+        } else {
+            drawDays(canvas);
+        }
+    }
+
+    /**
+     * The days only change with the month params, the colors and the size of the view, so they
+     * are recorded once and replayed on later frames, e.g. while the pager scrolls.
+     */
+    @RequiresApi(29)
+    private void drawDaysRenderNode(Canvas canvas) {
+        if (mDaysRenderNode == null) {
+            mDaysRenderNode = new RenderNode("SimpleMonthViewDays");
+            mDaysRenderNode.setClipToBounds(false);
+        }
+        if (mDaysDisplayListDirty || !mDaysRenderNode.hasDisplayList()) {
+            mDaysRenderNode.setPosition(0, 0, getWidth(), getHeight());
+            final RecordingCanvas recordingCanvas = mDaysRenderNode.beginRecording();
+            try {
+                drawDays(recordingCanvas);
+            } finally {
+                mDaysRenderNode.endRecording();
+            }
+            mDaysDisplayListDirty = false;
+        }
+        canvas.drawRenderNode(mDaysRenderNode);
     }
 
     void setMonthParams(int selectedDay, int month, int year, int weekStart,
@@ -381,25 +426,10 @@ public class SeslSimpleMonthView extends View {
         mMinDate = minDate;
         mMaxDate = maxDate;
 
-        if (mIsLunar) {
-            if (mSolarLunarConverter != null) {
-                SeslSolarLunarConverterReflector
-                        .convertLunarToSolar(mPathClassLoader,
-                                mSolarLunarConverter, mYear, mMonth, 1, mIsLeapMonth);
-                final int lunarYear = SeslSolarLunarConverterReflector
-                        .getYear(mPathClassLoader, mSolarLunarConverter);
-                final int lunarMonth = SeslSolarLunarConverterReflector.
-                        getMonth(mPathClassLoader, mSolarLunarConverter);
-                final int lunarDay = SeslSolarLunarConverterReflector
-                        .getDay(mPathClassLoader, mSolarLunarConverter);
-                mDayOfWeekStart = SeslSolarLunarConverterReflector
-                        .getWeekday(mPathClassLoader, mSolarLunarConverter, lunarYear,
-                                lunarMonth, lunarDay) + 1;
-                mNumCells = getDaysInMonthLunar(mMonth, mYear, mIsLeapMonth);
-            }
-        } else {
-            mDayOfWeekStart = mCalendar.get(Calendar.DAY_OF_WEEK);
-            mNumCells = getDaysInMonth(mMonth, mYear);
+        final MonthGrid grid = obtainMonthGrid();
+        if (grid != null) {
+            mDayOfWeekStart = grid.mDayOfWeekStart;
+            mNumCells = grid.mNumCells;
         }
 
         if (isValidDayOfWeek(weekStart)) {
@@ -433,6 +463,70 @@ public class SeslSimpleMonthView extends View {
         mEndMonth = endMonth;
         mEndDay = endDay;
         mIsLeapEndMonth = isLeapEndMonth;
+        mDaysDisplayListDirty = true;
+    }
+
+    /**
+     * @return the grid of the current month from {@link #sMonthGridCache}, computing it on a
+     * miss, or null if the month is lunar and there is no converter
+     */
+    private MonthGrid obtainMonthGrid() {
+        if (mIsLunar && mSolarLunarConverter == null) {
+            return null;
+        }
+        final int key = getMonthGridKey(mIsLunar, mYear, mMonth, mIsLunar && mIsLeapMonth);
+        MonthGrid grid = sMonthGridCache.get(key);
+        if (grid == null) {
+            if (mIsLunar) {
+                SeslSolarLunarConverterReflector
+                        .convertLunarToSolar(mPathClassLoader,
+                                mSolarLunarConverter, mYear, mMonth, 1, mIsLeapMonth);
+                final int lunarYear = SeslSolarLunarConverterReflector
+                        .getYear(mPathClassLoader, mSolarLunarConverter);
+                final int lunarMonth = SeslSolarLunarConverterReflector.
+                        getMonth(mPathClassLoader, mSolarLunarConverter);
+                final int lunarDay = SeslSolarLunarConverterReflector
+                        .getDay(mPathClassLoader, mSolarLunarConverter);
+                grid = new MonthGrid(SeslSolarLunarConverterReflector
+                        .getWeekday(mPathClassLoader, mSolarLunarConverter, lunarYear,
+                                lunarMonth, lunarDay) + 1,
+                        getDaysInMonthLunar(mMonth, mYear, mIsLeapMonth));
+            } else {
+                grid = new MonthGrid(mCalendar.get(Calendar.DAY_OF_WEEK),
+                        getDaysInMonth(mMonth, mYear));
+            }
+            sMonthGridCache.put(key, grid);
+        }
+        return grid;
+    }
+
+    private static int getMonthGridKey(boolean isLunar, int year, int month, boolean isLeapMonth) {
+        return ((year * YEAR_WEIGHT + month * MONTH_WEIGHT) << 2)
+                | (isLunar ? 2 : 0) | (isLeapMonth ? 1 : 0);
+    }
+
+    /**
+     * @return the length of the solar month before the current one
+     */
+    private int getDaysInPrevMonth() {
+        return mMonth == Calendar.JANUARY
+                ? getDaysInMonth(Calendar.DECEMBER, mYear - 1)
+                : getDaysInMonth(mMonth - 1, mYear);
+    }
+
+    /**
+     * Layout of one month that only depends on the year, the month and, for lunar months,
+     * whether it is the leap month. The first day of week is applied on top of it by
+     * {@link #findDayOffset()}.
+     */
+    private static final class MonthGrid {
+        final int mDayOfWeekStart;
+        final int mNumCells;
+
+        MonthGrid(int dayOfWeekStart, int numCells) {
+            mDayOfWeekStart = dayOfWeekStart;
+            mNumCells = numCells;
+        }
     }
 
     int getDaysInMonthLunar(int month, int year, boolean isLeapMonth) {
@@ -473,7 +567,11 @@ public class SeslSimpleMonthView extends View {
 
     @Override
     protected void onMeasure(int widthMeasureSpec, int heightMeasureSpec) {
+        final int calendarWidth = mCalendarWidth;
         final int newWidthMeasureSpec = makeMeasureSpec(widthMeasureSpec, mCalendarWidth);
+        if (mCalendarWidth != calendarWidth) {
+            mDaysDisplayListDirty = true;
+        }
         super.onMeasure(newWidthMeasureSpec, heightMeasureSpec);
     }
 
@@ -519,6 +617,7 @@ public class SeslSimpleMonthView extends View {
     @Override
     protected void onSizeChanged(int w, int h, int oldw, int oldh) {
         mTouchHelper.invalidateRoot();
+        mDaysDisplayListDirty = true;
     }
 
     // TODO rework this method
@@ -618,7 +717,6 @@ public class SeslSimpleMonthView extends View {
             var17 = -1;
         }
 
-        this.mIsHcfEnabled = this.isHighContrastFontEnabled();
         var18 = 0;
         byte var21 = 1;
         var16 = var4;
@@ -862,11 +960,7 @@ public class SeslSimpleMonthView extends View {
         }
 
         if (var4 > 0 && !this.mIsFirstMonth) {
-            Calendar var35 = Calendar.getInstance();
-            var35.clear();
-            var35.set(this.mYear, this.mMonth, 1);
-            var35.add(5, -var4);
-            var11 = var35.get(5);
+            var11 = this.getDaysInPrevMonth() - var4 + 1;
             if (this.mIsLunar) {
                 var18 = this.mYear;
                 var2 = this.mMonth - (mIsLeapMonth ? 0 : 1);
@@ -934,9 +1028,6 @@ public class SeslSimpleMonthView extends View {
 
                     this.mTempDate.clear();
                     this.mTempDate.set(var2, var18, var17);
-                    var35 = Calendar.getInstance();
-                    var35.clear();
-                    var35.set(this.mMinDate.get(1), this.mMinDate.get(2), this.mMinDate.get(5));
                     if (this.mTempDate.before(this.mMinDate)) {
                         this.mDayNumberPaint.setAlpha(this.mDayNumberDisabledAlpha);
                     }
@@ -1066,18 +1157,12 @@ public class SeslSimpleMonthView extends View {
 
     void onDeactivatedDayClick(int year, int month, int day, boolean isPrevMonth) {
         if (!mIsLunar) {
-            mTempDate.clear();
-            mTempDate.set(year, month, day);
+            final int dateKey = year * YEAR_WEIGHT + month * MONTH_WEIGHT + day;
             if (isPrevMonth) {
-                Calendar minDate = Calendar.getInstance();
-                minDate.clear();
-                minDate.set(mMinDate.get(Calendar.YEAR),
-                        mMinDate.get(Calendar.MONTH),
-                        mMinDate.get(Calendar.DAY_OF_MONTH));
-                if (mTempDate.before(minDate)) {
+                if (dateKey < getDateKey(mMinDate)) {
                     return;
                 }
-            } else if (mTempDate.after(mMaxDate)) {
+            } else if (dateKey > getDateKey(mMaxDate)) {
                 return;
             }
         }
@@ -1089,6 +1174,11 @@ public class SeslSimpleMonthView extends View {
         mTouchHelper.sendEventForVirtualView(day, AccessibilityEvent.TYPE_VIEW_CLICKED);
     }
 
+    private static int getDateKey(Calendar date) {
+        return date.get(Calendar.YEAR) * YEAR_WEIGHT + date.get(Calendar.MONTH) * MONTH_WEIGHT
+                + date.get(Calendar.DAY_OF_MONTH);
+    }
+
     void clearAccessibilityFocus() {
         mTouchHelper.clearFocusedVirtualView();
     }
@@ -1192,15 +1282,12 @@ public class SeslSimpleMonthView extends View {
                         final int prevMonthLastDay = getDaysInMonthLunar(month, mYear, mIsLeapMonth);
                         onDeactivatedDayClick(mYear, month, prevMonthLastDay + virtualViewId, true);
                     }
+                } else if (mMonth == Calendar.JANUARY) {
+                    onDeactivatedDayClick(mYear - 1, Calendar.DECEMBER,
+                            getDaysInPrevMonth() + virtualViewId, true);
                 } else {
-                    Calendar calendar = Calendar.getInstance();
-                    calendar.clear();
-                    calendar.set(mYear, mMonth, 1);
-                    calendar.add(Calendar.DAY_OF_MONTH, virtualViewId - 1);
-                    onDeactivatedDayClick(calendar.get(Calendar.YEAR),
-                            calendar.get(Calendar.MONTH),
-                            calendar.get(Calendar.DAY_OF_MONTH),
-                            true);
+                    onDeactivatedDayClick(mYear, mMonth - 1,
+                            getDaysInPrevMonth() + virtualViewId, true);
                 }
             } else if (virtualViewId <= mNumCells) {
                 onDayClick(mYear, mMonth, virtualViewId);
@@ -1211,15 +1298,11 @@ public class SeslSimpleMonthView extends View {
                 } else {
                     onDeactivatedDayClick(mYear, month, virtualViewId - mNumCells, false);
                 }
-            } else {
-                Calendar calendar = Calendar.getInstance();
-                calendar.clear();
-                calendar.set(mYear, mMonth, mNumCells);
-                calendar.add(Calendar.DAY_OF_MONTH, virtualViewId - mNumCells);
-                onDeactivatedDayClick(calendar.get(Calendar.YEAR),
-                        calendar.get(Calendar.MONTH),
-                        calendar.get(Calendar.DAY_OF_MONTH),
+            } else if (mMonth == Calendar.DECEMBER) {
+                onDeactivatedDayClick(mYear + 1, Calendar.JANUARY, virtualViewId - mNumCells,
                         false);
+            } else {
+                onDeactivatedDayClick(mYear, mMonth + 1, virtualViewId - mNumCells, false);
             }
 
             return true;
@@ -1280,11 +1363,10 @@ public class SeslSimpleMonthView extends View {
             final int lunarDay = SeslSolarLunarConverterReflector
                     .getDay(mPathClassLoader, mSolarLunarConverter);
 
-            Calendar calendar = Calendar.getInstance();
-            calendar.set(lunarYear, lunarMonth, lunarDay);
+            mTempCalendar.set(lunarYear, lunarMonth, lunarDay);
 
             return SeslLunarDateUtilsReflector
-                    .buildLunarDateString(mPathClassLoader, calendar, getContext());
+                    .buildLunarDateString(mPathClassLoader, mTempCalendar, getContext());
         }
     }
 
@@ -1305,6 +1387,7 @@ public class SeslSimpleMonthView extends View {
         mStartMonth = startDate.get(Calendar.MONTH);
         mStartDay = startDate.get(Calendar.DAY_OF_MONTH);
         mIsLeapStartMonth = isLeapMonth;
+        mDaysDisplayListDirty = true;
     }
 
     void setEndDate(Calendar endDate, int isLeapMonth) {
@@ -1312,6 +1395,7 @@ public class SeslSimpleMonthView extends View {
         mEndMonth = endDate.get(Calendar.MONTH);
         mEndDay = endDate.get(Calendar.DAY_OF_MONTH);
         mIsLeapEndMonth = isLeapMonth;
+        mDaysDisplayListDirty = true;
     }
 
     private boolean isRTL() {
@@ -1334,22 +1418,27 @@ public class SeslSimpleMonthView extends View {
             mPathClassLoader = pathClassLoader;
             mSolarLunarConverter = SeslFeatureReflector.getSolarLunarConverter(pathClassLoader);
         }
+        mDaysDisplayListDirty = true;
     }
 
     void setFirstMonth() {
         mIsFirstMonth = true;
+        mDaysDisplayListDirty = true;
     }
 
     void setLastMonth() {
         mIsLastMonth = true;
+        mDaysDisplayListDirty = true;
     }
 
     void setPrevMonthLeap() {
         mIsPrevMonthLeap = true;
+        mDaysDisplayListDirty = true;
     }
 
     void setNextMonthLeap() {
         mIsNextMonthLeap = true;
+        mDaysDisplayListDirty = true;
     }
 
     private boolean isHighContrastFontEnabled() {
@@ -0,0 +1,53 @@
+/*
+ * Copyright 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package androidx.preference;
+
+import android.os.Bundle;
+
+import androidx.annotation.Nullable;
+import androidx.appcompat.app.AppCompatActivity;
+import androidx.preference.test.R;
+
+/**
+ * Shows a {@link PreferenceFragmentCompat} whose hierarchy is inflated with
+ * {@link PreferenceFragmentCompat#setPreferencesFromResourceAsync(int, String)}.
+ */
+public class AsyncPreferenceTestActivity extends AppCompatActivity {
+
+    @Override
+    protected void onCreate(@Nullable Bundle savedInstanceState) {
+        super.onCreate(savedInstanceState);
+        if (savedInstanceState == null) {
+            getSupportFragmentManager()
+                    .beginTransaction()
+                    .replace(android.R.id.content, new AsyncFragment())
+                    .commitNow();
+        }
+    }
+
+    AsyncFragment getFragment() {
+        return (AsyncFragment) getSupportFragmentManager().findFragmentById(android.R.id.content);
+    }
+
+    public static class AsyncFragment extends PreferenceFragmentCompat {
+        @Override
+        public void onCreatePreferences(@Nullable Bundle savedInstanceState,
+                @Nullable String rootKey) {
+            setPreferencesFromResourceAsync(R.xml.test_async_preferences, rootKey);
+        }
+    }
+}
@@ -0,0 +1,124 @@
+/*
+ * Copyright 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package androidx.preference;
+
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertFalse;
+import static org.junit.Assert.assertNotNull;
+import static org.junit.Assert.assertSame;
+import static org.junit.Assert.assertTrue;
+
+import android.os.SystemClock;
+
+import androidx.test.core.app.ActivityScenario;
+import androidx.test.ext.junit.runners.AndroidJUnit4;
+import androidx.test.filters.LargeTest;
+import androidx.test.platform.app.InstrumentationRegistry;
+
+import org.junit.After;
+import org.junit.Before;
+import org.junit.Test;
+import org.junit.runner.RunWith;
+
+import java.util.HashSet;
+import java.util.Set;
+
+@RunWith(AndroidJUnit4.class)
+@LargeTest
+public class PreferenceFragmentCompatAsyncTest {
+    private static final long TIMEOUT_MS = 5000;
+
+    private ActivityScenario<AsyncPreferenceTestActivity> mScenario;
+
+    @Before
+    public void setUp() {
+        mScenario = ActivityScenario.launch(AsyncPreferenceTestActivity.class);
+    }
+
+    @After
+    public void tearDown() {
+        mScenario.close();
+    }
+
+    @Test
+    public void asyncHierarchyIsAttachedOnTheMainThread() {
+        waitForPreferenceScreen();
+        mScenario.onActivity(activity -> {
+            final PreferenceFragmentCompat fragment = activity.getFragment();
+            final PreferenceScreen screen = fragment.getPreferenceScreen();
+            final Set<Long> ids = new HashSet<>();
+            assertAttached(screen, fragment.getPreferenceManager(), ids);
+            assertEquals(5, ids.size());
+
+            final AsyncStatePreference preference = fragment.findPreference("state");
+            assertNotNull(preference);
+            assertTrue(preference.mAttachedOnMainThread);
+        });
+    }
+
+    @Test
+    public void hierarchyStateIsRestoredOntoAsyncHierarchy() {
+        waitForPreferenceScreen();
+        mScenario.onActivity(activity -> {
+            final AsyncStatePreference preference = activity.getFragment().findPreference("state");
+            preference.mValue = 42;
+        });
+
+        mScenario.recreate();
+        waitForPreferenceScreen();
+        mScenario.onActivity(activity -> {
+            final AsyncStatePreference preference = activity.getFragment().findPreference("state");
+            assertEquals(42, preference.mValue);
+        });
+    }
+
+    @Test(expected = NullPointerException.class)
+    public void addingToDetachedGroupOutsideAsyncInflationFails() {
+        mScenario.onActivity(activity -> {
+            final PreferenceCategory group = new PreferenceCategory(activity);
+            group.addPreference(new Preference(activity));
+        });
+    }
+
+    private static void assertAttached(Preference preference, PreferenceManager manager,
+            Set<Long> ids) {
+        assertSame(manager, preference.getPreferenceManager());
+        assertTrue("duplicate id " + preference.getId(), ids.add(preference.getId()));
+        if (preference instanceof PreferenceGroup) {
+            final PreferenceGroup group = (PreferenceGroup) preference;
+            assertFalse(group.mInflatingDetached);
+            for (int i = 0; i < group.getPreferenceCount(); i++) {
+                assertAttached(group.getPreference(i), manager, ids);
+            }
+        }
+    }
+
+    private void waitForPreferenceScreen() {
+        final long deadline = SystemClock.uptimeMillis() + TIMEOUT_MS;
+        final boolean[] ready = new boolean[1];
+        while (SystemClock.uptimeMillis() < deadline) {
+            mScenario.onActivity(activity ->
+                    ready[0] = activity.getFragment().getPreferenceScreen() != null);
+            if (ready[0]) {
+                InstrumentationRegistry.getInstrumentation().waitForIdleSync();
+                return;
+            }
+            SystemClock.sleep(50);
+        }
+        throw new AssertionError("The preference screen was not inflated in time");
+    }
+}
@@ -195,5 +195,16 @@ public abstract class PreferenceDataStore {
     public boolean getBoolean(@NonNull String key, boolean defValue) {
         return defValue;
     }
-}
 
+    /**
+     * Called when the {@link PreferenceManager} using this data store flushes its pending writes,
+     * for example when {@link PreferenceFragmentCompat} is stopped. Data stores that buffer
+     * writes should store them now.
+     *
+     * <p>By default, this does nothing.
+     *
+     * @see PreferenceManager#flushPendingWrites()
+     */
+    public void flush() {
+    }
+}
@@ -127,6 +127,11 @@ public abstract class PreferenceFragmentCompat extends Fragment implements
     RecyclerView mList;
     private boolean mHavePrefs;
     private boolean mInitDone;
+    @SuppressWarnings("WeakerAccess") /* synthetic access */
+    int mPreferenceScreenGeneration;
+    // Saved hierarchy state waiting for a screen set by setPreferencesFromResourceAsync
+    @SuppressWarnings("WeakerAccess") /* synthetic access */
+    Bundle mPendingHierarchyState;
     private int mLayoutResId = R.layout.preference_list_fragment;
     private Runnable mSelectPreferenceRunnable;
     private final Handler mHandler = new Handler(Looper.getMainLooper()) {
@@ -347,6 +352,8 @@ public abstract class PreferenceFragmentCompat extends Fragment implements
                 final PreferenceScreen preferenceScreen = getPreferenceScreen();
                 if (preferenceScreen != null) {
                     preferenceScreen.restoreHierarchyState(container);
+                } else {
+                    mPendingHierarchyState = container;
                 }
             }
         }
@@ -374,6 +381,7 @@ public abstract class PreferenceFragmentCompat extends Fragment implements
         super.onStop();
         mPreferenceManager.setOnPreferenceTreeClickListener(null);
         mPreferenceManager.setOnDisplayPreferenceDialogListener(null);
+        mPreferenceManager.flushPendingWrites();
     }
 
     @Override
@@ -401,6 +409,9 @@ public abstract class PreferenceFragmentCompat extends Fragment implements
             Bundle container = new Bundle();
             preferenceScreen.saveHierarchyState(container);
             outState.putBundle(PREFERENCES_TAG, container);
+        } else if (mPendingHierarchyState != null) {
+            // still inflating, hand the restored state on
+            outState.putBundle(PREFERENCES_TAG, mPendingHierarchyState);
         }
     }
 
@@ -434,6 +445,8 @@ public abstract class PreferenceFragmentCompat extends Fragment implements
      */
     public void setPreferenceScreen(
             @SuppressLint("UnknownNullness") PreferenceScreen preferenceScreen) {
+        mPreferenceScreenGeneration++;
+        mPendingHierarchyState = null;
         if (preferenceScreen != null && mPreferenceManager.setPreferences(preferenceScreen)) {
             onUnbindPreferences();
             mHavePrefs = true;
@@ -485,6 +498,57 @@ public abstract class PreferenceFragmentCompat extends Fragment implements
         setPreferenceScreen((PreferenceScreen) root);
     }
 
+    /**
+     * Like {@link #setPreferencesFromResource(int, String)}, but inflates the XML resource on a
+     * background thread and sets the resulting hierarchy once it is ready, so that large
+     * hierarchies do not hold up the first frame of this fragment. The list stays empty until
+     * then.
+     *
+     * <p>The result is dropped if another hierarchy is set in the meantime, or if this fragment
+     * is no longer attached. The hierarchy state saved by {@link #onSaveInstanceState(Bundle)}
+     * is restored onto the new hierarchy once it is set. Do not change the
+     * {@link PreferenceManager}'s shared preferences configuration while the inflation is in
+     * flight.
+     *
+     * @param preferencesResId The XML resource ID to inflate
+     * @param key              The preference key of the {@link PreferenceScreen} to use as the
+     *                         root of the preference hierarchy, or {@code null} to use the root
+     *                         {@link PreferenceScreen}.
+     */
+    public void setPreferencesFromResourceAsync(@XmlRes int preferencesResId,
+            @Nullable final String key) {
+        requirePreferenceManager();
+
+        final PreferenceManager preferenceManager = mPreferenceManager;
+        final int generation = mPreferenceScreenGeneration;
+        preferenceManager.inflateFromResourceAsync(requireContext(), preferencesResId, null,
+                new PreferenceManager.OnPreferenceScreenInflatedListener() {
+                    @Override
+                    public void onPreferenceScreenInflated(@NonNull PreferenceScreen xmlRoot) {
+                        if (generation != mPreferenceScreenGeneration
+                                || preferenceManager != getPreferenceManager()
+                                || getContext() == null) {
+                            return;
+                        }
+                        final Preference root;
+                        if (key != null) {
+                            root = xmlRoot.findPreference(key);
+                            if (!(root instanceof PreferenceScreen)) {
+                                throw new IllegalArgumentException("Preference object with key "
+                                        + key + " is not a PreferenceScreen");
+                            }
+                        } else {
+                            root = xmlRoot;
+                        }
+                        final Bundle pendingState = mPendingHierarchyState;
+                        setPreferenceScreen((PreferenceScreen) root);
+                        if (pendingState != null && getPreferenceScreen() == root) {
+                            root.restoreHierarchyState(pendingState);
+                        }
+                    }
+                });
+    }
+
     /**
      * {@inheritDoc}
      */
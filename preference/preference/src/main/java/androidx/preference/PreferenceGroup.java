@@ -69,6 +69,14 @@ public abstract class PreferenceGroup extends Preference {
     private boolean mAttachedToHierarchy = false;
     private int mInitialExpandedChildrenCount = Integer.MAX_VALUE;
     private OnExpandButtonClickListener mOnExpandButtonClickListener = null;
+    //Sesl
+    /**
+     * Set while {@link PreferenceManager#inflateFromResourceAsync} builds this group off the main
+     * thread, before it has a {@link PreferenceManager}, and cleared once the hierarchy is
+     * attached. Only then may preferences be added without a manager.
+     */
+    boolean mInflatingDetached = false;
+    //sesl
 
     private final Runnable mClearRecycleCacheRunnable = new Runnable() {
         @Override
@@ -242,6 +250,17 @@ public abstract class PreferenceGroup extends Preference {
         }
 
         final PreferenceManager preferenceManager = getPreferenceManager();
+        //Sesl
+        if (preferenceManager == null && mInflatingDetached) {
+            // A detached hierarchy inflated off the main thread, which
+            // PreferenceManager#inflateFromResourceAsync attaches as a whole later.
+            if (preference instanceof PreferenceGroup) {
+                ((PreferenceGroup) preference).mInflatingDetached = true;
+            }
+            preference.assignParent(this);
+            return true;
+        }
+        //sesl
         final String key = preference.getKey();
         final long id;
         if (key != null && mIdRecycleCache.containsKey(key)) {
@@ -34,7 +34,10 @@ import androidx.recyclerview.widget.DiffUtil;
 import androidx.recyclerview.widget.RecyclerView;
 
 import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.IdentityHashMap;
 import java.util.List;
+import java.util.Map;
 
 /**
  * <p><b>SESL variant</b></p><br>
@@ -88,12 +91,39 @@ public class PreferenceGroupAdapter extends RecyclerView.Adapter<PreferenceViewH
      */
     private final List<PreferenceResourceDescriptor> mPreferenceResourceDescriptors;
 
+    /**
+     * Position of each {@link Preference} in {@link #mPreferences}. Together with
+     * {@link #mSubtreeEnd} this lets visibility changes be applied to
+     * {@link #mVisiblePreferences} without flattening the hierarchy again.
+     */
+    private final Map<Preference, Integer> mFlatIndex = new IdentityHashMap<>();
+
+    /**
+     * For the {@link Preference} at each position of {@link #mPreferences}, the position right
+     * after its flattened subtree.
+     */
+    private int[] mSubtreeEnd = new int[0];
+
+    /**
+     * Whether the hierarchy contains a group collapsing children behind an {@link ExpandButton},
+     * in which case visibility changes go through {@link #updatePreferences()}.
+     */
+    private boolean mHasExpandableGroup;
+
+    /** Preferences whose visibility changed since the last sync. */
+    private final List<Preference> mPendingVisibilityChanges = new ArrayList<>();
+
+    /** Whether the hierarchy changed since the last sync, which needs a full update. */
+    private boolean mHierarchyChangePending;
+
     private final Handler mHandler;
 
     private final Runnable mSyncRunnable = new Runnable() {
         @Override
         public void run() {
-            updatePreferences();
+            if (mHierarchyChangePending || !applyVisibilityChanges()) {
+                updatePreferences();
+            }
         }
     };
 
@@ -125,6 +155,8 @@ public class PreferenceGroupAdapter extends RecyclerView.Adapter<PreferenceViewH
      */
     @SuppressWarnings("WeakerAccess") /* synthetic access */
     void updatePreferences() {
+        mHierarchyChangePending = false;
+        mPendingVisibilityChanges.clear();
         for (final Preference preference : mPreferences) {
             // Clear out the listeners in anticipation of some items being removed. This listener
             // will be set again on any remaining preferences when we flatten the group.
@@ -133,6 +165,8 @@ public class PreferenceGroupAdapter extends RecyclerView.Adapter<PreferenceViewH
         // Attempt to reuse the current array size when creating the new array for efficiency
         final int size = mPreferences.size();
         mPreferences = new ArrayList<>(size);
+        mFlatIndex.clear();
+        mHasExpandableGroup = isGroupExpandable(mPreferenceGroup);
         flattenPreferenceGroup(mPreferences, mPreferenceGroup);
 
         final List<Preference> oldVisibleList = mVisiblePreferences;
@@ -223,7 +257,9 @@ public class PreferenceGroupAdapter extends RecyclerView.Adapter<PreferenceViewH
             }
             //sesl
 
+            final int flatIndex = preferences.size();
             preferences.add(preference);
+            mFlatIndex.put(preference, flatIndex);
 
             final PreferenceResourceDescriptor descriptor = new PreferenceResourceDescriptor(
                     preference);
@@ -234,15 +270,138 @@ public class PreferenceGroupAdapter extends RecyclerView.Adapter<PreferenceViewH
             if (preference instanceof PreferenceGroup) {
                 final PreferenceGroup nestedGroup = (PreferenceGroup) preference;
                 if (nestedGroup.isOnSameScreenAsChildren()) {
+                    mHasExpandableGroup |= isGroupExpandable(nestedGroup);
                     mNextGroupPreference = mNextPreference;//sesl
                     flattenPreferenceGroup(preferences, nestedGroup);
                 }
             }
+            setSubtreeEnd(flatIndex, preferences.size());
 
             preference.setOnPreferenceChangeInternalListener(this);
         }
     }
 
+    private void setSubtreeEnd(int flatIndex, int end) {
+        if (flatIndex >= mSubtreeEnd.length) {
+            mSubtreeEnd = Arrays.copyOf(mSubtreeEnd,
+                    Math.max(flatIndex + 1, mSubtreeEnd.length * 2));
+        }
+        mSubtreeEnd[flatIndex] = end;
+    }
+
+    /**
+     * Applies the pending visibility changes to {@link #mVisiblePreferences} and the
+     * accessibility position table in place, notifying the exact ranges that appeared or
+     * disappeared.
+     *
+     * @return {@code false} if the changes cannot be applied incrementally and a full
+     * {@link #updatePreferences()} is needed
+     */
+    @SuppressWarnings("WeakerAccess") /* synthetic access */
+    boolean applyVisibilityChanges() {
+        if (mHasExpandableGroup) {
+            return false;
+        }
+        for (Preference preference : mPendingVisibilityChanges) {
+            if (!mFlatIndex.containsKey(preference)) {
+                return false;
+            }
+        }
+
+        final PreferenceManager preferenceManager = mPreferenceGroup.getPreferenceManager();
+        final boolean notifyRanges = preferenceManager != null
+                && preferenceManager.getPreferenceComparisonCallback() != null;
+        boolean changed = false;
+        for (Preference preference : mPendingVisibilityChanges) {
+            changed |= applyVisibilityChange(mFlatIndex.get(preference), notifyRanges);
+        }
+        mPendingVisibilityChanges.clear();
+
+        if (changed && !notifyRanges) {
+            // same as the full update without a comparison callback
+            notifyDataSetChanged();
+        }
+        return true;
+    }
+
+    /**
+     * Brings the rows of the subtree flattened at {@code start} in line with the current
+     * visibility of its preferences and their ancestors.
+     */
+    private boolean applyVisibilityChange(int start, boolean notifyRanges) {
+        final int end = mSubtreeEnd[start];
+        int row = 0;
+        while (row < mVisiblePreferences.size()
+                && mFlatIndex.get(mVisiblePreferences.get(row)) < start) {
+            row++;
+        }
+
+        boolean changed = false;
+        boolean pendingInsert = false;
+        int pendingStart = 0;
+        int pendingCount = 0;
+        for (int flat = start; flat < end; flat++) {
+            final Preference preference = mPreferences.get(flat);
+            final boolean shown = row < mVisiblePreferences.size()
+                    && mVisiblePreferences.get(row) == preference;
+            final boolean visible = isShownInHierarchy(preference);
+            if (shown == visible) {
+                if (shown) {
+                    row++;
+                }
+                continue;
+            }
+            changed = true;
+            final boolean insert = visible;
+            if (pendingCount > 0 && (pendingInsert != insert
+                    || row != (insert ? pendingStart + pendingCount : pendingStart))) {
+                notifyRange(pendingInsert, pendingStart, pendingCount, notifyRanges);
+                pendingCount = 0;
+            }
+            if (pendingCount == 0) {
+                pendingInsert = insert;
+                pendingStart = row;
+            }
+            pendingCount++;
+            if (insert) {
+                mVisiblePreferences.add(row, preference);
+                insertAccessibilityPosition(row);
+                row++;
+            } else {
+                removeAccessibilityPosition(row);
+                mVisiblePreferences.remove(row);
+            }
+        }
+        if (pendingCount > 0) {
+            notifyRange(pendingInsert, pendingStart, pendingCount, notifyRanges);
+        }
+        return changed;
+    }
+
+    private void notifyRange(boolean insert, int start, int count, boolean notifyRanges) {
+        if (!notifyRanges) {
+            return;
+        }
+        if (insert) {
+            notifyItemRangeInserted(start, count);
+        } else {
+            notifyItemRangeRemoved(start, count);
+        }
+    }
+
+    /**
+     * @return whether the preference and all of its ancestors below {@link #mPreferenceGroup}
+     * are visible, the rule {@link #createVisiblePreferencesList} applies
+     */
+    private boolean isShownInHierarchy(Preference preference) {
+        for (Preference p = preference; p != null && p != mPreferenceGroup; p = p.getParent()) {
+            if (!p.isVisible()) {
+                return false;
+            }
+        }
+        return true;
+    }
+
     /**
      * Recursively generates a list of {@link Preference}s visible to the user.
      *
@@ -393,13 +552,18 @@ public class PreferenceGroupAdapter extends RecyclerView.Adapter<PreferenceViewH
 
     @Override
     public void onPreferenceHierarchyChange(@NonNull Preference preference) {
+        mHierarchyChangePending = true;
         mHandler.removeCallbacks(mSyncRunnable);
         mHandler.post(mSyncRunnable);
     }
 
     @Override
     public void onPreferenceVisibilityChange(@NonNull Preference preference) {
-        onPreferenceHierarchyChange(preference);
+        if (!mHierarchyChangePending && !mPendingVisibilityChanges.contains(preference)) {
+            mPendingVisibilityChanges.add(preference);
+        }
+        mHandler.removeCallbacks(mSyncRunnable);
+        mHandler.post(mSyncRunnable);
     }
 
     @Override
@@ -582,6 +746,42 @@ public class PreferenceGroupAdapter extends RecyclerView.Adapter<PreferenceViewH
         return arrayList;
     }
 
+    private int getAccessibilityWeight(Preference preference) {
+        return preference.getLayoutResource() != R.layout.sesl_preference_category_empty ? 1 : 0;
+    }
+
+    /**
+     * Keeps {@link #mAccessibilityPositionTable} in sync after a row was inserted into
+     * {@link #mVisiblePreferences} at {@code row}.
+     */
+    private void insertAccessibilityPosition(int row) {
+        final List<Integer> table = mAccessibilityPositionTable;
+        final int position = row == 0 ? 0
+                : table.get(row - 1) + getAccessibilityWeight(mVisiblePreferences.get(row - 1));
+        table.add(row, position);
+        final int weight = getAccessibilityWeight(mVisiblePreferences.get(row));
+        if (weight != 0) {
+            for (int i = row + 1; i < table.size(); i++) {
+                table.set(i, table.get(i) + weight);
+            }
+        }
+    }
+
+    /**
+     * Keeps {@link #mAccessibilityPositionTable} in sync before the row at {@code row} is removed
+     * from {@link #mVisiblePreferences}.
+     */
+    private void removeAccessibilityPosition(int row) {
+        final List<Integer> table = mAccessibilityPositionTable;
+        final int weight = getAccessibilityWeight(mVisiblePreferences.get(row));
+        table.remove(row);
+        if (weight != 0) {
+            for (int i = row; i < table.size(); i++) {
+                table.set(i, table.get(i) - weight);
+            }
+        }
+    }
+
     @RestrictTo({RestrictTo.Scope.LIBRARY_GROUP_PREFIX})
     public boolean isSwitchLayout(@NonNull Preference preference) {
         if (preference.getLayoutResource() == R.layout.sesl_preference_switch
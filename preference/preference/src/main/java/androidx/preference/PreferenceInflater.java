@@ -31,7 +31,7 @@ import org.xmlpull.v1.XmlPullParserException;
 
 import java.io.IOException;
 import java.lang.reflect.Constructor;
-import java.util.HashMap;
+import java.util.concurrent.ConcurrentHashMap;
 
 /**
  * This inflater is used to inflate preference hierarchies from XML files.
@@ -40,7 +40,10 @@ class PreferenceInflater {
     private static final Class<?>[] CONSTRUCTOR_SIGNATURE = new Class<?>[]{
             Context.class, AttributeSet.class};
 
-    private static final HashMap<String, Constructor<?>> CONSTRUCTOR_MAP = new HashMap<>();
+    // Shared by every inflater in the process, including ones running on background threads
+    // through PreferenceManager#inflateFromResourceAsync.
+    private static final ConcurrentHashMap<String, Constructor<?>> CONSTRUCTOR_MAP =
+            new ConcurrentHashMap<>();
     private static final String INTENT_TAG_NAME = "intent";
     private static final String EXTRA_TAG_NAME = "extra";
     @NonNull
@@ -48,6 +51,9 @@ class PreferenceInflater {
     private final Object[] mConstructorArgs = new Object[2];
     private PreferenceManager mPreferenceManager;
     private String[] mDefaultPackages;
+    // Builds the hierarchy without a PreferenceManager, see
+    // PreferenceManager#inflateFromResourceAsync
+    boolean mInflateDetached = false;
 
     public PreferenceInflater(@NonNull Context context, PreferenceManager preferenceManager) {
         mContext = context;
@@ -183,7 +189,11 @@ class PreferenceInflater {
         // If we were given a Preferences, use it as the root (ignoring the root
         // Preferences from the XML file).
         if (givenRoot == null) {
-            xmlRoot.onAttachedToHierarchy(mPreferenceManager);
+            if (mPreferenceManager == null && mInflateDetached) {
+                xmlRoot.mInflatingDetached = true;
+            } else {
+                xmlRoot.onAttachedToHierarchy(mPreferenceManager);
+            }
             return xmlRoot;
         } else {
             return givenRoot;
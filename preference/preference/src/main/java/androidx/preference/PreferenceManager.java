@@ -23,6 +23,8 @@ import android.content.SharedPreferences;
 import android.graphics.drawable.Drawable;
 import android.os.Build;
 import android.os.Build.VERSION_CODES;
+import android.os.Handler;
+import android.os.Looper;
 import android.text.TextUtils;
 
 import androidx.annotation.NonNull;
@@ -30,6 +32,10 @@ import androidx.annotation.Nullable;
 import androidx.annotation.RestrictTo;
 import androidx.core.content.ContextCompat;
 
+import java.util.concurrent.Executor;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+
 /**
  * Used to help create {@link Preference} hierarchies from activities or XML.
  *
@@ -43,6 +49,13 @@ public class PreferenceManager {
     public static final String KEY_HAS_SET_DEFAULT_VALUES = "_has_set_default_values";
     private static final int STORAGE_DEFAULT = 0;
     private static final int STORAGE_DEVICE_PROTECTED = 1;
+    /**
+     * The default time batched writes wait for more writes before they are applied.
+     *
+     * @see #setWriteBatchingEnabled(boolean, long)
+     */
+    public static final long DEFAULT_WRITE_BATCH_WINDOW_MS = 250;
+    private static ExecutorService sInflationExecutor;
     /**
      * The context to use. This should always be set.
      */
@@ -73,6 +86,24 @@ public class PreferenceManager {
      * hierarchy. Do not set this directly, use {@link #setNoCommit(boolean)}.
      */
     private boolean mNoCommit;
+    /**
+     * Whether writes outside of no-commit mode also go to the shared editor, which is then
+     * applied at most once per {@link #mWriteBatchWindowMs}.
+     */
+    private boolean mWriteBatching;
+    private long mWriteBatchWindowMs = DEFAULT_WRITE_BATCH_WINDOW_MS;
+    /**
+     * Whether the shared editor holds batched writes that a scheduled flush will apply.
+     */
+    private boolean mHasBatchedWrites;
+    @Nullable
+    private Handler mFlushHandler;
+    private final Runnable mFlushRunnable = new Runnable() {
+        @Override
+        public void run() {
+            flushPendingWrites();
+        }
+    };
     /**
      * The {@link SharedPreferences} name that will be used for all {@link Preference}s managed
      * by this instance.
@@ -221,6 +252,91 @@ public class PreferenceManager {
         return rootPreferences;
     }
 
+    /**
+     * Inflates a new preference hierarchy from XML on a background thread and delivers it to
+     * {@code listener} on the main thread. Parsing the XML, instantiating the preferences and
+     * loading the {@link #getSharedPreferences()} file happen off the main thread.
+     *
+     * <p>The hierarchy is built detached and attached to this manager on the main thread, right
+     * before the listener is called, so preference IDs and initial values are handed out there
+     * from the already loaded file. The shared preferences name, mode, storage and data store
+     * must not change until the listener is called. An exception thrown while inflating is
+     * rethrown on the main thread.
+     *
+     * @param context  The context of the resource
+     * @param resId    The resource ID of the XML to inflate
+     * @param executor The executor to inflate on, or {@code null} to use a shared background
+     *                 thread
+     * @param listener Called on the main thread with the root of the new hierarchy
+     */
+    @RestrictTo(LIBRARY_GROUP_PREFIX)
+    public void inflateFromResourceAsync(@NonNull final Context context, final int resId,
+            @Nullable Executor executor,
+            @NonNull final OnPreferenceScreenInflatedListener listener) {
+        final Handler mainHandler = new Handler(Looper.getMainLooper());
+        final SharedPreferences sharedPreferences =
+                mPreferenceDataStore == null ? getSharedPreferences() : null;
+        (executor != null ? executor : getInflationExecutor()).execute(new Runnable() {
+            @Override
+            public void run() {
+                PreferenceScreen screen = null;
+                RuntimeException error = null;
+                try {
+                    if (sharedPreferences != null) {
+                        // Waits for the file to load here, rather than on the first read of a
+                        // preference on the main thread.
+                        sharedPreferences.contains(KEY_HAS_SET_DEFAULT_VALUES);
+                    }
+                    final PreferenceInflater inflater = new PreferenceInflater(context, null);
+                    inflater.mInflateDetached = true;
+                    screen = (PreferenceScreen) inflater.inflate(resId, null);
+                } catch (RuntimeException e) {
+                    error = e;
+                }
+                final PreferenceScreen result = screen;
+                final RuntimeException failure = error;
+                mainHandler.post(new Runnable() {
+                    @Override
+                    public void run() {
+                        if (failure != null) {
+                            throw failure;
+                        }
+                        // Block commits, like inflateFromResource does
+                        setNoCommit(true);
+                        result.mInflatingDetached = false;
+                        result.onAttachedToHierarchy(PreferenceManager.this);
+                        attachInflatedHierarchy(result);
+                        setNoCommit(false);
+                        listener.onPreferenceScreenInflated(result);
+                    }
+                });
+            }
+        });
+    }
+
+    /**
+     * Attaches the preferences of a hierarchy built by {@link #inflateFromResourceAsync}, parents
+     * before their children as when inflating on the main thread.
+     */
+    @SuppressWarnings("WeakerAccess") /* synthetic access */
+    void attachInflatedHierarchy(@NonNull PreferenceGroup group) {
+        for (int i = 0; i < group.getPreferenceCount(); i++) {
+            final Preference preference = group.getPreference(i);
+            preference.onAttachedToHierarchy(this, getNextId());
+            if (preference instanceof PreferenceGroup) {
+                ((PreferenceGroup) preference).mInflatingDetached = false;
+                attachInflatedHierarchy((PreferenceGroup) preference);
+            }
+        }
+    }
+
+    private static synchronized ExecutorService getInflationExecutor() {
+        if (sInflationExecutor == null) {
+            sInflationExecutor = Executors.newSingleThreadExecutor();
+        }
+        return sInflationExecutor;
+    }
+
     @NonNull
     public PreferenceScreen createPreferenceScreen(@NonNull Context context) {
         final PreferenceScreen preferenceScreen = new PreferenceScreen(context, null);
@@ -261,8 +377,10 @@ public class PreferenceManager {
      * @see #setPreferenceDataStore(PreferenceDataStore)
      */
     public void setSharedPreferencesName(String sharedPreferencesName) {
+        flushPendingWrites();
         mSharedPreferencesName = sharedPreferencesName;
         mSharedPreferences = null;
+        mEditor = null;
     }
 
     /**
@@ -284,8 +402,10 @@ public class PreferenceManager {
      * @see Context#getSharedPreferences(String, int)
      */
     public void setSharedPreferencesMode(int sharedPreferencesMode) {
+        flushPendingWrites();
         mSharedPreferencesMode = sharedPreferencesMode;
         mSharedPreferences = null;
+        mEditor = null;
     }
 
     /**
@@ -294,8 +414,10 @@ public class PreferenceManager {
      */
     public void setStorageDefault() {
         if (Build.VERSION.SDK_INT >= VERSION_CODES.N) {
+            flushPendingWrites();
             mStorage = STORAGE_DEFAULT;
             mSharedPreferences = null;
+            mEditor = null;
         }
     }
 
@@ -319,8 +441,10 @@ public class PreferenceManager {
      */
     public void setStorageDeviceProtected() {
         if (Build.VERSION.SDK_INT >= VERSION_CODES.N) {
+            flushPendingWrites();
             mStorage = STORAGE_DEVICE_PROTECTED;
             mSharedPreferences = null;
+            mEditor = null;
         }
     }
 
@@ -365,6 +489,7 @@ public class PreferenceManager {
      * @see Preference#setPreferenceDataStore(PreferenceDataStore)
      */
     public void setPreferenceDataStore(@Nullable PreferenceDataStore dataStore) {
+        flushPendingWrites();
         mPreferenceDataStore = dataStore;
     }
 
@@ -466,15 +591,22 @@ public class PreferenceManager {
      * @see #shouldCommit()
      */
     @Nullable
-    SharedPreferences.Editor getEditor() {
+    synchronized SharedPreferences.Editor getEditor() {
         if (mPreferenceDataStore != null) {
             return null;
         }
 
-        if (mNoCommit) {
+        if (mNoCommit || mWriteBatching) {
             if (mEditor == null) {
                 mEditor = getSharedPreferences().edit();
             }
+            if (!mNoCommit && !mHasBatchedWrites) {
+                mHasBatchedWrites = true;
+                if (mFlushHandler == null) {
+                    mFlushHandler = new Handler(Looper.getMainLooper());
+                }
+                mFlushHandler.postDelayed(mFlushRunnable, mWriteBatchWindowMs);
+            }
 
             return mEditor;
         } else {
@@ -491,17 +623,78 @@ public class PreferenceManager {
      *
      * @return Whether the client should commit
      */
-    boolean shouldCommit() {
-        return !mNoCommit;
+    synchronized boolean shouldCommit() {
+        return !mNoCommit && !mWriteBatching;
     }
 
-    private void setNoCommit(boolean noCommit) {
+    private synchronized void setNoCommit(boolean noCommit) {
         if (!noCommit && mEditor != null) {
             mEditor.apply();
+            mHasBatchedWrites = false;
         }
         mNoCommit = noCommit;
     }
 
+    /**
+     * Sets whether values persisted by the preferences of this manager are batched. When
+     * enabled, every write goes to one shared {@link SharedPreferences.Editor}, where a later
+     * write to a key replaces the earlier one, and that editor is applied once per
+     * {@code windowMs} instead of once per write. Dragging a {@link SeekBarPreference} or
+     * toggling several switches then costs one write of the preferences file rather than one
+     * per change.
+     *
+     * <p>While a write is pending, reading the {@link SharedPreferences} directly returns the
+     * previous value and its change listeners have not been called yet. Call
+     * {@link #flushPendingWrites()} before relying on either. {@link PreferenceFragmentCompat}
+     * flushes when it is stopped.
+     *
+     * @param enabled  Whether to batch writes
+     * @param windowMs How long the first write of a batch waits for others before the batch is
+     *                 applied, such as {@link #DEFAULT_WRITE_BATCH_WINDOW_MS}
+     * @see PreferenceDataStore#flush()
+     */
+    public void setWriteBatchingEnabled(boolean enabled, long windowMs) {
+        if (windowMs < 0) {
+            throw new IllegalArgumentException("windowMs must not be negative");
+        }
+        if (!enabled) {
+            flushPendingWrites();
+        }
+        synchronized (this) {
+            mWriteBatching = enabled;
+            mWriteBatchWindowMs = windowMs;
+        }
+    }
+
+    /**
+     * Returns whether values persisted by the preferences of this manager are batched.
+     *
+     * @see #setWriteBatchingEnabled(boolean, long)
+     */
+    public synchronized boolean isWriteBatchingEnabled() {
+        return mWriteBatching;
+    }
+
+    /**
+     * Applies the writes batched by {@link #setWriteBatchingEnabled(boolean, long)} right away,
+     * or calls {@link PreferenceDataStore#flush()} if this manager uses a data store.
+     */
+    public void flushPendingWrites() {
+        if (mPreferenceDataStore != null) {
+            mPreferenceDataStore.flush();
+        }
+        synchronized (this) {
+            if (mFlushHandler != null) {
+                mFlushHandler.removeCallbacks(mFlushRunnable);
+            }
+            // Writes made while inflating are applied when inflation ends.
+            if (mHasBatchedWrites && !mNoCommit) {
+                mEditor.apply();
+                mHasBatchedWrites = false;
+            }
+        }
+    }
+
     /**
      * Returns the context.
      *
@@ -620,6 +813,21 @@ public class PreferenceManager {
         void onNavigateToScreen(@NonNull PreferenceScreen preferenceScreen);
     }
 
+    /**
+     * Interface definition for a callback to be invoked when a preference hierarchy inflated by
+     * {@link #inflateFromResourceAsync} is ready.
+     */
+    @RestrictTo(LIBRARY_GROUP_PREFIX)
+    public interface OnPreferenceScreenInflatedListener {
+
+        /**
+         * Called on the main thread with the root of the inflated hierarchy.
+         *
+         * @param preferenceScreen The root of the new hierarchy
+         */
+        void onPreferenceScreenInflated(@NonNull PreferenceScreen preferenceScreen);
+    }
+
     /**
      * Callback class to be used by the {@link androidx.recyclerview.widget.RecyclerView.Adapter}
      * associated with the
@@ -0,0 +1,125 @@
+/*
+ * Copyright 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package androidx.recyclerview.widget;
+
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertSame;
+
+import android.util.Pair;
+import android.view.View;
+import android.view.ViewGroup;
+
+import androidx.annotation.NonNull;
+import androidx.test.ext.junit.runners.AndroidJUnit4;
+import androidx.test.filters.SmallTest;
+
+import org.junit.Test;
+import org.junit.runner.RunWith;
+
+@RunWith(AndroidJUnit4.class)
+@SmallTest
+public class ConcatAdapterItemOffsetsTest {
+
+    @Test
+    public void addFirstAdapter() {
+        final ConcatAdapter concatAdapter = new ConcatAdapter();
+        final CountAdapter first = new CountAdapter(3);
+        concatAdapter.addAdapter(0, first);
+        assertEquals(3, concatAdapter.getItemCount());
+        assertPosition(concatAdapter, 2, first, 2);
+    }
+
+    @Test
+    public void addAdapterAtIndexZero() {
+        final CountAdapter second = new CountAdapter(4);
+        final ConcatAdapter concatAdapter = new ConcatAdapter(second);
+        assertEquals(4, concatAdapter.getItemCount());
+
+        final CountAdapter first = new CountAdapter(2);
+        concatAdapter.addAdapter(0, first);
+        assertEquals(6, concatAdapter.getItemCount());
+        assertPosition(concatAdapter, 0, first, 0);
+        assertPosition(concatAdapter, 1, first, 1);
+        assertPosition(concatAdapter, 2, second, 0);
+        assertPosition(concatAdapter, 5, second, 3);
+    }
+
+    @Test
+    public void removeAdapterAtIndexZero() {
+        final CountAdapter first = new CountAdapter(2);
+        final CountAdapter second = new CountAdapter(4);
+        final ConcatAdapter concatAdapter = new ConcatAdapter(first, second);
+        assertEquals(6, concatAdapter.getItemCount());
+
+        concatAdapter.removeAdapter(first);
+        assertEquals(4, concatAdapter.getItemCount());
+        assertPosition(concatAdapter, 0, second, 0);
+        assertPosition(concatAdapter, 3, second, 3);
+
+        concatAdapter.removeAdapter(second);
+        assertEquals(0, concatAdapter.getItemCount());
+        concatAdapter.addAdapter(0, first);
+        assertEquals(2, concatAdapter.getItemCount());
+    }
+
+    @Test
+    public void countChangeOfFirstAdapter() {
+        final CountAdapter first = new CountAdapter(2);
+        final CountAdapter second = new CountAdapter(4);
+        final ConcatAdapter concatAdapter = new ConcatAdapter(first, second);
+        assertEquals(6, concatAdapter.getItemCount());
+
+        first.mCount = 5;
+        first.notifyItemRangeInserted(2, 3);
+        assertEquals(9, concatAdapter.getItemCount());
+        assertPosition(concatAdapter, 4, first, 4);
+        assertPosition(concatAdapter, 5, second, 0);
+    }
+
+    private static void assertPosition(ConcatAdapter concatAdapter, int globalPosition,
+            RecyclerView.Adapter<?> adapter, int localPosition) {
+        final Pair<RecyclerView.Adapter<? extends RecyclerView.ViewHolder>, Integer> pair =
+                concatAdapter.getWrappedAdapterAndPosition(globalPosition);
+        assertSame(adapter, pair.first);
+        assertEquals(localPosition, (int) pair.second);
+    }
+
+    static class CountAdapter extends RecyclerView.Adapter<RecyclerView.ViewHolder> {
+        int mCount;
+
+        CountAdapter(int count) {
+            mCount = count;
+        }
+
+        @NonNull
+        @Override
+        public RecyclerView.ViewHolder onCreateViewHolder(@NonNull ViewGroup parent,
+                int viewType) {
+            return new RecyclerView.ViewHolder(new View(parent.getContext())) {
+            };
+        }
+
+        @Override
+        public void onBindViewHolder(@NonNull RecyclerView.ViewHolder holder, int position) {
+        }
+
+        @Override
+        public int getItemCount() {
+            return mCount;
+        }
+    }
+}
@@ -0,0 +1,152 @@
+/*
+ * Copyright 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package androidx.recyclerview.widget;
+
+import static org.junit.Assert.assertEquals;
+
+import androidx.test.ext.junit.runners.AndroidJUnit4;
+import androidx.test.filters.SmallTest;
+
+import org.junit.Before;
+import org.junit.Test;
+import org.junit.runner.RunWith;
+
+import java.util.Random;
+
+@RunWith(AndroidJUnit4.class)
+@SmallTest
+public class GridLayoutManagerSpanSizeLookupTest {
+    private static final int SPAN_COUNT = 4;
+    private static final int ITEM_COUNT = 500;
+
+    private int[] mSpanSizes;
+    private GridLayoutManager.SpanSizeLookup mLookup;
+
+    @Before
+    public void setUp() {
+        final Random random = new Random(7);
+        mSpanSizes = new int[ITEM_COUNT];
+        for (int i = 0; i < ITEM_COUNT; i++) {
+            mSpanSizes[i] = 1 + random.nextInt(SPAN_COUNT);
+        }
+        mLookup = new GridLayoutManager.SpanSizeLookup() {
+            @Override
+            public int getSpanSize(int position) {
+                return mSpanSizes[position];
+            }
+        };
+    }
+
+    @Test
+    public void uncachedLookupFollowsSpanSizeChanges() {
+        assertLookupMatches();
+        // Not notified through an adapter change: only cached lookups may keep stale values
+        mSpanSizes[10] = SPAN_COUNT;
+        mSpanSizes[200] = SPAN_COUNT;
+        assertLookupMatches();
+    }
+
+    @Test
+    public void cachedLookupMatchesWalkFromStart() {
+        mLookup.setSpanIndexCacheEnabled(true);
+        mLookup.setSpanGroupIndexCacheEnabled(true);
+        final Random random = new Random(11);
+        for (int i = 0; i < 2000; i++) {
+            final int position = random.nextInt(ITEM_COUNT);
+            assertEquals("span index of " + position, expectedSpanIndex(position),
+                    mLookup.getCachedSpanIndex(position, SPAN_COUNT));
+            assertEquals("span group index of " + position, expectedSpanGroupIndex(position),
+                    mLookup.getCachedSpanGroupIndex(position, SPAN_COUNT));
+        }
+    }
+
+    @Test
+    public void cachedLookupDropsValuesFromChangedPosition() {
+        mLookup.setSpanIndexCacheEnabled(true);
+        mLookup.setSpanGroupIndexCacheEnabled(true);
+        assertCachedLookupMatches();
+
+        mSpanSizes[300] = SPAN_COUNT;
+        mLookup.invalidateSpanIndexCacheFrom(300);
+        assertCachedLookupMatches();
+
+        mSpanSizes[3] = 1;
+        mSpanSizes[70] = SPAN_COUNT - 1;
+        mLookup.invalidateSpanIndexCacheFrom(3);
+        assertCachedLookupMatches();
+    }
+
+    @Test
+    public void disablingCacheDropsCheckpoints() {
+        mLookup.setSpanIndexCacheEnabled(true);
+        mLookup.setSpanGroupIndexCacheEnabled(true);
+        assertLookupMatches();
+
+        mLookup.setSpanIndexCacheEnabled(false);
+        mLookup.setSpanGroupIndexCacheEnabled(false);
+        mSpanSizes[5] = SPAN_COUNT;
+        mLookup.setSpanIndexCacheEnabled(true);
+        mLookup.setSpanGroupIndexCacheEnabled(true);
+        assertLookupMatches();
+    }
+
+    private void assertCachedLookupMatches() {
+        for (int position = ITEM_COUNT - 1; position >= 0; position -= 13) {
+            assertEquals("span index of " + position, expectedSpanIndex(position),
+                    mLookup.getCachedSpanIndex(position, SPAN_COUNT));
+            assertEquals("span group index of " + position, expectedSpanGroupIndex(position),
+                    mLookup.getCachedSpanGroupIndex(position, SPAN_COUNT));
+        }
+    }
+
+    private void assertLookupMatches() {
+        for (int position = ITEM_COUNT - 1; position >= 0; position -= 13) {
+            assertEquals("span index of " + position, expectedSpanIndex(position),
+                    mLookup.getSpanIndex(position, SPAN_COUNT));
+            assertEquals("span group index of " + position, expectedSpanGroupIndex(position),
+                    mLookup.getSpanGroupIndex(position, SPAN_COUNT));
+        }
+    }
+
+    private int expectedSpanIndex(int position) {
+        final int span = walk(position)[0];
+        return span + mSpanSizes[position] <= SPAN_COUNT ? span : 0;
+    }
+
+    private int expectedSpanGroupIndex(int position) {
+        final int[] walk = walk(position);
+        return walk[0] + mSpanSizes[position] > SPAN_COUNT ? walk[1] + 1 : walk[1];
+    }
+
+    /** Returns the span and span group reached right before the given position. */
+    private int[] walk(int position) {
+        int span = 0;
+        int group = 0;
+        for (int i = 0; i < position; i++) {
+            final int size = mSpanSizes[i];
+            span += size;
+            if (span == SPAN_COUNT) {
+                span = 0;
+                group++;
+            } else if (span > SPAN_COUNT) {
+                span = size;
+                group++;
+            }
+        }
+        return new int[]{span, group};
+    }
+}
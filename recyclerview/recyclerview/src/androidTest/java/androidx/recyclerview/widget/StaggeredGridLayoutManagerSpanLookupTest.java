@@ -0,0 +1,146 @@
+/*
+ * Copyright 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package androidx.recyclerview.widget;
+
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertFalse;
+import static org.junit.Assert.assertNotNull;
+import static org.junit.Assert.assertNotSame;
+import static org.junit.Assert.assertNull;
+
+import android.os.Parcel;
+
+import androidx.recyclerview.widget.StaggeredGridLayoutManager.LazySpanLookup;
+import androidx.recyclerview.widget.StaggeredGridLayoutManager.LazySpanLookup.FullSpanItem;
+import androidx.recyclerview.widget.StaggeredGridLayoutManager.SavedState;
+import androidx.test.ext.junit.runners.AndroidJUnit4;
+import androidx.test.filters.SmallTest;
+
+import org.junit.Test;
+import org.junit.runner.RunWith;
+
+@RunWith(AndroidJUnit4.class)
+@SmallTest
+public class StaggeredGridLayoutManagerSpanLookupTest {
+
+    @Test
+    public void shortLookupSurvivesParceling() {
+        final StaggeredGridLayoutManager layoutManager =
+                new StaggeredGridLayoutManager(3, StaggeredGridLayoutManager.VERTICAL);
+        final LazySpanLookup lookup = new LazySpanLookup();
+        // trims to a single position, which restoring used to skip
+        lookup.setSpan(0, layoutManager.mSpans[2]);
+        lookup.addFullSpanItem(fullSpanItem(0, 3));
+
+        final SavedState state = new SavedState();
+        lookup.saveTo(state);
+        assertEquals(1, state.mSpanLookupSize);
+
+        final LazySpanLookup restored = new LazySpanLookup();
+        restored.restoreFrom(parcel(state));
+        assertEquals(1, restored.length());
+        assertEquals(2, restored.getSpan(0));
+        assertNotNull(restored.getFullSpanItem(0));
+        assertEquals(7, restored.getFullSpanItem(0).getGapForSpan(1));
+    }
+
+    @Test
+    public void wideLookupSurvivesParceling() {
+        final StaggeredGridLayoutManager layoutManager =
+                new StaggeredGridLayoutManager(200, StaggeredGridLayoutManager.VERTICAL);
+        final LazySpanLookup lookup = new LazySpanLookup();
+        lookup.setSpan(3, layoutManager.mSpans[5]);
+        lookup.setSpan(40, layoutManager.mSpans[180]);
+
+        final SavedState state = new SavedState();
+        lookup.saveTo(state);
+        assertEquals(41, state.mSpanLookupSize);
+
+        final LazySpanLookup restored = new LazySpanLookup();
+        restored.restoreFrom(parcel(state));
+        assertEquals(5, restored.getSpan(3));
+        assertEquals(180, restored.getSpan(40));
+        assertEquals(StaggeredGridLayoutManager.LayoutParams.INVALID_SPAN_ID,
+                restored.getSpan(41));
+    }
+
+    @Test
+    public void emptyLookupIsNotRestored() {
+        final StaggeredGridLayoutManager layoutManager =
+                new StaggeredGridLayoutManager(3, StaggeredGridLayoutManager.VERTICAL);
+        final LazySpanLookup lookup = new LazySpanLookup();
+        lookup.ensureSize(20);
+        lookup.addFullSpanItem(fullSpanItem(4, 3));
+
+        final SavedState state = new SavedState();
+        lookup.saveTo(state);
+        assertEquals(0, state.mSpanLookupSize);
+        assertNull(state.mFullSpanItems);
+
+        final LazySpanLookup restored = new LazySpanLookup();
+        restored.setSpan(2, layoutManager.mSpans[1]);
+        restored.restoreFrom(parcel(state));
+        assertEquals(1, restored.getSpan(2));
+    }
+
+    @Test
+    public void savedFullSpanItemsAreCopies() {
+        final StaggeredGridLayoutManager layoutManager =
+                new StaggeredGridLayoutManager(3, StaggeredGridLayoutManager.VERTICAL);
+        final LazySpanLookup lookup = new LazySpanLookup();
+        lookup.setSpan(5, layoutManager.mSpans[0]);
+        lookup.addFullSpanItem(fullSpanItem(5, 3));
+
+        final SavedState state = new SavedState();
+        lookup.saveTo(state);
+        final FullSpanItem live = lookup.getFullSpanItem(5);
+        final FullSpanItem saved = state.mFullSpanItems.get(0);
+        assertNotSame(live, saved);
+        live.mGapPerSpan[1] = 99;
+        live.mHasUnwantedGapAfter = true;
+        assertEquals(7, saved.getGapForSpan(1));
+        assertFalse(saved.mHasUnwantedGapAfter);
+
+        // restoring does not share the state either, so it can be restored again
+        final LazySpanLookup restored = new LazySpanLookup();
+        restored.restoreFrom(state);
+        restored.getFullSpanItem(5).mGapPerSpan[1] = 42;
+        restored.setSpan(5, layoutManager.mSpans[2]);
+        assertEquals(7, saved.getGapForSpan(1));
+        assertEquals(0, state.mSpanLookup[5]);
+    }
+
+    private static FullSpanItem fullSpanItem(int position, int spanCount) {
+        final FullSpanItem item = new FullSpanItem();
+        item.mPosition = position;
+        item.mGapDir = LayoutState.LAYOUT_END;
+        item.mGapPerSpan = new int[spanCount];
+        item.mGapPerSpan[1] = 7;
+        return item;
+    }
+
+    private static SavedState parcel(SavedState state) {
+        final Parcel parcel = Parcel.obtain();
+        try {
+            state.writeToParcel(parcel, 0);
+            parcel.setDataPosition(0);
+            return SavedState.CREATOR.createFromParcel(parcel);
+        } finally {
+            parcel.recycle();
+        }
+    }
+}
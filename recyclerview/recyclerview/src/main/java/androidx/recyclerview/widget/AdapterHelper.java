@@ -18,9 +18,8 @@ package androidx.recyclerview.widget;
 
 import android.util.Log;
 
-import androidx.core.util.Pools;
-
 import java.util.ArrayList;
+import java.util.Arrays;
 import java.util.Collections;
 import java.util.List;
 
@@ -52,7 +51,20 @@ final class AdapterHelper implements OpReorderer.Callback {
 
     private static final String TAG = "AHT";
 
-    private Pools.Pool<UpdateOp> mUpdateOpPool = new Pools.SimplePool<UpdateOp>(UpdateOp.POOL_SIZE);
+    /**
+     * Free list of recycled UpdateOps. Unlike a fixed size pool it grows to the largest burst of
+     * pending updates seen so far, so released ops are never dropped and steady state adapter
+     * updates do not allocate.
+     */
+    private UpdateOp[] mUpdateOpPool = new UpdateOp[UpdateOp.POOL_SIZE];
+
+    private int mUpdateOpPoolSize = 0;
+
+    /**
+     * Number of UpdateOps and pool arrays allocated, see
+     * {@link RecyclerView#seslGetLayoutPassAllocationCount()}.
+     */
+    int mAllocationCount = 0;
 
     final ArrayList<UpdateOp> mPendingUpdates = new ArrayList<UpdateOp>();
 
@@ -724,10 +736,13 @@ final class AdapterHelper implements OpReorderer.Callback {
 
     @Override
     public UpdateOp obtainUpdateOp(int cmd, int positionStart, int itemCount, Object payload) {
-        UpdateOp op = mUpdateOpPool.acquire();
-        if (op == null) {
+        UpdateOp op;
+        if (mUpdateOpPoolSize == 0) {
             op = new UpdateOp(cmd, positionStart, itemCount, payload);
+            mAllocationCount++;
         } else {
+            op = mUpdateOpPool[--mUpdateOpPoolSize];
+            mUpdateOpPool[mUpdateOpPoolSize] = null;
             op.cmd = cmd;
             op.positionStart = positionStart;
             op.itemCount = itemCount;
@@ -740,7 +755,18 @@ final class AdapterHelper implements OpReorderer.Callback {
     public void recycleUpdateOp(UpdateOp op) {
         if (!mDisableRecycler) {
             op.payload = null;
-            mUpdateOpPool.release(op);
+            if (DEBUG) {
+                for (int i = 0; i < mUpdateOpPoolSize; i++) {
+                    if (mUpdateOpPool[i] == op) {
+                        throw new IllegalStateException("Already in the pool!");
+                    }
+                }
+            }
+            if (mUpdateOpPoolSize == mUpdateOpPool.length) {
+                mUpdateOpPool = Arrays.copyOf(mUpdateOpPool, mUpdateOpPoolSize * 2);
+                mAllocationCount++;
+            }
+            mUpdateOpPool[mUpdateOpPoolSize++] = op;
         }
     }
 
@@ -39,15 +39,34 @@ public final class AsyncDifferConfig<T> {
     private final Executor mBackgroundThreadExecutor;
     @NonNull
     private final DiffUtil.ItemCallback<T> mDiffCallback;
+    @Nullable
+    private final Executor mDiffWorkerExecutor;
+    private final boolean mStreamingDispatchEnabled;
+    private final long mStreamingFrameBudgetMs;
 
     @SuppressWarnings("WeakerAccess") /* synthetic access */
     AsyncDifferConfig(
             @Nullable Executor mainThreadExecutor,
             @NonNull Executor backgroundThreadExecutor,
             @NonNull DiffUtil.ItemCallback<T> diffCallback) {
+        this(mainThreadExecutor, backgroundThreadExecutor, diffCallback, null, false,
+                Builder.DEFAULT_STREAMING_FRAME_BUDGET_MS);
+    }
+
+    @SuppressWarnings("WeakerAccess") /* synthetic access */
+    AsyncDifferConfig(
+            @Nullable Executor mainThreadExecutor,
+            @NonNull Executor backgroundThreadExecutor,
+            @NonNull DiffUtil.ItemCallback<T> diffCallback,
+            @Nullable Executor diffWorkerExecutor,
+            boolean streamingDispatchEnabled,
+            long streamingFrameBudgetMs) {
         mMainThreadExecutor = mainThreadExecutor;
         mBackgroundThreadExecutor = backgroundThreadExecutor;
         mDiffCallback = diffCallback;
+        mDiffWorkerExecutor = diffWorkerExecutor;
+        mStreamingDispatchEnabled = streamingDispatchEnabled;
+        mStreamingFrameBudgetMs = streamingFrameBudgetMs;
     }
 
     @SuppressWarnings("WeakerAccess")
@@ -69,6 +88,19 @@ public final class AsyncDifferConfig<T> {
         return mDiffCallback;
     }
 
+    @Nullable
+    public Executor seslGetDiffWorkerExecutor() {
+        return mDiffWorkerExecutor;
+    }
+
+    public boolean seslIsStreamingDispatchEnabled() {
+        return mStreamingDispatchEnabled;
+    }
+
+    public long seslGetStreamingFrameBudgetMs() {
+        return mStreamingFrameBudgetMs;
+    }
+
     /**
      * Builder class for {@link AsyncDifferConfig}.
      *
@@ -79,6 +111,12 @@ public final class AsyncDifferConfig<T> {
         private Executor mMainThreadExecutor;
         private Executor mBackgroundThreadExecutor;
         private final DiffUtil.ItemCallback<T> mDiffCallback;
+        @Nullable
+        private Executor mDiffWorkerExecutor;
+        private boolean mStreamingDispatchEnabled;
+        private long mStreamingFrameBudgetMs = DEFAULT_STREAMING_FRAME_BUDGET_MS;
+
+        static final long DEFAULT_STREAMING_FRAME_BUDGET_MS = 4;
 
         public Builder(@NonNull DiffUtil.ItemCallback<T> diffCallback) {
             mDiffCallback = diffCallback;
@@ -118,6 +156,58 @@ public final class AsyncDifferConfig<T> {
             return this;
         }
 
+        /**
+         * Sesl: If provided, the diff is calculated with
+         * {@link DiffUtil#calculateDiff(DiffUtil.Callback, boolean, Executor)}, which trims the
+         * common prefix and suffix of the lists and solves independent ranges on this executor
+         * in parallel with the background thread.
+         * <p>
+         * {@link DiffUtil.ItemCallback#areItemsTheSame(Object, Object)} may then be called from
+         * several threads at once.
+         *
+         * @param executor The executor to share diff work with, or null to diff on the background
+         *                 thread only.
+         * @return this
+         */
+        @NonNull
+        public Builder<T> seslSetDiffWorkerExecutor(@Nullable Executor executor) {
+            mDiffWorkerExecutor = executor;
+            return this;
+        }
+
+        /**
+         * Sesl: Enables streaming dispatch of list updates.
+         * <p>
+         * Instead of dispatching the whole diff in one main thread task, the updates that touch
+         * the visible window (see {@link AsyncListDiffer#seslSetVisibleRange(int, int)}) are
+         * dispatched first, and the remaining updates are dispatched over the following frames
+         * in batches limited by {@link #seslSetStreamingFrameBudgetMs(long)}. While streaming,
+         * {@link AsyncListDiffer#getCurrentList()} reflects the updates dispatched so far.
+         * <p>
+         * Diffs that contain moves are always dispatched at once.
+         *
+         * @param enabled True to enable streaming dispatch.
+         * @return this
+         */
+        @NonNull
+        public Builder<T> seslSetStreamingDispatchEnabled(boolean enabled) {
+            mStreamingDispatchEnabled = enabled;
+            return this;
+        }
+
+        /**
+         * Sesl: Sets how much main thread time a single streaming dispatch batch may take.
+         * Defaults to 4ms.
+         *
+         * @param budgetMs The time budget of a batch, in milliseconds.
+         * @return this
+         */
+        @NonNull
+        public Builder<T> seslSetStreamingFrameBudgetMs(long budgetMs) {
+            mStreamingFrameBudgetMs = Math.max(0, budgetMs);
+            return this;
+        }
+
         /**
          * Creates a {@link AsyncListDiffer} with the given parameters.
          *
@@ -136,7 +226,10 @@ public final class AsyncDifferConfig<T> {
             return new AsyncDifferConfig<>(
                     mMainThreadExecutor,
                     mBackgroundThreadExecutor,
-                    mDiffCallback);
+                    mDiffCallback,
+                    mDiffWorkerExecutor,
+                    mStreamingDispatchEnabled,
+                    mStreamingFrameBudgetMs);
         }
 
         // TODO: remove the below once supportlib has its own appropriate executors
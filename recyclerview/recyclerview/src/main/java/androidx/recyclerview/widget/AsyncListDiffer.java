@@ -16,14 +16,20 @@
 
 package androidx.recyclerview.widget;
 
+import android.annotation.SuppressLint;
 import android.os.Handler;
 import android.os.Looper;
+import android.os.SystemClock;
+import android.view.Choreographer;
 
 import androidx.annotation.NonNull;
 import androidx.annotation.Nullable;
 
+import java.util.ArrayList;
+import java.util.Arrays;
 import java.util.Collections;
 import java.util.List;
+import java.util.concurrent.CancellationException;
 import java.util.concurrent.CopyOnWriteArrayList;
 import java.util.concurrent.Executor;
 
@@ -196,9 +202,18 @@ public class AsyncListDiffer<T> {
     @NonNull
     private List<T> mReadOnlyList = Collections.emptyList();
 
-    // Max generation of currently scheduled runnable
+    // Max generation of currently scheduled runnable. Volatile, as in-flight diffs poll it to
+    // cancel themselves once a newer list was submitted.
     @SuppressWarnings("WeakerAccess") /* synthetic access */
-    int mMaxScheduledGeneration;
+    volatile int mMaxScheduledGeneration;
+
+    // Sesl: hint for streaming dispatch, positions in the current list
+    private int mVisibleFirstPosition = 0;
+    private int mVisibleLastPosition = DEFAULT_VISIBLE_WINDOW_SIZE - 1;
+    private static final int DEFAULT_VISIBLE_WINDOW_SIZE = 32;
+
+    // How many item comparisons an in-flight diff runs between checks for a newer submission
+    private static final int CANCELLATION_CHECK_INTERVAL = 64;
 
     /**
      * Get the current List - any diffing to present this list has already been computed and
@@ -216,6 +231,20 @@ public class AsyncListDiffer<T> {
         return mReadOnlyList;
     }
 
+    /**
+     * Sesl: Sets the range of positions currently shown by the view. When streaming dispatch is
+     * enabled with {@link AsyncDifferConfig.Builder#seslSetStreamingDispatchEnabled(boolean)},
+     * updates touching this range are dispatched before all others. Defaults to the first 32
+     * positions.
+     *
+     * @param firstPosition First visible position in the current list.
+     * @param lastPosition  Last visible position in the current list, inclusive.
+     */
+    public void seslSetVisibleRange(int firstPosition, int lastPosition) {
+        mVisibleFirstPosition = Math.max(0, firstPosition);
+        mVisibleLastPosition = Math.max(mVisibleFirstPosition, lastPosition);
+    }
+
     /**
      * Pass a new List to the AdapterHelper. Adapter updates will be computed on a background
      * thread.
@@ -286,10 +315,14 @@ public class AsyncListDiffer<T> {
         }
 
         final List<T> oldList = mList;
+        final int visibleFirst = mVisibleFirstPosition;
+        final int visibleLast = mVisibleLastPosition;
         mConfig.getBackgroundThreadExecutor().execute(new Runnable() {
             @Override
             public void run() {
-                final DiffUtil.DiffResult result = DiffUtil.calculateDiff(new DiffUtil.Callback() {
+                final DiffUtil.Callback callback = new DiffUtil.Callback() {
+                    private int mComparisons;
+
                     @Override
                     public int getOldListSize() {
                         return oldList.size();
@@ -302,6 +335,11 @@ public class AsyncListDiffer<T> {
 
                     @Override
                     public boolean areItemsTheSame(int oldItemPosition, int newItemPosition) {
+                        if (++mComparisons % CANCELLATION_CHECK_INTERVAL == 0
+                                && mMaxScheduledGeneration != runGeneration) {
+                            // a newer list was submitted, this result would be discarded anyway
+                            throw new CancellationException();
+                        }
                         T oldItem = oldList.get(oldItemPosition);
                         T newItem = newList.get(newItemPosition);
                         if (oldItem != null && newItem != null) {
@@ -342,13 +380,37 @@ public class AsyncListDiffer<T> {
                         // non-null which is the only case handled above.
                         throw new AssertionError();
                     }
-                });
+                };
+
+                DiffUtil.DiffResult diffResult;
+                StreamedUpdates streamedUpdates = null;
+                try {
+                    final Executor workerExecutor = mConfig.seslGetDiffWorkerExecutor();
+                    if (workerExecutor != null || mConfig.seslIsStreamingDispatchEnabled()) {
+                        diffResult = DiffUtil.calculateDiff(callback, true, workerExecutor);
+                    } else {
+                        diffResult = DiffUtil.calculateDiff(callback);
+                    }
+                    if (mConfig.seslIsStreamingDispatchEnabled()) {
+                        streamedUpdates = StreamedUpdates.record(diffResult, oldList.size(),
+                                newList.size(), visibleFirst, visibleLast);
+                    }
+                } catch (CancellationException e) {
+                    return;
+                }
+                final DiffUtil.DiffResult result = diffResult;
+                final StreamedUpdates updates = streamedUpdates;
 
                 mMainThreadExecutor.execute(new Runnable() {
                     @Override
                     public void run() {
                         if (mMaxScheduledGeneration == runGeneration) {
-                            latchList(newList, result, commitCallback);
+                            if (updates != null && updates.canStream()) {
+                                new StreamingDispatch(newList, updates, runGeneration,
+                                        commitCallback).start();
+                            } else {
+                                latchList(newList, result, commitCallback);
+                            }
                         }
                     }
                 });
@@ -356,6 +418,254 @@ public class AsyncListDiffer<T> {
         });
     }
 
+    /**
+     * Sesl: Dispatches a recorded diff over several frames, keeping the current list in sync
+     * with the updates dispatched so far. Stops as soon as a newer list is submitted, leaving the
+     * partially updated list as the base for the next diff.
+     */
+    private final class StreamingDispatch implements Runnable, Choreographer.FrameCallback {
+        private final List<T> mNewList;
+        private final StreamedUpdates mUpdates;
+        private final int mRunGeneration;
+        @Nullable
+        private final Runnable mCommitCallback;
+        private final ArrayList<T> mWorkingList;
+        private List<T> mPreviousList;
+        private int mNextOp;
+
+        StreamingDispatch(@NonNull List<T> newList, @NonNull StreamedUpdates updates,
+                int runGeneration, @Nullable Runnable commitCallback) {
+            mNewList = newList;
+            mUpdates = updates;
+            mRunGeneration = runGeneration;
+            mCommitCallback = commitCallback;
+            //noinspection ConstantConditions
+            mWorkingList = new ArrayList<>(mList);
+        }
+
+        void start() {
+            mPreviousList = mReadOnlyList;
+            mList = mWorkingList;
+            mReadOnlyList = Collections.unmodifiableList(mWorkingList);
+            // the visible window is dispatched right away, regardless of the frame budget
+            while (mNextOp < mUpdates.mWindowOpCount) {
+                dispatchNextOp();
+            }
+            dispatchBatch();
+        }
+
+        @Override
+        public void doFrame(long frameTimeNanos) {
+            run();
+        }
+
+        @Override
+        public void run() {
+            if (mMaxScheduledGeneration != mRunGeneration) {
+                return;
+            }
+            dispatchBatch();
+        }
+
+        private void dispatchBatch() {
+            final long budgetMs = mConfig.seslGetStreamingFrameBudgetMs();
+            final long start = SystemClock.uptimeMillis();
+            while (mNextOp < mUpdates.size()) {
+                dispatchNextOp();
+                if (SystemClock.uptimeMillis() - start >= budgetMs) {
+                    break;
+                }
+            }
+            if (mNextOp < mUpdates.size()) {
+                scheduleNextBatch();
+                return;
+            }
+            mList = mNewList;
+            mReadOnlyList = Collections.unmodifiableList(mNewList);
+            onCurrentListChanged(mPreviousList, mCommitCallback);
+        }
+
+        private void scheduleNextBatch() {
+            if (Looper.myLooper() == Looper.getMainLooper()) {
+                // one batch per frame, so each lands in its own layout pass
+                Choreographer.getInstance().postFrameCallback(this);
+            } else {
+                mMainThreadExecutor.execute(this);
+            }
+        }
+
+        private void dispatchNextOp() {
+            final int op = mUpdates.mOrder[mNextOp++];
+            final int position = mUpdates.dispatchPosition(op);
+            final int count = mUpdates.mCounts[op];
+            final int newIndex = mUpdates.mNewIndices[op];
+            switch (mUpdates.mTypes[op]) {
+                case StreamedUpdates.TYPE_INSERT:
+                    mWorkingList.addAll(position, mNewList.subList(newIndex, newIndex + count));
+                    mUpdateCallback.onInserted(position, count);
+                    break;
+                case StreamedUpdates.TYPE_REMOVE:
+                    mWorkingList.subList(position, position + count).clear();
+                    mUpdateCallback.onRemoved(position, count);
+                    break;
+                default:
+                    for (int i = 0; i < count; i++) {
+                        mWorkingList.set(position + i, mNewList.get(newIndex + i));
+                    }
+                    mUpdateCallback.onChanged(position, count, mUpdates.mPayloads.get(op));
+                    break;
+            }
+        }
+    }
+
+    /**
+     * Sesl: The update operations of a {@link DiffUtil.DiffResult}, recorded so they can be
+     * dispatched in a different order.
+     * <p>
+     * Without moves, DiffResult dispatches the insertions and removals of non overlapping
+     * ranges from the end of the list to its start, but the changes inside one range of kept
+     * items from its start to its end. An operation is then only affected by the insertions and
+     * removals dispatched after it, which are all before it in the list, and the part of the list
+     * after it is already in its final state, which tells which new items it inserts or changes.
+     * <p>
+     * Each operation is put in a group by its range: overlapping the visible window, before it,
+     * or after it. Positions do not decrease monotonically in recorded order, so the groups are not
+     * contiguous. The groups are dispatched in that order, each in recorded order. An operation
+     * recorded before another one in an earlier group is then dispatched after it, so it is
+     * offset by the size changes of all operations of earlier groups recorded after it, for
+     * example a change before the window by an insertion at the start of the list that reaches
+     * into the window. Operations recorded before it are either changes or after it in the list,
+     * so they never move it.
+     */
+    static final class StreamedUpdates implements ListUpdateCallback {
+        static final int TYPE_INSERT = 0;
+        static final int TYPE_REMOVE = 1;
+        static final int TYPE_CHANGE = 2;
+
+        private final int mNewListSize;
+        private int mCurrentListSize;
+        private int mSize;
+        private boolean mHasMoves;
+
+        int[] mTypes = new int[16];
+        int[] mPositions = new int[16];
+        int[] mCounts = new int[16];
+        int[] mNewIndices = new int[16];
+        final ArrayList<Object> mPayloads = new ArrayList<>();
+
+        int[] mOrder;
+        int mWindowOpCount;
+        // per op, added to the recorded position when it is dispatched after ops recorded later
+        private int[] mOffsets;
+
+        private StreamedUpdates(int oldListSize, int newListSize) {
+            mCurrentListSize = oldListSize;
+            mNewListSize = newListSize;
+        }
+
+        @NonNull
+        static StreamedUpdates record(@NonNull DiffUtil.DiffResult result, int oldListSize,
+                int newListSize, int visibleFirst, int visibleLast) {
+            final StreamedUpdates updates = new StreamedUpdates(oldListSize, newListSize);
+            result.dispatchUpdatesTo(updates);
+            if (!updates.mHasMoves) {
+                updates.buildOrder(visibleFirst, visibleLast);
+            }
+            return updates;
+        }
+
+        boolean canStream() {
+            return !mHasMoves && mSize > 1;
+        }
+
+        int size() {
+            return mSize;
+        }
+
+        int dispatchPosition(int op) {
+            return mPositions[op] + mOffsets[op];
+        }
+
+        private void buildOrder(int visibleFirst, int visibleLast) {
+            mOrder = new int[mSize];
+            mOffsets = new int[mSize];
+            int index = 0;
+            for (int op = 0; op < mSize; op++) {
+                if (mPositions[op] <= visibleLast
+                        && mPositions[op] + mCounts[op] > visibleFirst) {
+                    mOrder[index++] = op;
+                }
+            }
+            mWindowOpCount = index;
+            for (int op = 0; op < mSize; op++) {
+                if (mPositions[op] + mCounts[op] <= visibleFirst) {
+                    mOrder[index++] = op;
+                }
+            }
+            // walk backwards, summing the size changes of the window and before ops recorded
+            // after each op, which are dispatched ahead of the later groups
+            int windowSizeChange = 0;
+            int beforeSizeChange = 0;
+            int afterIndex = mSize;
+            for (int op = mSize - 1; op >= 0; op--) {
+                final int sizeChange = mTypes[op] == TYPE_INSERT ? mCounts[op]
+                        : mTypes[op] == TYPE_REMOVE ? -mCounts[op] : 0;
+                if (mPositions[op] > visibleLast) {
+                    mOffsets[op] = windowSizeChange + beforeSizeChange;
+                    mOrder[--afterIndex] = op;
+                } else if (mPositions[op] + mCounts[op] <= visibleFirst) {
+                    mOffsets[op] = windowSizeChange;
+                    beforeSizeChange += sizeChange;
+                } else {
+                    windowSizeChange += sizeChange;
+                }
+            }
+        }
+
+        private void add(int type, int position, int count, int newIndex,
+                @Nullable Object payload) {
+            if (mSize == mTypes.length) {
+                final int capacity = mSize * 2;
+                mTypes = Arrays.copyOf(mTypes, capacity);
+                mPositions = Arrays.copyOf(mPositions, capacity);
+                mCounts = Arrays.copyOf(mCounts, capacity);
+                mNewIndices = Arrays.copyOf(mNewIndices, capacity);
+            }
+            mTypes[mSize] = type;
+            mPositions[mSize] = position;
+            mCounts[mSize] = count;
+            mNewIndices[mSize] = newIndex;
+            mPayloads.add(payload);
+            mSize++;
+        }
+
+        @Override
+        public void onInserted(int position, int count) {
+            // inserted items sit right before the already final end of the list
+            add(TYPE_INSERT, position, count,
+                    mNewListSize - (mCurrentListSize - position) - count, null);
+            mCurrentListSize += count;
+        }
+
+        @Override
+        public void onRemoved(int position, int count) {
+            add(TYPE_REMOVE, position, count, -1, null);
+            mCurrentListSize -= count;
+        }
+
+        @Override
+        public void onMoved(int fromPosition, int toPosition) {
+            mHasMoves = true;
+        }
+
+        @Override
+        @SuppressLint("UnknownNullness") // b/240775049: Cannot annotate properly
+        public void onChanged(int position, int count, Object payload) {
+            add(TYPE_CHANGE, position, count, mNewListSize - (mCurrentListSize - position),
+                    payload);
+        }
+    }
+
     @SuppressWarnings("WeakerAccess") /* synthetic access */
     void latchList(
             @NonNull List<T> newList,
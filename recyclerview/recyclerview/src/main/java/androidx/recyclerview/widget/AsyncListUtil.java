@@ -16,7 +16,9 @@
 
 package androidx.recyclerview.widget;
 
+import android.os.Process;
 import android.util.Log;
+import android.util.SparseArray;
 import android.util.SparseBooleanArray;
 import android.util.SparseIntArray;
 
@@ -25,6 +27,13 @@ import androidx.annotation.Nullable;
 import androidx.annotation.UiThread;
 import androidx.annotation.WorkerThread;
 
+import java.util.concurrent.PriorityBlockingQueue;
+import java.util.concurrent.ThreadFactory;
+import java.util.concurrent.ThreadPoolExecutor;
+import java.util.concurrent.TimeUnit;
+import java.util.concurrent.atomic.AtomicInteger;
+import java.util.concurrent.atomic.AtomicLong;
+
 /**
  * A utility class that supports asynchronous content loading.
  * <p>
@@ -39,8 +48,10 @@ import androidx.annotation.WorkerThread;
  * {@link ViewCallback} when the data is loaded. It may load some extra items for smoother
  * scrolling.
  * <p>
- * Note that this class uses a single thread to load the data, so it suitable to load data from
- * secondary storage such as disk, but not from network.
+ * Note that by default this class uses a single thread to load the data, so it suitable to load
+ * data from secondary storage such as disk, but not from network. Data sources that can serve
+ * several tiles at once can return more than 1 from
+ * {@link DataCallback#seslGetMaxParallelTileLoads()} to fill tiles in parallel.
  * <p>
  * This class is designed to work with {@link RecyclerView}, but it does
  * not depend on it and can be used with other list views.
@@ -75,6 +86,14 @@ public class AsyncListUtil<T> {
 
     final SparseIntArray mMissingPositions = new SparseIntArray();
 
+    private static final int TILE_FETCH_KEEP_ALIVE_SECONDS = 5;
+
+    // Counters for seslGetPendingTileLoadCount and seslGetAverageTileLoadTimeMillis, updated from
+    // the background and tile fetch threads.
+    final AtomicInteger mPendingTileLoads = new AtomicInteger();
+    final AtomicLong mLoadedTileCount = new AtomicLong();
+    final AtomicLong mTileLoadTimeNanos = new AtomicLong();
+
     void log(String s, Object... args) {
         Log.d(TAG, "[MAIN] " + String.format(s, args));
     }
@@ -175,6 +194,32 @@ public class AsyncListUtil<T> {
         return mItemCount;
     }
 
+    /**
+     * Returns the number of tiles that are queued or being filled by parallel tile loads.
+     *
+     * @see DataCallback#seslGetMaxParallelTileLoads()
+     */
+    public int seslGetPendingTileLoadCount() {
+        return mPendingTileLoads.get();
+    }
+
+    /**
+     * Returns the average time in milliseconds between requesting a tile and its data being
+     * filled, over all the tiles loaded so far, or 0 if no tile was loaded yet.
+     */
+    public float seslGetAverageTileLoadTimeMillis() {
+        final long count = mLoadedTileCount.get();
+        if (count == 0) {
+            return 0;
+        }
+        return mTileLoadTimeNanos.get() / (count * 1000000f);
+    }
+
+    void recordTileLoad(long durationNanos) {
+        mTileLoadTimeNanos.addAndGet(durationNanos);
+        mLoadedTileCount.incrementAndGet();
+    }
+
     void updateRange() {
         mViewCallback.getItemRangeInto(mTmpRange);
         if (mTmpRange[0] > mTmpRange[1] || mTmpRange[0] < 0) {
@@ -303,10 +348,23 @@ public class AsyncListUtil<T> {
         private int mFirstRequiredTileStart;
         private int mLastRequiredTileStart;
 
+        private int mFirstVisibleTileStart;
+        private int mLastVisibleTileStart;
+        private int mScrollHint;
+
+        // Tiles being filled on mTileFetchExecutor, by start position. Only used when the data
+        // callback allows more than one parallel tile load.
+        final SparseArray<TileFetch> mFetchingTiles = new SparseArray<>();
+        private ThreadPoolExecutor mTileFetchExecutor;
+        private int mMaxParallelTileLoads;
+        private long mTileFetchSequence;
+
         @Override
         public void refresh(int generation) {
             mGeneration = generation;
             mLoadedTiles.clear();
+            // running fetches of the old generation are recycled once they deliver
+            cancelQueuedTileFetches(Integer.MAX_VALUE, Integer.MIN_VALUE);
             mItemCount = mDataCallback.refreshData();
             mMainThreadProxy.updateItemCount(mGeneration, mItemCount);
         }
@@ -328,10 +386,15 @@ public class AsyncListUtil<T> {
 
             mFirstRequiredTileStart = getTileStart(extRangeStart);
             mLastRequiredTileStart = getTileStart(extRangeEnd);
+            mFirstVisibleTileStart = firstVisibleTileStart;
+            mLastVisibleTileStart = lastVisibleTileStart;
+            mScrollHint = scrollHint;
             if (DEBUG) {
                 log("requesting tile range: %d..%d",
                         mFirstRequiredTileStart, mLastRequiredTileStart);
             }
+            // Tiles that are no longer required are not worth filling anymore.
+            cancelQueuedTileFetches(mFirstRequiredTileStart, mLastRequiredTileStart);
 
             // All pending tile requests are removed by ThreadUtil at this point.
             // Re-request all required tiles in the most optimal order.
@@ -369,14 +432,124 @@ public class AsyncListUtil<T> {
                 }
                 return;
             }
+            if (mMaxParallelTileLoads == 0) {
+                mMaxParallelTileLoads = Math.max(1, mDataCallback.seslGetMaxParallelTileLoads());
+            }
+            if (mMaxParallelTileLoads > 1) {
+                fetchTile(position);
+                return;
+            }
             TileList.Tile<T> tile = acquireTile();
             tile.mStartPosition = position;
             tile.mItemCount = Math.min(mTileSize, mItemCount - tile.mStartPosition);
+            final long startTime = System.nanoTime();
             mDataCallback.fillData(tile.mItems, tile.mStartPosition, tile.mItemCount);
+            recordTileLoad(System.nanoTime() - startTime);
             flushTileCache(scrollHint);
             addTile(tile);
         }
 
+        private void fetchTile(int position) {
+            final ThreadPoolExecutor executor = getTileFetchExecutor();
+            TileFetch fetch = mFetchingTiles.get(position);
+            if (fetch != null && fetch.mGeneration == mGeneration) {
+                // Already requested, move it to its new place in the queue unless it is running.
+                if (executor.remove(fetch)) {
+                    fetch.mDistance = getTileDistance(position);
+                    fetch.mSequence = mTileFetchSequence++;
+                    executor.execute(fetch);
+                }
+                return;
+            }
+            TileList.Tile<T> tile = acquireTile();
+            tile.mStartPosition = position;
+            tile.mItemCount = Math.min(mTileSize, mItemCount - tile.mStartPosition);
+            fetch = new TileFetch(tile, mGeneration, getTileDistance(position),
+                    mTileFetchSequence++);
+            mFetchingTiles.put(position, fetch);
+            mPendingTileLoads.incrementAndGet();
+            executor.execute(fetch);
+        }
+
+        @Override
+        public void addLoadedTile(int generation, TileList.Tile<T> tile) {
+            final int position = tile.mStartPosition;
+            final TileFetch fetch = mFetchingTiles.get(position);
+            if (fetch != null && fetch.mTile == tile) {
+                mFetchingTiles.remove(position);
+            }
+            if (generation != mGeneration || isTileLoaded(position)
+                    || position < mFirstRequiredTileStart || position > mLastRequiredTileStart) {
+                if (DEBUG) {
+                    log("dropping stale tile @%d", position);
+                }
+                recycleTile(tile);
+                return;
+            }
+            flushTileCache(mScrollHint);
+            addTile(tile);
+        }
+
+        /**
+         * Cancels the fetches that did not start yet for tiles outside of the given range. Their
+         * tiles were never filled, so they go back to the pool without recycling their data.
+         */
+        private void cancelQueuedTileFetches(int firstTileStart, int lastTileStart) {
+            if (mTileFetchExecutor == null) {
+                return;
+            }
+            for (int i = mFetchingTiles.size() - 1; i >= 0; i--) {
+                final TileFetch fetch = mFetchingTiles.valueAt(i);
+                final int position = fetch.mTile.mStartPosition;
+                if ((position < firstTileStart || position > lastTileStart)
+                        && mTileFetchExecutor.remove(fetch)) {
+                    mFetchingTiles.removeAt(i);
+                    mPendingTileLoads.decrementAndGet();
+                    fetch.mTile.mNext = mRecycledRoot;
+                    mRecycledRoot = fetch.mTile;
+                }
+            }
+        }
+
+        /**
+         * Returns how many tiles away from the visible tiles the given tile is, which is the
+         * priority of its fetch.
+         */
+        private int getTileDistance(int tileStart) {
+            if (tileStart < mFirstVisibleTileStart) {
+                return (mFirstVisibleTileStart - tileStart) / mTileSize;
+            } else if (tileStart > mLastVisibleTileStart) {
+                return (tileStart - mLastVisibleTileStart) / mTileSize;
+            }
+            return 0;
+        }
+
+        private ThreadPoolExecutor getTileFetchExecutor() {
+            if (mTileFetchExecutor == null) {
+                mTileFetchExecutor = new ThreadPoolExecutor(mMaxParallelTileLoads,
+                        mMaxParallelTileLoads, TILE_FETCH_KEEP_ALIVE_SECONDS, TimeUnit.SECONDS,
+                        new PriorityBlockingQueue<Runnable>(), new ThreadFactory() {
+                            private final AtomicInteger mCount = new AtomicInteger();
+
+                            @Override
+                            public Thread newThread(@NonNull final Runnable r) {
+                                Thread thread = new Thread(new Runnable() {
+                                    @Override
+                                    public void run() {
+                                        Process.setThreadPriority(
+                                                Process.THREAD_PRIORITY_BACKGROUND);
+                                        r.run();
+                                    }
+                                }, "AsyncListUtil #" + mCount.incrementAndGet());
+                                thread.setDaemon(true);
+                                return thread;
+                            }
+                        });
+                mTileFetchExecutor.allowCoreThreadTimeOut(true);
+            }
+            return mTileFetchExecutor;
+        }
+
         @Override
         public void recycleTile(TileList.Tile<T> tile) {
             if (DEBUG) {
@@ -442,6 +615,42 @@ public class AsyncListUtil<T> {
         }
     };
 
+    /**
+     * Fills a single tile on a tile fetch thread and hands it back to the background thread,
+     * which owns all the tile bookkeeping. Queued fetches are ordered by their distance to the
+     * visible range and then by request order.
+     */
+    final class TileFetch implements Runnable, Comparable<TileFetch> {
+        final TileList.Tile<T> mTile;
+        final int mGeneration;
+        final long mRequestTimeNanos = System.nanoTime();
+        int mDistance;
+        long mSequence;
+
+        TileFetch(TileList.Tile<T> tile, int generation, int distance, long sequence) {
+            mTile = tile;
+            mGeneration = generation;
+            mDistance = distance;
+            mSequence = sequence;
+        }
+
+        @Override
+        public void run() {
+            mDataCallback.fillData(mTile.mItems, mTile.mStartPosition, mTile.mItemCount);
+            recordTileLoad(System.nanoTime() - mRequestTimeNanos);
+            mPendingTileLoads.decrementAndGet();
+            mBackgroundProxy.addLoadedTile(mGeneration, mTile);
+        }
+
+        @Override
+        public int compareTo(TileFetch other) {
+            if (mDistance != other.mDistance) {
+                return mDistance < other.mDistance ? -1 : 1;
+            }
+            return mSequence < other.mSequence ? -1 : (mSequence == other.mSequence ? 0 : 1);
+        }
+    }
+
     /**
      * The callback that provides data access for {@link AsyncListUtil}.
      *
@@ -510,6 +719,27 @@ public class AsyncListUtil<T> {
         public int getMaxCachedTiles() {
             return 10;
         }
+
+        /**
+         * Returns how many tiles may be filled at the same time.
+         *
+         * <p>
+         * If this returns more than 1, {@link #fillData} is called concurrently from that many
+         * worker threads and must be thread safe. Pending tiles are filled in the order of their
+         * distance to the visible range, and tiles that leave the range returned by
+         * {@link ViewCallback#extendRangeInto(int[], int[], int)} before they start loading are
+         * dropped. All the other methods are still called on the single background thread, and
+         * {@link #recycleData} is never called for a tile that is being filled.
+         * <p>
+         * This is queried once, before the first tile is loaded. The default implementation
+         * returns 1.
+         *
+         * @return Maximum number of tiles filled in parallel.
+         */
+        @WorkerThread
+        public int seslGetMaxParallelTileLoads() {
+            return 1;
+        }
     }
 
     /**
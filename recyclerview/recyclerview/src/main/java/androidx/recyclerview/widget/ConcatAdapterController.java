@@ -37,6 +37,7 @@ import androidx.recyclerview.widget.RecyclerView.ViewHolder;
 
 import java.lang.ref.WeakReference;
 import java.util.ArrayList;
+import java.util.Arrays;
 import java.util.Collections;
 import java.util.IdentityHashMap;
 import java.util.List;
@@ -69,6 +70,19 @@ class ConcatAdapterController implements NestedAdapterWrapper.Callback {
 
     private List<NestedAdapterWrapper> mWrappers = new ArrayList<>();
 
+    /**
+     * Prefix sums of the item counts: {@code mItemOffsets[i]} is the number of items before
+     * {@code mWrappers.get(i)} and the last entry is the total count. A count change only
+     * invalidates the entries after its wrapper, which are rebuilt lazily, so a batch of
+     * notify events from one adapter maps its positions in constant time.
+     */
+    private int[] mItemOffsets = new int[1];
+
+    /**
+     * Number of leading entries of {@link #mItemOffsets} that are up to date.
+     */
+    private int mValidOffsetCount = 1;
+
     // keep one of these around so that we can return wrapper & position w/o allocation ¯\_(ツ)_/¯
     private WrapperAndLocalPosition mReusableHolder = new WrapperAndLocalPosition();
 
@@ -161,6 +175,7 @@ class ConcatAdapterController implements NestedAdapterWrapper.Callback {
         NestedAdapterWrapper wrapper = new NestedAdapterWrapper(adapter, this,
                 mViewTypeStorage, mStableIdStorage.createStableIdLookup());
         mWrappers.add(index, wrapper);
+        onWrappersChanged(index);
         // notify attach for all recyclerview
         for (WeakReference<RecyclerView> reference : mAttachedRecyclerViews) {
             RecyclerView recyclerView = reference.get();
@@ -188,6 +203,7 @@ class ConcatAdapterController implements NestedAdapterWrapper.Callback {
         NestedAdapterWrapper wrapper = mWrappers.get(index);
         int offset = countItemsBefore(wrapper);
         mWrappers.remove(index);
+        onWrappersChanged(index);
         mConcatAdapter.notifyItemRangeRemoved(offset, wrapper.getCachedItemCount());
         // notify detach for all recyclerviews
         for (WeakReference<RecyclerView> reference : mAttachedRecyclerViews) {
@@ -202,15 +218,41 @@ class ConcatAdapterController implements NestedAdapterWrapper.Callback {
     }
 
     private int countItemsBefore(NestedAdapterWrapper wrapper) {
-        int count = 0;
-        for (NestedAdapterWrapper item : mWrappers) {
-            if (item != wrapper) {
-                count += item.getCachedItemCount();
-            } else {
-                break;
+        return getItemOffset(wrapper.mWrapperIndex);
+    }
+
+    /**
+     * Renumbers the wrappers from the given index on, after one was added or removed there.
+     */
+    private void onWrappersChanged(int fromIndex) {
+        final int count = mWrappers.size();
+        for (int i = fromIndex; i < count; i++) {
+            mWrappers.get(i).mWrapperIndex = i;
+        }
+        if (mItemOffsets.length < count + 1) {
+            mItemOffsets = Arrays.copyOf(mItemOffsets, Math.max(count + 1,
+                    mItemOffsets.length * 2));
+        }
+        invalidateItemOffsetsAfter(fromIndex - 1);
+    }
+
+    /**
+     * Called when the item count of the wrapper at the given index changed.
+     */
+    private void invalidateItemOffsetsAfter(int wrapperIndex) {
+        // entry 0 is always 0, so it stays valid
+        mValidOffsetCount = Math.max(1, Math.min(mValidOffsetCount, wrapperIndex + 1));
+    }
+
+    private int getItemOffset(int wrapperIndex) {
+        if (wrapperIndex >= mValidOffsetCount) {
+            for (int i = mValidOffsetCount; i <= wrapperIndex; i++) {
+                mItemOffsets[i] = mItemOffsets[i - 1]
+                        + mWrappers.get(i - 1).getCachedItemCount();
             }
+            mValidOffsetCount = wrapperIndex + 1;
         }
-        return count;
+        return mItemOffsets[wrapperIndex];
     }
 
     public long getItemId(int globalPosition) {
@@ -222,6 +264,7 @@ class ConcatAdapterController implements NestedAdapterWrapper.Callback {
 
     @Override
     public void onChanged(@NonNull NestedAdapterWrapper wrapper) {
+        invalidateItemOffsetsAfter(wrapper.mWrapperIndex);
         // TODO should we notify more cleverly, maybe in v2
         mConcatAdapter.notifyDataSetChanged();
         calculateAndUpdateStateRestorationPolicy();
@@ -252,6 +295,7 @@ class ConcatAdapterController implements NestedAdapterWrapper.Callback {
     public void onItemRangeInserted(@NonNull NestedAdapterWrapper nestedAdapterWrapper,
             int positionStart, int itemCount) {
         final int offset = countItemsBefore(nestedAdapterWrapper);
+        invalidateItemOffsetsAfter(nestedAdapterWrapper.mWrapperIndex);
         mConcatAdapter.notifyItemRangeInserted(
                 positionStart + offset,
                 itemCount
@@ -262,6 +306,7 @@ class ConcatAdapterController implements NestedAdapterWrapper.Callback {
     public void onItemRangeRemoved(@NonNull NestedAdapterWrapper nestedAdapterWrapper,
             int positionStart, int itemCount) {
         int offset = countItemsBefore(nestedAdapterWrapper);
+        invalidateItemOffsetsAfter(nestedAdapterWrapper.mWrapperIndex);
         mConcatAdapter.notifyItemRangeRemoved(
                 positionStart + offset,
                 itemCount
@@ -306,12 +351,7 @@ class ConcatAdapterController implements NestedAdapterWrapper.Callback {
     }
 
     public int getTotalCount() {
-        // should we cache this as well ?
-        int total = 0;
-        for (NestedAdapterWrapper wrapper : mWrappers) {
-            total += wrapper.getCachedItemCount();
-        }
-        return total;
+        return getItemOffset(mWrappers.size());
     }
 
     public int getItemViewType(int globalPosition) {
@@ -350,14 +390,22 @@ class ConcatAdapterController implements NestedAdapterWrapper.Callback {
             mReusableHolder.mInUse = true;
             result = mReusableHolder;
         }
-        int localPosition = globalPosition;
-        for (NestedAdapterWrapper wrapper : mWrappers) {
-            if (wrapper.getCachedItemCount() > localPosition) {
-                result.mWrapper = wrapper;
-                result.mLocalPosition = localPosition;
-                break;
+        final int wrapperCount = mWrappers.size();
+        if (wrapperCount > 0 && globalPosition < getTotalCount()) {
+            // find the last wrapper that starts at or before the position, skipping the empty
+            // wrappers that start at the same position
+            int low = 0;
+            int high = wrapperCount - 1;
+            while (low < high) {
+                final int mid = (low + high + 1) >>> 1;
+                if (mItemOffsets[mid] <= globalPosition) {
+                    low = mid;
+                } else {
+                    high = mid - 1;
+                }
             }
-            localPosition -= wrapper.getCachedItemCount();
+            result.mWrapper = mWrappers.get(low);
+            result.mLocalPosition = globalPosition - mItemOffsets[low];
         }
         if (result.mWrapper == null) {
             throw new IllegalArgumentException("Cannot find wrapper for " + globalPosition);
@@ -26,8 +26,11 @@ import java.util.Arrays;
 import java.util.Collection;
 import java.util.Collections;
 import java.util.Comparator;
+import java.util.HashMap;
 import java.util.Iterator;
 import java.util.List;
+import java.util.concurrent.Executor;
+import java.util.concurrent.RejectedExecutionException;
 
 /**
  * DiffUtil is a utility class that calculates the difference between two lists and outputs a
@@ -84,6 +87,13 @@ public class DiffUtil {
         // utility class, no instance.
     }
 
+    /**
+     * Ranges smaller than this (old plus new size) are solved on the thread that found them
+     * rather than being handed to other workers, see
+     * {@link #calculateDiff(Callback, boolean, Executor)}.
+     */
+    private static final int PARALLEL_MIN_RANGE_SIZE = 512;
+
     private static final Comparator<Diagonal> DIAGONAL_COMPARATOR = new Comparator<Diagonal>() {
         @Override
         public int compare(Diagonal o1, Diagonal o2) {
@@ -179,6 +189,292 @@ public class DiffUtil {
                 detectMoves);
     }
 
+    /**
+     * Calculates the list of update operations that can covert one list into the other one,
+     * optionally spreading the work over an executor.
+     * <p>
+     * Unlike {@link #calculateDiff(Callback, boolean)}, this first trims the common prefix and
+     * suffix of both lists, so an update that only touches a few rows of a large list runs
+     * Myers' algorithm over the changed region only. If {@code executor} is not null, the
+     * remaining region is split into independent ranges at each middle snake and the ranges are
+     * solved in parallel. The calling thread takes part in the work and does not depend on the
+     * executor running any task, so it is safe to call this from a thread of {@code executor}.
+     * <p>
+     * If {@link Callback#hasStableIds()} returns true, Myers' algorithm is skipped: items are
+     * paired by id in one pass, the longest increasing run of pairs is kept in place and every
+     * other pair is reported as a move, which takes O(N log N) time and makes move detection
+     * linear.
+     * <p>
+     * When an executor is given, {@link Callback#areItemsTheSame(int, int)} may be called
+     * concurrently from several threads. If more than one minimal edit script exists, the result
+     * may pick a different one than {@link #calculateDiff(Callback, boolean)}.
+     *
+     * @param cb          The callback that acts as a gateway to the backing list data
+     * @param detectMoves True if DiffUtil should try to detect moved items, false otherwise.
+     * @param executor    Executor to solve independent ranges on, or null to run on the calling
+     *                    thread only
+     * @return A DiffResult that contains the information about the edit sequence to convert the
+     * old list into the new list.
+     */
+    @NonNull
+    public static DiffResult calculateDiff(@NonNull Callback cb, boolean detectMoves,
+            @Nullable Executor executor) {
+        final int oldSize = cb.getOldListSize();
+        final int newSize = cb.getNewListSize();
+
+        final List<Diagonal> diagonals = new ArrayList<>();
+
+        // trim the common prefix and suffix, they are always part of a minimal edit script
+        final int minSize = Math.min(oldSize, newSize);
+        int prefix = 0;
+        while (prefix < minSize && cb.areItemsTheSame(prefix, prefix)) {
+            prefix++;
+        }
+        int suffix = 0;
+        while (suffix < minSize - prefix
+                && cb.areItemsTheSame(oldSize - suffix - 1, newSize - suffix - 1)) {
+            suffix++;
+        }
+        if (prefix > 0) {
+            diagonals.add(new Diagonal(0, 0, prefix));
+        }
+        final Range middle = new Range(prefix, oldSize - suffix, prefix, newSize - suffix);
+
+        int[] oldToNew = null;
+        if (cb.hasStableIds()) {
+            oldToNew = new int[oldSize];
+            Arrays.fill(oldToNew, DiffResult.NO_POSITION);
+            findStableIdDiagonals(middle, cb, oldToNew, diagonals);
+        } else if (executor == null
+                || middle.oldSize() + middle.newSize() < PARALLEL_MIN_RANGE_SIZE) {
+            findDiagonals(middle, cb, diagonals);
+        } else {
+            new ParallelDiffer(cb, executor).solve(middle, diagonals);
+        }
+        if (suffix > 0) {
+            diagonals.add(new Diagonal(oldSize - suffix, newSize - suffix, suffix));
+        }
+        // sort snakes
+        Collections.sort(diagonals, DIAGONAL_COMPARATOR);
+
+        return new DiffResult(cb, diagonals, new int[oldSize], new int[newSize], detectMoves,
+                oldToNew);
+    }
+
+    /**
+     * Runs Myers' algorithm over the given range on the calling thread, adding the diagonals
+     * found to {@code out}. The range is consumed.
+     */
+    private static void findDiagonals(Range range, Callback cb, List<Diagonal> out) {
+        final int max = (range.oldSize() + range.newSize() + 1) / 2;
+        final CenteredArray forward = new CenteredArray(max * 2 + 1);
+        final CenteredArray backward = new CenteredArray(max * 2 + 1);
+        final List<Range> stack = new ArrayList<>();
+        stack.add(range);
+        while (!stack.isEmpty()) {
+            final Range current = stack.remove(stack.size() - 1);
+            final Snake snake = midPoint(current, cb, forward, backward);
+            if (snake != null) {
+                if (snake.diagonalSize() > 0) {
+                    out.add(snake.toDiagonal());
+                }
+                stack.add(new Range(current.oldListStart, snake.startX,
+                        current.newListStart, snake.startY));
+                current.oldListStart = snake.endX;
+                current.newListStart = snake.endY;
+                stack.add(current);
+            }
+        }
+    }
+
+    /**
+     * Pairs items of the given range by stable id and adds the longest increasing run of pairs
+     * as diagonals to {@code out}. All pairs, including the ones that are not part of the run,
+     * are recorded in {@code oldToNew} so that moves can be matched without searching.
+     */
+    private static void findStableIdDiagonals(Range range, Callback cb, int[] oldToNew,
+            List<Diagonal> out) {
+        final HashMap<Long, Integer> newPositions = new HashMap<>(range.newSize() * 4 / 3 + 1);
+        for (int y = range.newListStart; y < range.newListEnd; y++) {
+            final Long id = cb.getNewItemId(y);
+            if (!newPositions.containsKey(id)) {
+                newPositions.put(id, y);
+            }
+        }
+        // tails[i] is the old position ending the best increasing run of length i + 1
+        final int[] tails = new int[range.oldSize()];
+        final int[] previous = new int[range.oldSize()];
+        int length = 0;
+        for (int x = range.oldListStart; x < range.oldListEnd; x++) {
+            final Integer y = newPositions.get(cb.getOldItemId(x));
+            if (y == null) {
+                continue;
+            }
+            oldToNew[x] = y;
+            int low = 0;
+            int high = length;
+            while (low < high) {
+                final int mid = (low + high) >>> 1;
+                if (oldToNew[tails[mid]] < y) {
+                    low = mid + 1;
+                } else {
+                    high = mid;
+                }
+            }
+            previous[x - range.oldListStart] = low > 0 ? tails[low - 1] : -1;
+            tails[low] = x;
+            if (low == length) {
+                length++;
+            }
+        }
+        // walk the run backwards, merging consecutive pairs into a single diagonal
+        int x = length > 0 ? tails[length - 1] : -1;
+        int size = 0;
+        while (x != -1) {
+            final int prev = previous[x - range.oldListStart];
+            size++;
+            if (prev == -1 || prev != x - 1 || oldToNew[prev] != oldToNew[x] - 1) {
+                out.add(new Diagonal(x, oldToNew[x], size));
+                size = 0;
+            }
+            x = prev;
+        }
+    }
+
+    /**
+     * Solves the independent ranges of a diff concurrently.
+     * <p>
+     * Ranges are shared through a queue that the calling thread drains as well, so the diff
+     * completes even if none of the helper tasks get to run, e.g. when it is calculated on a
+     * saturated thread of the same executor. Small ranges stay on the thread that found them.
+     */
+    private static final class ParallelDiffer implements Runnable {
+        private final Callback mCallback;
+        private final Executor mExecutor;
+        private final ArrayDeque<Range> mQueue = new ArrayDeque<>();
+        private final List<Diagonal> mDiagonals = new ArrayList<>();
+        private int mActiveWorkers;
+        private RuntimeException mError;
+
+        ParallelDiffer(Callback callback, Executor executor) {
+            mCallback = callback;
+            mExecutor = executor;
+        }
+
+        void solve(Range range, List<Diagonal> out) {
+            mQueue.add(range);
+            final int helperCount = Math.max(1, Runtime.getRuntime().availableProcessors() - 1);
+            for (int i = 0; i < helperCount; i++) {
+                try {
+                    mExecutor.execute(this);
+                } catch (RejectedExecutionException e) {
+                    break;
+                }
+            }
+            do {
+                work();
+            } while (awaitRange());
+            synchronized (this) {
+                if (mError != null) {
+                    throw mError;
+                }
+                out.addAll(mDiagonals);
+            }
+        }
+
+        @Override
+        public void run() {
+            // helpers start while the queue holds the first range only, so they keep waiting
+            // for the ranges split off by the other workers until all of them are done
+            do {
+                work();
+            } while (awaitRange());
+        }
+
+        /**
+         * Waits while the queue is empty and another worker may still add ranges to it.
+         *
+         * @return true if there is a range to solve, false if all ranges are solved or one of
+         * them failed
+         */
+        private synchronized boolean awaitRange() {
+            boolean interrupted = false;
+            while (mError == null && mActiveWorkers > 0 && mQueue.isEmpty()) {
+                try {
+                    wait();
+                } catch (InterruptedException e) {
+                    interrupted = true;
+                }
+            }
+            if (interrupted) {
+                Thread.currentThread().interrupt();
+            }
+            return mError == null && !mQueue.isEmpty();
+        }
+
+        private void work() {
+            final List<Range> stack = new ArrayList<>();
+            final List<Diagonal> diagonals = new ArrayList<>();
+            CenteredArray forward = null;
+            CenteredArray backward = null;
+            while (true) {
+                final Range range;
+                synchronized (this) {
+                    range = mError == null ? mQueue.poll() : null;
+                    if (range == null) {
+                        return;
+                    }
+                    mActiveWorkers++;
+                }
+                final int size = (range.oldSize() + range.newSize() + 1) / 2 * 2 + 1;
+                if (forward == null || forward.backingData().length < size) {
+                    forward = new CenteredArray(size);
+                    backward = new CenteredArray(size);
+                }
+                RuntimeException error = null;
+                try {
+                    stack.add(range);
+                    while (!stack.isEmpty()) {
+                        final Range current = stack.remove(stack.size() - 1);
+                        final Snake snake = midPoint(current, mCallback, forward, backward);
+                        if (snake == null) {
+                            continue;
+                        }
+                        if (snake.diagonalSize() > 0) {
+                            diagonals.add(snake.toDiagonal());
+                        }
+                        final Range left = new Range(current.oldListStart, snake.startX,
+                                current.newListStart, snake.startY);
+                        stack.add(left);
+                        current.oldListStart = snake.endX;
+                        current.newListStart = snake.endY;
+                        if (current.oldSize() + current.newSize() >= PARALLEL_MIN_RANGE_SIZE) {
+                            // large enough to be worth handing over to an idle worker
+                            synchronized (this) {
+                                mQueue.add(current);
+                                notifyAll();
+                            }
+                        } else {
+                            stack.add(current);
+                        }
+                    }
+                } catch (RuntimeException e) {
+                    error = e;
+                    stack.clear();
+                }
+                synchronized (this) {
+                    mDiagonals.addAll(diagonals);
+                    if (error != null && mError == null) {
+                        mError = error;
+                    }
+                    mActiveWorkers--;
+                    notifyAll();
+                }
+                diagonals.clear();
+            }
+        }
+    }
+
     /**
      * Finds a middle snake in the given range.
      */
@@ -395,6 +691,42 @@ public class DiffUtil {
         public Object getChangePayload(int oldItemPosition, int newItemPosition) {
             return null;
         }
+
+        /**
+         * Returns true if every item in both lists has a unique, stable id returned by
+         * {@link #getOldItemId(int)} and {@link #getNewItemId(int)}, and two items have the same
+         * id exactly when {@link #areItemsTheSame(int, int)} returns true for them.
+         * <p>
+         * {@link DiffUtil#calculateDiff(Callback, boolean, Executor)} uses the ids to skip Myers'
+         * algorithm. Default implementation returns {@code false}.
+         *
+         * @return True if the ids of this callback can be used to pair items.
+         */
+        public boolean hasStableIds() {
+            return false;
+        }
+
+        /**
+         * Returns the stable id of the item at the given position of the old list. Only called
+         * if {@link #hasStableIds()} returns true.
+         *
+         * @param oldItemPosition The position of the item in the old list
+         * @return The stable id of the item.
+         */
+        public long getOldItemId(int oldItemPosition) {
+            return RecyclerView.NO_ID;
+        }
+
+        /**
+         * Returns the stable id of the item at the given position of the new list. Only called
+         * if {@link #hasStableIds()} returns true.
+         *
+         * @param newItemPosition The position of the item in the new list
+         * @return The stable id of the item.
+         */
+        public long getNewItemId(int newItemPosition) {
+            return RecyclerView.NO_ID;
+        }
     }
 
     /**
@@ -653,6 +985,11 @@ public class DiffUtil {
 
         private final boolean mDetectMoves;
 
+        // Old to new positions paired by stable id, if the diff was calculated from ids. Used to
+        // match moves without searching.
+        @Nullable
+        private final int[] mOldToNewMatches;
+
         /**
          * @param callback        The callback that was used to calculate the diff
          * @param diagonals       Matches between the two lists
@@ -662,6 +999,15 @@ public class DiffUtil {
          */
         DiffResult(Callback callback, List<Diagonal> diagonals, int[] oldItemStatuses,
                 int[] newItemStatuses, boolean detectMoves) {
+            this(callback, diagonals, oldItemStatuses, newItemStatuses, detectMoves, null);
+        }
+
+        /**
+         * @param oldToNewMatches Old to new positions paired by stable id, or null
+         */
+        DiffResult(Callback callback, List<Diagonal> diagonals, int[] oldItemStatuses,
+                int[] newItemStatuses, boolean detectMoves, @Nullable int[] oldToNewMatches) {
+            mOldToNewMatches = oldToNewMatches;
             mDiagonals = diagonals;
             mOldItemStatuses = oldItemStatuses;
             mNewItemStatuses = newItemStatuses;
@@ -735,6 +1081,18 @@ public class DiffUtil {
          * @param posX position in the old list
          */
         private void findMatchingAddition(int posX) {
+            if (mOldToNewMatches != null) {
+                // items were already paired by stable id
+                final int matchY = mOldToNewMatches[posX];
+                if (matchY != NO_POSITION && mNewItemStatuses[matchY] == 0) {
+                    boolean contentsMatching = mCallback.areContentsTheSame(posX, matchY);
+                    final int changeFlag = contentsMatching ? FLAG_MOVED_NOT_CHANGED
+                            : FLAG_MOVED_CHANGED;
+                    mOldItemStatuses[posX] = (matchY << FLAG_OFFSET) | changeFlag;
+                    mNewItemStatuses[matchY] = (posX << FLAG_OFFSET) | changeFlag;
+                }
+                return;
+            }
             int posY = 0;
             final int diagonalsSize = mDiagonals.size();
             for (int i = 0; i < diagonalsSize; i++) {
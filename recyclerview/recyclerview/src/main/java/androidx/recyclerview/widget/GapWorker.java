@@ -16,32 +16,101 @@
 package androidx.recyclerview.widget;
 
 import android.annotation.SuppressLint;
+import android.os.Handler;
+import android.os.Looper;
+import android.os.Process;
 import android.os.Trace;
+import android.util.Log;
+import android.view.Choreographer;
 import android.view.View;
 
+import androidx.annotation.NonNull;
 import androidx.annotation.Nullable;
 import androidx.core.os.TraceCompat;
 
+import java.lang.ref.WeakReference;
 import java.util.ArrayList;
 import java.util.Arrays;
 import java.util.Collections;
 import java.util.Comparator;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.ThreadFactory;
 import java.util.concurrent.TimeUnit;
+import java.util.concurrent.atomic.AtomicInteger;
 
 final class GapWorker implements Runnable {
 
     static final ThreadLocal<GapWorker> sGapWorker = new ThreadLocal<>();
 
+    private static final String TAG = "GapWorker";
+
+    /**
+     * Maximum number of consecutive frames an async prefetch pass may be carried over when its
+     * work did not fit into the frame gap it was scheduled in.
+     */
+    static final int MAX_ASYNC_PREFETCH_FRAMES = 4;
+
+    private static final int BACKGROUND_CREATE_THREAD_COUNT = 2;
+
+    private static final Object sBackgroundCreateLock = new Object();
+    private static ExecutorService sBackgroundCreateExecutor;
+
     ArrayList<RecyclerView> mRecyclerViews = new ArrayList<>();
     long mPostTimeNs;
     long mFrameIntervalNs;
 
+    /**
+     * Vsync time of the latest frame as reported by {@link Choreographer}, in the
+     * {@link System#nanoTime()} time base. Only tracked while an async prefetching view is
+     * scrolling: reset to 0 when a prefetch pass ends without carrying work over, and set again
+     * by the frame callback the next traversal posts.
+     */
+    long mLastVsyncNs;
+
+    /**
+     * Set during a prefetch pass when a task of an async prefetching view was skipped or missed
+     * its deadline, and should be retried in the next frame gap instead of being dropped.
+     */
+    boolean mHasDeferredWork;
+
+    /**
+     * Number of frames the current async prefetch pass may still be carried over.
+     */
+    int mAsyncFramesRemaining;
+
+    private boolean mFrameCallbackPosted;
+
+    private final Handler mHandler = new Handler(Looper.myLooper() != null
+            ? Looper.myLooper() : Looper.getMainLooper());
+
+    private final Choreographer.FrameCallback mFrameCallback = new Choreographer.FrameCallback() {
+        @Override
+        public void doFrame(long frameTimeNanos) {
+            mFrameCallbackPosted = false;
+            mLastVsyncNs = frameTimeNanos;
+            if (mHasDeferredWork && mPostTimeNs == 0) {
+                // Continue the carried over pass after this frame's traversal
+                RecyclerView view = findAsyncPrefetchView();
+                if (view != null) {
+                    mPostTimeNs = view.getNanoTime();
+                    view.post(GapWorker.this);
+                } else {
+                    mHasDeferredWork = false;
+                    mLastVsyncNs = 0;
+                }
+            }
+        }
+    };
+
     static class Task {
         public boolean neededNextFrame;
         public int viewVelocity;
         public int distanceToItem;
         public RecyclerView view;
         public int position;
+        public int viewType;
+        public int viewTypeCost;
 
         public void clear() {
             neededNextFrame = false;
@@ -49,6 +118,8 @@ final class GapWorker implements Runnable {
             distanceToItem = 0;
             view = null;
             position = 0;
+            viewType = 0;
+            viewTypeCost = 0;
         }
     }
 
@@ -169,6 +240,30 @@ final class GapWorker implements Runnable {
         if (RecyclerView.sDebugAssertionsEnabled && !removeSuccess) {
             throw new IllegalStateException("RecyclerView removal failed!");
         }
+        if (findAsyncPrefetchView() == null) {
+            mHasDeferredWork = false;
+            mAsyncFramesRemaining = 0;
+            mLastVsyncNs = 0;
+        }
+    }
+
+    @Nullable
+    private RecyclerView findAsyncPrefetchView() {
+        for (int i = 0; i < mRecyclerViews.size(); i++) {
+            RecyclerView view = mRecyclerViews.get(i);
+            if (view.mAsyncPrefetchEnabled && view.isAttachedToWindow()
+                    && view.getWindowVisibility() == View.VISIBLE) {
+                return view;
+            }
+        }
+        return null;
+    }
+
+    private void postFrameCallback() {
+        if (!mFrameCallbackPosted) {
+            mFrameCallbackPosted = true;
+            Choreographer.getInstance().postFrameCallback(mFrameCallback);
+        }
     }
 
     /**
@@ -183,6 +278,11 @@ final class GapWorker implements Runnable {
                 mPostTimeNs = recyclerView.getNanoTime();
                 recyclerView.post(this);
             }
+            if (recyclerView.mAsyncPrefetchEnabled) {
+                // new scroll input restarts the multi-frame budget, and keeps vsync tracked
+                mAsyncFramesRemaining = MAX_ASYNC_PREFETCH_FRAMES;
+                postFrameCallback();
+            }
         }
 
         recyclerView.mPrefetchRegistry.setPrefetchVector(prefetchDx, prefetchDy);
@@ -201,6 +301,10 @@ final class GapWorker implements Runnable {
                 return lhs.neededNextFrame ? -1 : 1;
             }
 
+            // then prioritize view types the adapter reports as most expensive
+            int deltaViewTypeCost = rhs.viewTypeCost - lhs.viewTypeCost;
+            if (deltaViewTypeCost != 0) return deltaViewTypeCost;
+
             // then prioritize _highest_ view velocity
             int deltaViewVelocity = rhs.viewVelocity - lhs.viewVelocity;
             if (deltaViewVelocity != 0) return deltaViewVelocity;
@@ -253,6 +357,13 @@ final class GapWorker implements Runnable {
                 task.distanceToItem = distanceToItem;
                 task.view = view;
                 task.position = prefetchRegistry.mPrefetchArray[j];
+                if (view.mAsyncPrefetchEnabled) {
+                    // adapter has no pending updates here, so positions map directly to types
+                    final RecyclerView.Adapter<?> adapter = view.mAdapter;
+                    task.viewType = adapter.getItemViewType(task.position);
+                    task.viewTypeCost = adapter.seslGetViewTypePrefetchCost(task.viewType);
+                    maybeCreateInBackground(view, task.viewType);
+                }
 
                 totalTaskIndex++;
             }
@@ -291,6 +402,7 @@ final class GapWorker implements Runnable {
                 Trace.beginSection("RV Prefetch forced - needed next frame");
             }
             view.onEnterLayoutOrScroll();
+            view.mPrefetchInProgress = true;
             holder = recycler.tryGetViewHolderForPositionByDeadline(
                     position, false, deadlineNs);
 
@@ -298,6 +410,7 @@ final class GapWorker implements Runnable {
                 if (holder.isBound() && !holder.isInvalid()) {
                     // Only give the view a chance to go into the cache if binding succeeded
                     // Note that we must use public method, since item may need cleanup
+                    holder.mPrefetched = true;
                     recycler.recycleView(holder.itemView);
                 } else {
                     // Didn't bind, so we can't cache the view, but it will stay in the pool until
@@ -308,6 +421,7 @@ final class GapWorker implements Runnable {
                 }
             }
         } finally {
+            view.mPrefetchInProgress = false;
             view.onExitLayoutOrScroll(false);
             Trace.endSection();
         }
@@ -350,9 +464,24 @@ final class GapWorker implements Runnable {
     }
 
     private void flushTaskWithDeadline(Task task, long deadlineNs) {
+        final boolean async = task.view.mAsyncPrefetchEnabled;
+        if (async && !task.neededNextFrame) {
+            final RecyclerView.RecycledViewPool pool = task.view.getRecycledViewPool();
+            if (pool.getRecycledViewCount(task.viewType) == 0
+                    && pool.hasPendingBackgroundCreate(task.viewType)) {
+                // a holder is being created off the UI thread, bind it in a later frame
+                mHasDeferredWork = true;
+                return;
+            }
+        }
         long taskDeadlineNs = task.neededNextFrame ? RecyclerView.FOREVER_NS : deadlineNs;
         RecyclerView.ViewHolder holder = prefetchPositionWithDeadline(task.view,
                 task.position, taskDeadlineNs);
+        if (async && (holder == null || !holder.isBound() || holder.isInvalid())
+                && !isPrefetchPositionAttached(task.view, task.position)) {
+            // missed the deadline - retry in the next frame gap rather than dropping the work
+            mHasDeferredWork = true;
+        }
         if (holder != null
                 && holder.mNestedRecyclerView != null
                 && holder.isBound()
@@ -373,10 +502,125 @@ final class GapWorker implements Runnable {
     }
 
     void prefetch(long deadlineNs) {
+        mHasDeferredWork = false;
         buildTaskList();
         flushTasksWithDeadline(deadlineNs);
     }
 
+    /**
+     * Schedules creation of a ViewHolder of the given type on the background create executor, if
+     * the adapter allows it and the view's pool has no holder of that type available or pending.
+     * The created holder is handed to the pool on the UI thread, where the next prefetch pass
+     * picks it up and only needs to bind it.
+     */
+    private void maybeCreateInBackground(RecyclerView view, int viewType) {
+        final RecyclerView.Adapter<?> adapter = view.mAdapter;
+        if (!adapter.seslIsViewTypeCreatableInBackground(viewType)) {
+            return;
+        }
+        final RecyclerView.RecycledViewPool pool = view.getRecycledViewPool();
+        if (pool.getRecycledViewCount(viewType) > 0 || pool.hasPendingBackgroundCreate(viewType)) {
+            return;
+        }
+        pool.setPendingBackgroundCreate(viewType, true);
+        getBackgroundCreateExecutor().execute(
+                new BackgroundCreateTask(this, view, adapter, pool, viewType));
+    }
+
+    void onBackgroundCreateFinished(@NonNull RecyclerView view,
+            @NonNull RecyclerView.Adapter<?> adapter, @NonNull RecyclerView.RecycledViewPool pool,
+            int viewType, @Nullable RecyclerView.ViewHolder holder, long createTimeNs) {
+        pool.setPendingBackgroundCreate(viewType, false);
+        if (holder == null) {
+            return;
+        }
+        if (view.mAdapter != adapter || view.getRecycledViewPool() != pool) {
+            // adapter or pool swapped while creating, holder no longer matches
+            return;
+        }
+        RecyclerView innerView = RecyclerView.findNestedRecyclerView(holder.itemView);
+        if (innerView != null) {
+            holder.mNestedRecyclerView = new WeakReference<>(innerView);
+        }
+        pool.factorInCreateTime(viewType, createTimeNs);
+        pool.putRecycledView(holder);
+        if (mAsyncFramesRemaining > 0) {
+            mHasDeferredWork = true;
+            postFrameCallback();
+        }
+    }
+
+    private static ExecutorService getBackgroundCreateExecutor() {
+        synchronized (sBackgroundCreateLock) {
+            if (sBackgroundCreateExecutor == null) {
+                sBackgroundCreateExecutor = Executors.newFixedThreadPool(
+                        BACKGROUND_CREATE_THREAD_COUNT, new ThreadFactory() {
+                            private final AtomicInteger mCount = new AtomicInteger();
+
+                            @Override
+                            public Thread newThread(@NonNull final Runnable r) {
+                                Thread thread = new Thread(new Runnable() {
+                                    @Override
+                                    public void run() {
+                                        Process.setThreadPriority(
+                                                Process.THREAD_PRIORITY_BACKGROUND);
+                                        r.run();
+                                    }
+                                }, "RV Prefetch #" + mCount.incrementAndGet());
+                                thread.setDaemon(true);
+                                return thread;
+                            }
+                        });
+            }
+            return sBackgroundCreateExecutor;
+        }
+    }
+
+    /**
+     * Creates a single ViewHolder off the UI thread and posts it back to the owning GapWorker.
+     */
+    private static final class BackgroundCreateTask implements Runnable {
+        final GapWorker mWorker;
+        final RecyclerView mView;
+        final RecyclerView.Adapter<?> mAdapter;
+        final RecyclerView.RecycledViewPool mPool;
+        final int mViewType;
+
+        BackgroundCreateTask(GapWorker worker, RecyclerView view, RecyclerView.Adapter<?> adapter,
+                RecyclerView.RecycledViewPool pool, int viewType) {
+            mWorker = worker;
+            mView = view;
+            mAdapter = adapter;
+            mPool = pool;
+            mViewType = viewType;
+        }
+
+        @Override
+        public void run() {
+            RecyclerView.ViewHolder created = null;
+            final long start = System.nanoTime();
+            try {
+                Trace.beginSection(RecyclerView.TRACE_BACKGROUND_CREATE_VIEW_TAG);
+                created = mAdapter.createViewHolder(mView, mViewType);
+            } catch (RuntimeException e) {
+                // not actually safe to create off the UI thread, fall back to regular prefetch
+                Log.w(TAG, "Failed to create ViewHolder of type " + mViewType
+                        + " in background", e);
+            } finally {
+                Trace.endSection();
+            }
+            final long createTimeNs = System.nanoTime() - start;
+            final RecyclerView.ViewHolder holder = created;
+            mWorker.mHandler.post(new Runnable() {
+                @Override
+                public void run() {
+                    mWorker.onBackgroundCreateFinished(mView, mAdapter, mPool, mViewType, holder,
+                            createTimeNs);
+                }
+            });
+        }
+    }
+
     @Override
     public void run() {
         try {
@@ -403,14 +647,25 @@ final class GapWorker implements Runnable {
                 return;
             }
 
-            long nextFrameNs = TimeUnit.MILLISECONDS.toNanos(latestFrameVsyncMs) + mFrameIntervalNs;
+            // Prefer the vsync time reported by Choreographer when it is tracked, since drawing
+            // time only has millisecond resolution.
+            long latestFrameVsyncNs = Math.max(TimeUnit.MILLISECONDS.toNanos(latestFrameVsyncMs),
+                    mLastVsyncNs);
+            long nextFrameNs = latestFrameVsyncNs + mFrameIntervalNs;
 
             prefetch(nextFrameNs);
-
-            // TODO: consider rescheduling self, if there's more work to do
         } finally {
             mPostTimeNs = 0;
             Trace.endSection();
         }
+
+        if (mHasDeferredWork && mAsyncFramesRemaining > 0) {
+            // Async prefetch views spread leftover work over the next frame gaps
+            mAsyncFramesRemaining--;
+            postFrameCallback();
+        } else {
+            mHasDeferredWork = false;
+            mLastVsyncNs = 0;
+        }
     }
 }
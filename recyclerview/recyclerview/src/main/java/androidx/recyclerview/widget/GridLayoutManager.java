@@ -876,8 +876,7 @@ public class GridLayoutManager extends LinearLayoutManager {
 
     @Override
     public void onItemsAdded(RecyclerView recyclerView, int positionStart, int itemCount) {
-        mSpanSizeLookup.invalidateSpanIndexCache();
-        mSpanSizeLookup.invalidateSpanGroupIndexCache();
+        mSpanSizeLookup.invalidateSpanIndexCacheFrom(positionStart);
     }
 
     @Override
@@ -888,21 +887,18 @@ public class GridLayoutManager extends LinearLayoutManager {
 
     @Override
     public void onItemsRemoved(RecyclerView recyclerView, int positionStart, int itemCount) {
-        mSpanSizeLookup.invalidateSpanIndexCache();
-        mSpanSizeLookup.invalidateSpanGroupIndexCache();
+        mSpanSizeLookup.invalidateSpanIndexCacheFrom(positionStart);
     }
 
     @Override
     public void onItemsUpdated(RecyclerView recyclerView, int positionStart, int itemCount,
             Object payload) {
-        mSpanSizeLookup.invalidateSpanIndexCache();
-        mSpanSizeLookup.invalidateSpanGroupIndexCache();
+        mSpanSizeLookup.invalidateSpanIndexCacheFrom(positionStart);
     }
 
     @Override
     public void onItemsMoved(RecyclerView recyclerView, int from, int to, int itemCount) {
-        mSpanSizeLookup.invalidateSpanIndexCache();
-        mSpanSizeLookup.invalidateSpanGroupIndexCache();
+        mSpanSizeLookup.invalidateSpanIndexCacheFrom(Math.min(from, to));
     }
 
     @Override
@@ -1528,6 +1524,21 @@ public class GridLayoutManager extends LinearLayoutManager {
         private boolean mCacheSpanIndices = false;
         private boolean mCacheSpanGroupIndices = false;
 
+        /**
+         * Distance between two span checkpoints. Like the per-position caches, checkpoints are
+         * only used by {@link #getSpanIndex(int, int)} and {@link #getSpanGroupIndex(int, int)}
+         * while the matching cache is enabled, so that they never have to walk more than this
+         * many items past the last checkpoint they already computed.
+         */
+        private static final int SPAN_CHECKPOINT_INTERVAL = 64;
+
+        // Checkpoint k holds the span and the span group the walk is at right before the item
+        // at position k * SPAN_CHECKPOINT_INTERVAL. Checkpoint 0 is always (0, 0).
+        private int[] mCheckpointSpans = new int[16];
+        private int[] mCheckpointGroups = new int[16];
+        private int mCheckpointCount = 1;
+        private int mCheckpointSpanCount = -1;
+
         /**
          * Returns the number of span occupied by the item at <code>position</code>.
          *
@@ -1547,6 +1558,7 @@ public class GridLayoutManager extends LinearLayoutManager {
         public void setSpanIndexCacheEnabled(boolean cacheSpanIndices) {
             if (!cacheSpanIndices) {
                 mSpanGroupIndexCache.clear();
+                mCheckpointCount = 1;
             }
             mCacheSpanIndices = cacheSpanIndices;
         }
@@ -1564,24 +1576,78 @@ public class GridLayoutManager extends LinearLayoutManager {
         public void setSpanGroupIndexCacheEnabled(boolean cacheSpanGroupIndices)  {
             if (!cacheSpanGroupIndices) {
                 mSpanGroupIndexCache.clear();
+                mCheckpointCount = 1;
             }
             mCacheSpanGroupIndices = cacheSpanGroupIndices;
         }
 
         /**
-         * Clears the span index cache. GridLayoutManager automatically calls this method when
-         * adapter changes occur.
+         * Clears the span index cache and the span checkpoints. GridLayoutManager automatically
+         * drops the cached values affected by adapter changes, call this method if the span
+         * sizes change without an adapter change.
          */
         public void invalidateSpanIndexCache() {
             mSpanIndexCache.clear();
+            mCheckpointCount = 1;
         }
 
         /**
-         * Clears the span group index cache. GridLayoutManager automatically calls this method
-         * when adapter changes occur.
+         * Clears the span group index cache and the span checkpoints. GridLayoutManager
+         * automatically drops the cached values affected by adapter changes.
          */
         public void invalidateSpanGroupIndexCache() {
             mSpanGroupIndexCache.clear();
+            mCheckpointCount = 1;
+        }
+
+        /**
+         * Drops the cached values of the given position and all positions after it. Spans only
+         * depend on the items before a position, so everything cached for the items before an
+         * adapter change stays valid.
+         */
+        void invalidateSpanIndexCacheFrom(int position) {
+            if (position <= 0) {
+                invalidateSpanIndexCache();
+                invalidateSpanGroupIndexCache();
+                return;
+            }
+            truncateCache(mSpanIndexCache, position);
+            truncateCache(mSpanGroupIndexCache, position);
+            mCheckpointCount = Math.min(mCheckpointCount, position / SPAN_CHECKPOINT_INTERVAL + 1);
+        }
+
+        private static void truncateCache(SparseIntArray cache, int position) {
+            // keys are sorted, so remove from the end until we reach the valid prefix
+            for (int i = cache.size() - 1; i >= 0; i--) {
+                final int key = cache.keyAt(i);
+                if (key < position) {
+                    break;
+                }
+                cache.delete(key);
+            }
+        }
+
+        /**
+         * Returns the index of the last checkpoint at or before the given position, dropping
+         * all checkpoints if they were computed for a different span count.
+         */
+        private int findSpanCheckpoint(int position, int spanCount) {
+            if (spanCount != mCheckpointSpanCount) {
+                mCheckpointSpanCount = spanCount;
+                mCheckpointCount = 1;
+            }
+            return Math.min(mCheckpointCount - 1, position / SPAN_CHECKPOINT_INTERVAL);
+        }
+
+        private void addSpanCheckpoint(int span, int group) {
+            if (mCheckpointCount == mCheckpointSpans.length) {
+                final int newLength = mCheckpointCount * 2;
+                mCheckpointSpans = Arrays.copyOf(mCheckpointSpans, newLength);
+                mCheckpointGroups = Arrays.copyOf(mCheckpointGroups, newLength);
+            }
+            mCheckpointSpans[mCheckpointCount] = span;
+            mCheckpointGroups[mCheckpointCount] = group;
+            mCheckpointCount++;
         }
 
         /**
@@ -1639,7 +1705,8 @@ public class GridLayoutManager extends LinearLayoutManager {
          * ({@link #setSpanIndexCacheEnabled(boolean)}) for better performance. When caching is
          * disabled, default implementation traverses all items from 0 to
          * <code>position</code>. When caching is enabled, it calculates from the closest cached
-         * value before the <code>position</code>.
+         * value or checkpoint before the <code>position</code>, checkpoints being kept every few
+         * dozen positions.
          * <p>
          * If you override this method, you need to make sure it is consistent with
          * {@link #getSpanSize(int)}. GridLayoutManager does not call this method for
@@ -1660,6 +1727,7 @@ public class GridLayoutManager extends LinearLayoutManager {
                 return 0; // quick return for full-span items
             }
             int span = 0;
+            int group = 0;
             int startPos = 0;
             // If caching is enabled, try to jump
             if (mCacheSpanIndices) {
@@ -1669,14 +1737,30 @@ public class GridLayoutManager extends LinearLayoutManager {
                     startPos = prevKey + 1;
                 }
             }
+            // Start from the checkpoint instead if it is closer, and record new checkpoints on
+            // the way. Walks that start from the per-position cache do not know the span group.
+            int nextCheckpoint = -1;
+            final int checkpoint = mCacheSpanIndices ? findSpanCheckpoint(position, spanCount) : 0;
+            if (mCacheSpanIndices && checkpoint * SPAN_CHECKPOINT_INTERVAL >= startPos) {
+                startPos = checkpoint * SPAN_CHECKPOINT_INTERVAL;
+                span = mCheckpointSpans[checkpoint];
+                group = mCheckpointGroups[checkpoint];
+                nextCheckpoint = mCheckpointCount * SPAN_CHECKPOINT_INTERVAL;
+            }
             for (int i = startPos; i < position; i++) {
+                if (i == nextCheckpoint) {
+                    addSpanCheckpoint(span, group);
+                    nextCheckpoint += SPAN_CHECKPOINT_INTERVAL;
+                }
                 int size = getSpanSize(i);
                 span += size;
                 if (span == spanCount) {
                     span = 0;
+                    group++;
                 } else if (span > spanCount) {
                     // did not fit, moving to next row / column
                     span = size;
+                    group++;
                 }
             }
             if (span + positionSpanSize <= spanCount) {
@@ -1737,8 +1821,21 @@ public class GridLayoutManager extends LinearLayoutManager {
                     }
                 }
             }
+            int nextCheckpoint = -1;
+            final int checkpoint =
+                    mCacheSpanGroupIndices ? findSpanCheckpoint(adapterPosition, spanCount) : 0;
+            if (mCacheSpanGroupIndices && checkpoint * SPAN_CHECKPOINT_INTERVAL >= start) {
+                start = checkpoint * SPAN_CHECKPOINT_INTERVAL;
+                span = mCheckpointSpans[checkpoint];
+                group = mCheckpointGroups[checkpoint];
+                nextCheckpoint = mCheckpointCount * SPAN_CHECKPOINT_INTERVAL;
+            }
             int positionSpanSize = getSpanSize(adapterPosition);
             for (int i = start; i < adapterPosition; i++) {
+                if (i == nextCheckpoint) {
+                    addSpanCheckpoint(span, group);
+                    nextCheckpoint += SPAN_CHECKPOINT_INTERVAL;
+                }
                 int size = getSpanSize(i);
                 span += size;
                 if (span == spanCount) {
@@ -146,6 +146,16 @@ public abstract class ListAdapter<T, VH extends RecyclerView.ViewHolder>
         mDiffer.submitList(list, commitCallback);
     }
 
+    /**
+     * Sesl: Sets the range of positions currently shown by the view, used to order updates
+     * when streaming dispatch is enabled.
+     *
+     * @see AsyncListDiffer#seslSetVisibleRange(int, int)
+     */
+    public void seslSetVisibleRange(int firstPosition, int lastPosition) {
+        mDiffer.seslSetVisibleRange(firstPosition, lastPosition);
+    }
+
     protected T getItem(int position) {
         return mDiffer.getCurrentList().get(position);
     }
@@ -94,6 +94,7 @@ class MessageThreadUtil<T> implements ThreadUtil<T> {
             static final int UPDATE_RANGE = 2;
             static final int LOAD_TILE = 3;
             static final int RECYCLE_TILE = 4;
+            static final int ADD_LOADED_TILE = 5;
 
             @Override
             public void refresh(int generation) {
@@ -117,6 +118,11 @@ class MessageThreadUtil<T> implements ThreadUtil<T> {
                 sendMessage(SyncQueueItem.obtainMessage(RECYCLE_TILE, 0, tile));
             }
 
+            @Override
+            public void addLoadedTile(int generation, TileList.Tile<T> tile) {
+                sendMessage(SyncQueueItem.obtainMessage(ADD_LOADED_TILE, generation, tile));
+            }
+
             private void sendMessage(SyncQueueItem msg) {
                 mQueue.sendMessage(msg);
                 maybeExecuteBackgroundRunnable();
@@ -160,6 +166,11 @@ class MessageThreadUtil<T> implements ThreadUtil<T> {
                                 TileList.Tile<T> tile = (TileList.Tile<T>) msg.data;
                                 callback.recycleTile(tile);
                                 break;
+                            case ADD_LOADED_TILE:
+                                @SuppressWarnings("unchecked")
+                                TileList.Tile<T> loadedTile = (TileList.Tile<T>) msg.data;
+                                callback.addLoadedTile(msg.arg1, loadedTile);
+                                break;
                             default:
                                 Log.e("ThreadUtil", "Unsupported message, what=" + msg.what);
                         }
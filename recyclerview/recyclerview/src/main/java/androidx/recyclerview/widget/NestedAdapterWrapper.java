@@ -43,6 +43,8 @@ class NestedAdapterWrapper {
     // Instead, we always calculate this value based on notify events.
     @SuppressWarnings("WeakerAccess")
     int mCachedItemCount;
+    // index of this wrapper in its ConcatAdapterController, maintained by the controller
+    int mWrapperIndex = -1;
 
     private RecyclerView.AdapterDataObserver mAdapterObserver =
             new RecyclerView.AdapterDataObserver() {
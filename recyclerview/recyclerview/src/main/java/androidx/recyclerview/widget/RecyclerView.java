@@ -42,6 +42,7 @@ import android.animation.ObjectAnimator;
 import android.animation.ValueAnimator;
 import android.annotation.SuppressLint;
 import android.app.KeyguardManager;
+import android.content.ComponentCallbacks2;
 import android.content.Context;
 import android.content.res.Configuration;
 import android.content.res.Resources;
@@ -63,6 +64,7 @@ import android.os.Bundle;
 import android.os.Handler;
 import android.os.Looper;
 import android.os.Message;
+import android.os.MessageQueue;
 import android.os.Parcel;
 import android.os.Parcelable;
 import android.os.SystemClock;
@@ -147,6 +149,7 @@ import java.util.Collections;
 import java.util.IdentityHashMap;
 import java.util.List;
 import java.util.Set;
+import java.util.concurrent.TimeUnit;
 
 /**
  * <p><b>SESL variant</b></p><br>
@@ -790,6 +793,18 @@ public class RecyclerView extends ViewGroup implements ScrollingView,
      * >Try increasing your pool size and item cache size.
      */
     static final String TRACE_CREATE_VIEW_TAG = "RV CreateView";
+
+    /**
+     * RecyclerView is creating a new View off the UI thread for async prefetch.
+     * See {@link #seslSetAsyncPrefetchEnabled(boolean)}.
+     */
+    static final String TRACE_BACKGROUND_CREATE_VIEW_TAG = "RV Background CreateView";
+
+    /**
+     * RecyclerView is drawing its Samsung additions on top of the children: decorations'
+     * seslOnDispatchDraw, the fill-bottom area and its rounded corners.
+     */
+    private static final String TRACE_SESL_DISPATCH_DRAW_TAG = "RV SeslDispatchDraw";
     private static final Class<?>[] LAYOUT_MANAGER_CONSTRUCTOR_SIGNATURE =
             new Class<?>[]{Context.class, AttributeSet.class, int.class, int.class};
 
@@ -1019,6 +1034,31 @@ public class RecyclerView extends ViewGroup implements ScrollingView,
     GapWorker mGapWorker;
     GapWorker.LayoutPrefetchRegistryImpl mPrefetchRegistry =
             ALLOW_THREAD_GAP_WORK ? new GapWorker.LayoutPrefetchRegistryImpl() : null;
+    boolean mAsyncPrefetchEnabled = false;//sesl
+    private int mLastPassAllocationTotal = 0;//sesl
+    private int mLayoutPassAllocationCount = 0;//sesl
+    // non null while a SeslOnLayoutStatsListener is set
+    SeslRecyclerViewLayoutStats mLayoutStats;//sesl
+    private SeslOnLayoutStatsListener mLayoutStatsListener;//sesl
+    // tells layout pickups of prefetched holders apart from GapWorker's own lookups
+    boolean mPrefetchInProgress = false;//sesl
+
+    //Sesl
+    private boolean mPoolPrewarmScheduled = false;
+    private final MessageQueue.IdleHandler mPoolPrewarmIdleHandler =
+            new MessageQueue.IdleHandler() {
+                @Override
+                public boolean queueIdle() {
+                    // Stop once the user starts scrolling, prewarming is only useful before that
+                    if (!mIsAttached || mAdapter == null || mScrollState != SCROLL_STATE_IDLE
+                            || !getRecycledViewPool().prewarmNext(RecyclerView.this)) {
+                        mPoolPrewarmScheduled = false;
+                        return false;
+                    }
+                    return true;
+                }
+            };
+    //sesl
 
     final State mState = new State();
 
@@ -1760,6 +1800,7 @@ public class RecyclerView extends ViewGroup implements ScrollingView,
         setAdapterInternal(adapter, false, true);
         processDataSetCompletelyChanged(false);
         requestLayout();
+        seslSchedulePoolPrewarm();//sesl
     }
 
     /**
@@ -2143,7 +2184,18 @@ public class RecyclerView extends ViewGroup implements ScrollingView,
      * @param pool Pool to set. If this parameter is null a new pool will be created and used.
      */
     public void setRecycledViewPool(@Nullable RecycledViewPool pool) {
+        //Sesl
+        final boolean attached = mIsAttached;
+        if (attached) {
+            seslUnregisterPoolCallbacks();
+        }
+        //sesl
         mRecycler.setRecycledViewPool(pool);
+        //Sesl
+        if (attached) {
+            seslRegisterPoolCallbacks();
+        }
+        //sesl
     }
 
     /**
@@ -4025,6 +4077,10 @@ public class RecyclerView extends ViewGroup implements ScrollingView,
         }
         mPostedAnimatorRunner = false;
 
+        //Sesl
+        seslRegisterPoolCallbacks();
+        //sesl
+
         if (ALLOW_THREAD_GAP_WORK) {
             // Register with gap worker
             mGapWorker = GapWorker.sGapWorker.get();
@@ -4083,6 +4139,10 @@ public class RecyclerView extends ViewGroup implements ScrollingView,
             mGapWorker = null;
         }
 
+        //Sesl
+        seslUnregisterPoolCallbacks();
+        //sesl
+
         //Sesl
         if (mIndexTipEnabled && mIndexTip != null) {
             mIndexTip.forcedHide();
@@ -5287,6 +5347,7 @@ public class RecyclerView extends ViewGroup implements ScrollingView,
      * - If necessary, run predictive layout and save its information
      */
     private void dispatchLayoutStep1() {
+        final long stepStartNs = mLayoutStats != null ? getNanoTime() : 0;//sesl
         mState.assertLayoutStep(State.STEP_START);
         fillRemainingScrollValues(mState);
         mState.mIsMeasuring = false;
@@ -5372,6 +5433,11 @@ public class RecyclerView extends ViewGroup implements ScrollingView,
         onExitLayoutOrScroll();
         stopInterceptRequestLayout(false);
         mState.mLayoutStep = State.STEP_LAYOUT;
+        //Sesl
+        if (mLayoutStats != null) {
+            mLayoutStats.addLayoutStep(1, getNanoTime() - stepStartNs);
+        }
+        //sesl
     }
 
     /**
@@ -5379,6 +5445,7 @@ public class RecyclerView extends ViewGroup implements ScrollingView,
      * This step might be run multiple times if necessary (e.g. measure).
      */
     private void dispatchLayoutStep2() {
+        final long stepStartNs = mLayoutStats != null ? getNanoTime() : 0;//sesl
         startInterceptRequestLayout();
         onEnterLayoutOrScroll();
         mState.assertLayoutStep(State.STEP_LAYOUT | State.STEP_ANIMATIONS);
@@ -5402,6 +5469,11 @@ public class RecyclerView extends ViewGroup implements ScrollingView,
         mState.mLayoutStep = State.STEP_ANIMATIONS;
         onExitLayoutOrScroll();
         stopInterceptRequestLayout(false);
+        //Sesl
+        if (mLayoutStats != null) {
+            mLayoutStats.addLayoutStep(2, getNanoTime() - stepStartNs);
+        }
+        //sesl
     }
 
     /**
@@ -5409,6 +5481,7 @@ public class RecyclerView extends ViewGroup implements ScrollingView,
      * trigger animations and do any necessary cleanup.
      */
     private void dispatchLayoutStep3() {
+        final long stepStartNs = mLayoutStats != null ? getNanoTime() : 0;//sesl
         mState.assertLayoutStep(State.STEP_ANIMATIONS);
         startInterceptRequestLayout();
         onEnterLayoutOrScroll();
@@ -5512,11 +5585,23 @@ public class RecyclerView extends ViewGroup implements ScrollingView,
         onExitLayoutOrScroll();
         stopInterceptRequestLayout(false);
         mViewInfoStore.clear();
+        //Sesl
+        final int allocationTotal =
+                mViewInfoStore.mAllocationCount + mAdapterHelper.mAllocationCount;
+        mLayoutPassAllocationCount = allocationTotal - mLastPassAllocationTotal;
+        mLastPassAllocationTotal = allocationTotal;
+        //sesl
         if (didChildRangeChange(mMinMaxLayoutPositions[0], mMinMaxLayoutPositions[1])) {
             dispatchOnScrolled(0, 0);
         }
         recoverFocusFromState();
         resetFocusInfo();
+        //Sesl
+        if (mLayoutStats != null) {
+            mLayoutStats.addLayoutStep(3, getNanoTime() - stepStartNs);
+            mLayoutStats.setLayoutPassAllocationCount(mLayoutPassAllocationCount);
+        }
+        //sesl
     }
 
     /**
@@ -5765,10 +5850,16 @@ public class RecyclerView extends ViewGroup implements ScrollingView,
     public void draw(@NonNull Canvas c) {
         super.draw(c);
 
+        final long decorStartNs = mLayoutStats != null ? getNanoTime() : 0;//sesl
         final int count = mItemDecorations.size();
         for (int i = 0; i < count; i++) {
             mItemDecorations.get(i).onDrawOver(c, this, mState);
         }
+        //Sesl
+        if (mLayoutStats != null) {
+            mLayoutStats.addDecorationDraw(getNanoTime() - decorStartNs);
+        }
+        //sesl
         // TODO If padding is not 0 and clipChildrenToPadding is false, to draw glows properly, we
         // need find children closest to edges. Not sure if it is worth the effort.
         boolean needsInvalidate = false;
@@ -5853,6 +5944,14 @@ public class RecyclerView extends ViewGroup implements ScrollingView,
                 mPenDragBlockImage.draw(c);
             }
         }
+
+        // The listener may replace or remove itself from the callback
+        final SeslOnLayoutStatsListener layoutStatsListener = mLayoutStatsListener;
+        final SeslRecyclerViewLayoutStats layoutStats = mLayoutStats;
+        if (layoutStatsListener != null && layoutStats != null) {
+            layoutStatsListener.onLayoutStats(this, layoutStats);
+            layoutStats.reset();
+        }
         //sesl
     }
 
@@ -5860,10 +5959,16 @@ public class RecyclerView extends ViewGroup implements ScrollingView,
     public void onDraw(@NonNull Canvas c) {
         super.onDraw(c);
 
+        final long decorStartNs = mLayoutStats != null ? getNanoTime() : 0;//sesl
         final int count = mItemDecorations.size();
         for (int i = 0; i < count; i++) {
             mItemDecorations.get(i).onDraw(c, this, mState);
         }
+        //Sesl
+        if (mLayoutStats != null) {
+            mLayoutStats.addDecorationDraw(getNanoTime() - decorStartNs);
+        }
+        //sesl
 
         //Sesl
         if (mStatisticalCount <= STATISTICS_MAX_COUNT && mIsNeedCheckLatency) {
@@ -7142,10 +7247,30 @@ public class RecyclerView extends ViewGroup implements ScrollingView,
             int mMaxScrap = DEFAULT_MAX_SCRAP;
             long mCreateRunningAverageNs = 0;
             long mBindRunningAverageNs = 0;
+            boolean mBackgroundCreatePending = false;
+            // Sesl: adaptive sizing state. mMaxScrap never drops below mBaseMaxScrap.
+            int mBaseMaxScrap = DEFAULT_MAX_SCRAP;
+            int mRecentCreates = 0;
+            int mPrewarmCount = 0;
         }
 
+        /**
+         * Upper bound for an adaptively grown scrap cap of a view type that is cheap to create.
+         * Types whose average create time exceeds {@link #ADAPTIVE_EXPENSIVE_CREATE_NS} may grow
+         * to twice this value.
+         */
+        private static final int ADAPTIVE_MAX_SCRAP_LIMIT = 10;
+        private static final long ADAPTIVE_EXPENSIVE_CREATE_NS = TimeUnit.MILLISECONDS.toNanos(2);
+
         SparseArray<ScrapData> mScrap = new SparseArray<>();
 
+        boolean mAdaptiveMaxScrapEnabled = false;
+
+        // Sesl: attached RecyclerViews using this pool, and the one trim callback they share
+        private final ArrayList<RecyclerView> mSeslAttachedRecyclerViews = new ArrayList<>();
+        private ComponentCallbacks2 mTrimMemoryCallbacks;
+        private Context mTrimMemoryContext;
+
         /**
          * Attach counts for clearing (that is, emptying the pool when there are no adapters
          * attached) and for PoolingContainer release are tracked separately to maintain the
@@ -7196,6 +7321,7 @@ public class RecyclerView extends ViewGroup implements ScrollingView,
         public void setMaxRecycledViews(int viewType, int max) {
             ScrapData scrapData = getScrapDataForType(viewType);
             scrapData.mMaxScrap = max;
+            scrapData.mBaseMaxScrap = max;
             final ArrayList<ViewHolder> scrapHeap = scrapData.mScrapHeap;
             while (scrapHeap.size() > max) {
                 scrapHeap.remove(scrapHeap.size() - 1);
@@ -7256,8 +7382,9 @@ public class RecyclerView extends ViewGroup implements ScrollingView,
          */
         public void putRecycledView(ViewHolder scrap) {
             final int viewType = scrap.getItemViewType();
-            final ArrayList<ViewHolder> scrapHeap = getScrapDataForType(viewType).mScrapHeap;
-            if (mScrap.get(viewType).mMaxScrap <= scrapHeap.size()) {
+            final ScrapData scrapData = getScrapDataForType(viewType);
+            final ArrayList<ViewHolder> scrapHeap = scrapData.mScrapHeap;
+            if (scrapData.mMaxScrap <= scrapHeap.size() && !maybeGrowMaxScrap(scrapData)) {
                 PoolingContainer.callPoolingContainerOnRelease(scrap.itemView);
                 return;
             }
@@ -7279,6 +7406,193 @@ public class RecyclerView extends ViewGroup implements ScrollingView,
             ScrapData scrapData = getScrapDataForType(viewType);
             scrapData.mCreateRunningAverageNs = runningAverage(
                     scrapData.mCreateRunningAverageNs, createTimeNs);
+            if (mAdaptiveMaxScrapEnabled
+                    && scrapData.mRecentCreates < ADAPTIVE_MAX_SCRAP_LIMIT * 2) {
+                scrapData.mRecentCreates++;
+            }
+        }
+
+        /**
+         * Sesl: Enables sizing each view type's scrap cap from observed churn.
+         * <p>
+         * When a holder would be discarded because its type is full while holders of that type
+         * were recently created, the cap grows by one, up to a limit that is higher for types
+         * that are expensive to create. Caps never go below the value set with
+         * {@link #setMaxRecycledViews(int, int)} and are shrunk back on memory pressure, see
+         * {@link #seslOnTrimMemory(int)}. The pool listens for
+         * {@link ComponentCallbacks2#onTrimMemory(int)} once, however many attached
+         * RecyclerViews share it.
+         *
+         * @param enabled true to enable adaptive sizing
+         */
+        public void seslSetAdaptiveMaxScrapEnabled(boolean enabled) {
+            if (mAdaptiveMaxScrapEnabled == enabled) {
+                return;
+            }
+            mAdaptiveMaxScrapEnabled = enabled;
+            if (!enabled) {
+                shrinkToBase(1f);
+            }
+            updateTrimMemoryCallbacks();
+        }
+
+        public boolean seslIsAdaptiveMaxScrapEnabled() {
+            return mAdaptiveMaxScrapEnabled;
+        }
+
+        /**
+         * Sesl: Sets how many holders of the given type the pool should be pre-filled with while
+         * the UI thread is idle, before the first scroll of an attached RecyclerView. The count
+         * is capped by the type's maximum scrap size.
+         *
+         * @param viewType ViewHolder type
+         * @param count    number of holders to create ahead of time, 0 to disable
+         */
+        public void seslSetPrewarmCount(int viewType, int count) {
+            getScrapDataForType(viewType).mPrewarmCount = Math.max(0, count);
+            for (int i = 0; i < mSeslAttachedRecyclerViews.size(); i++) {
+                mSeslAttachedRecyclerViews.get(i).seslSchedulePoolPrewarm();
+            }
+        }
+
+        /**
+         * Sesl: Releases adaptively grown scrap capacity in response to memory pressure.
+         *
+         * @param level the trim level passed to {@link ComponentCallbacks2#onTrimMemory(int)}
+         */
+        public void seslOnTrimMemory(int level) {
+            if (!mAdaptiveMaxScrapEnabled) {
+                return;
+            }
+            if (level >= ComponentCallbacks2.TRIM_MEMORY_BACKGROUND
+                    || level == ComponentCallbacks2.TRIM_MEMORY_RUNNING_CRITICAL) {
+                shrinkToBase(1f);
+            } else if (level >= ComponentCallbacks2.TRIM_MEMORY_RUNNING_LOW) {
+                shrinkToBase(0.5f);
+            } else {
+                // Keep the caps, but let old churn stop growing them
+                for (int i = 0; i < mScrap.size(); i++) {
+                    mScrap.valueAt(i).mRecentCreates /= 2;
+                }
+            }
+        }
+
+        void seslOnAttachedToRecyclerView(@NonNull RecyclerView recyclerView) {
+            if (!mSeslAttachedRecyclerViews.contains(recyclerView)) {
+                mSeslAttachedRecyclerViews.add(recyclerView);
+            }
+            updateTrimMemoryCallbacks();
+        }
+
+        void seslOnDetachedFromRecyclerView(@NonNull RecyclerView recyclerView) {
+            mSeslAttachedRecyclerViews.remove(recyclerView);
+            updateTrimMemoryCallbacks();
+        }
+
+        private void updateTrimMemoryCallbacks() {
+            final boolean needed =
+                    mAdaptiveMaxScrapEnabled && !mSeslAttachedRecyclerViews.isEmpty();
+            if (needed && mTrimMemoryCallbacks == null) {
+                mTrimMemoryCallbacks = new ComponentCallbacks2() {
+                    @Override
+                    public void onTrimMemory(int level) {
+                        seslOnTrimMemory(level);
+                    }
+
+                    @Override
+                    public void onConfigurationChanged(@NonNull Configuration newConfig) {
+                    }
+
+                    @Override
+                    public void onLowMemory() {
+                        seslOnTrimMemory(ComponentCallbacks2.TRIM_MEMORY_COMPLETE);
+                    }
+                };
+                mTrimMemoryContext =
+                        mSeslAttachedRecyclerViews.get(0).getContext().getApplicationContext();
+                mTrimMemoryContext.registerComponentCallbacks(mTrimMemoryCallbacks);
+            } else if (!needed && mTrimMemoryCallbacks != null) {
+                mTrimMemoryContext.unregisterComponentCallbacks(mTrimMemoryCallbacks);
+                mTrimMemoryCallbacks = null;
+                mTrimMemoryContext = null;
+            }
+        }
+
+        private boolean maybeGrowMaxScrap(ScrapData scrapData) {
+            if (!mAdaptiveMaxScrapEnabled || scrapData.mRecentCreates == 0) {
+                return false;
+            }
+            final int limit = Math.max(scrapData.mBaseMaxScrap,
+                    scrapData.mCreateRunningAverageNs >= ADAPTIVE_EXPENSIVE_CREATE_NS
+                            ? ADAPTIVE_MAX_SCRAP_LIMIT * 2 : ADAPTIVE_MAX_SCRAP_LIMIT);
+            if (scrapData.mMaxScrap >= limit) {
+                return false;
+            }
+            scrapData.mMaxScrap++;
+            scrapData.mRecentCreates--;
+            return true;
+        }
+
+        /**
+         * Removes the given fraction of each type's adaptively grown capacity, releasing holders
+         * that no longer fit.
+         */
+        private void shrinkToBase(float fraction) {
+            for (int i = 0; i < mScrap.size(); i++) {
+                final ScrapData scrapData = mScrap.valueAt(i);
+                final int grown = scrapData.mMaxScrap - scrapData.mBaseMaxScrap;
+                if (grown > 0) {
+                    scrapData.mMaxScrap -= (int) Math.ceil(grown * fraction);
+                }
+                scrapData.mRecentCreates -= (int) Math.ceil(scrapData.mRecentCreates * fraction);
+                final ArrayList<ViewHolder> scrapHeap = scrapData.mScrapHeap;
+                while (scrapHeap.size() > scrapData.mMaxScrap) {
+                    ViewHolder removed = scrapHeap.remove(scrapHeap.size() - 1);
+                    PoolingContainer.callPoolingContainerOnRelease(removed.itemView);
+                }
+            }
+        }
+
+        boolean hasPendingPrewarm() {
+            for (int i = 0; i < mScrap.size(); i++) {
+                final ScrapData scrapData = mScrap.valueAt(i);
+                if (scrapData.mScrapHeap.size()
+                        < Math.min(scrapData.mPrewarmCount, scrapData.mMaxScrap)) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        /**
+         * Creates one holder for the first view type that is below its prewarm count.
+         *
+         * @return true if a holder was created and more prewarming may be needed
+         */
+        boolean prewarmNext(@NonNull RecyclerView recyclerView) {
+            for (int i = 0; i < mScrap.size(); i++) {
+                final ScrapData scrapData = mScrap.valueAt(i);
+                if (scrapData.mScrapHeap.size()
+                        >= Math.min(scrapData.mPrewarmCount, scrapData.mMaxScrap)) {
+                    continue;
+                }
+                final int viewType = mScrap.keyAt(i);
+                final long start = recyclerView.getNanoTime();
+                final ViewHolder holder =
+                        recyclerView.mAdapter.createViewHolder(recyclerView, viewType);
+                if (ALLOW_THREAD_GAP_WORK) {
+                    RecyclerView innerView = findNestedRecyclerView(holder.itemView);
+                    if (innerView != null) {
+                        holder.mNestedRecyclerView = new WeakReference<>(innerView);
+                    }
+                }
+                // not counted as churn, unlike creates during layout
+                scrapData.mCreateRunningAverageNs = runningAverage(
+                        scrapData.mCreateRunningAverageNs, recyclerView.getNanoTime() - start);
+                putRecycledView(holder);
+                return true;
+            }
+            return false;
         }
 
         void factorInBindTime(int viewType, long bindTimeNs) {
@@ -7297,6 +7611,15 @@ public class RecyclerView extends ViewGroup implements ScrollingView,
             return expectedDurationNs == 0 || (approxCurrentNs + expectedDurationNs < deadlineNs);
         }
 
+        boolean hasPendingBackgroundCreate(int viewType) {
+            final ScrapData scrapData = mScrap.get(viewType);
+            return scrapData != null && scrapData.mBackgroundCreatePending;
+        }
+
+        void setPendingBackgroundCreate(int viewType, boolean pending) {
+            getScrapDataForType(viewType).mBackgroundCreatePending = pending;
+        }
+
         void attach() {
             mAttachCountForClearing++;
         }
@@ -7588,6 +7911,9 @@ public class RecyclerView extends ViewGroup implements ScrollingView,
 
             long endBindNs = getNanoTime();
             mRecyclerPool.factorInBindTime(holder.getItemViewType(), endBindNs - startBindNs);
+            if (mLayoutStats != null) {
+                mLayoutStats.addBind(holder.getItemViewType(), endBindNs - startBindNs);//sesl
+            }
             attachAccessibilityDelegateOnBind(holder);
             if (mState.isPreLayout()) {
                 holder.mPreLayoutPosition = position;
@@ -7818,12 +8144,24 @@ public class RecyclerView extends ViewGroup implements ScrollingView,
 
                     long end = getNanoTime();
                     mRecyclerPool.factorInCreateTime(type, end - start);
+                    if (mLayoutStats != null) {
+                        mLayoutStats.addCreate(type, end - start);//sesl
+                    }
                     if (sVerboseLoggingEnabled) {
                         Log.d(TAG, "tryGetViewHolderForPositionByDeadline created new ViewHolder");
                     }
                 }
             }
 
+            //Sesl
+            if (fromScrapOrHiddenOrCache && holder.mPrefetched && !mPrefetchInProgress) {
+                holder.mPrefetched = false;
+                if (mLayoutStats != null) {
+                    mLayoutStats.addPrefetchHit();
+                }
+            }
+            //sesl
+
             // This is very ugly but the only place we can grab this information
             // before the View is rebound and returned to the LayoutManager for post layout ops.
             // We don't need this in pre-layout since the VH is not updated by the LM.
@@ -8103,6 +8441,14 @@ public class RecyclerView extends ViewGroup implements ScrollingView,
          */
         void addViewHolderToRecycledViewPool(@NonNull ViewHolder holder, boolean dispatchRecycled) {
             clearNestedRecyclerViewIfNotNested(holder);
+            //Sesl
+            if (holder.mPrefetched) {
+                holder.mPrefetched = false;
+                if (mLayoutStats != null) {
+                    mLayoutStats.addPrefetchMiss();
+                }
+            }
+            //sesl
             View itemView = holder.itemView;
             if (mAccessibilityDelegate != null) {
                 AccessibilityDelegateCompat itemDelegate = mAccessibilityDelegate.getItemDelegate();
@@ -8820,6 +9166,35 @@ public class RecyclerView extends ViewGroup implements ScrollingView,
             return 0;
         }
 
+        /**
+         * Sesl: Returns whether ViewHolders of the given view type can be created off the UI
+         * thread when async prefetch is enabled with
+         * {@link RecyclerView#seslSetAsyncPrefetchEnabled(boolean)}.
+         * <p>
+         * Only return true if {@link #onCreateViewHolder(ViewGroup, int)} for this type does not
+         * touch state owned by the UI thread, e.g. it only inflates plain views and does not start
+         * animations, register observers or read the adapter's data set. Binding always happens
+         * on the UI thread.
+         *
+         * @param viewType the view type to check
+         * @return true if holders of this type may be created on a background thread
+         */
+        public boolean seslIsViewTypeCreatableInBackground(int viewType) {
+            return false;
+        }
+
+        /**
+         * Sesl: Returns a relative cost for creating and binding ViewHolders of the given view
+         * type. When async prefetch is enabled, items with costlier types are prefetched before
+         * cheaper ones at the same urgency.
+         *
+         * @param viewType the view type to check
+         * @return a non-negative cost, 0 by default
+         */
+        public int seslGetViewTypePrefetchCost(int viewType) {
+            return 0;
+        }
+
         /**
          * Indicates whether each item in the data set can be represented with a unique identifier
          * of type {@link java.lang.Long}.
@@ -12827,6 +13202,10 @@ public class RecyclerView extends ViewGroup implements ScrollingView,
         long mItemId = NO_ID;
         int mItemViewType = INVALID_TYPE;
         int mPreLayoutPosition = NO_POSITION;
+        // Slot of this holder's animation record in ViewInfoStore, if it is tracked
+        int mInfoStoreIndex = NO_POSITION;
+        // Cached by GapWorker and not picked up by a layout yet
+        boolean mPrefetched = false;//sesl
 
         // The item that this holder is shadowing during an item change event/animation
         ViewHolder mShadowedHolder = null;
@@ -15551,6 +15930,36 @@ public class RecyclerView extends ViewGroup implements ScrollingView,
         void onReleased(float scrollY);
     }
 
+    /**
+     * Receives per-frame layout statistics, see
+     * {@link #seslSetOnLayoutStatsListener(SeslOnLayoutStatsListener)}.
+     */
+    public interface SeslOnLayoutStatsListener {
+        /**
+         * Called at the end of {@link RecyclerView#draw(Canvas)}. The stats are reset right
+         * after, see {@link SeslRecyclerViewLayoutStats}.
+         */
+        void onLayoutStats(@NonNull RecyclerView recyclerView,
+                @NonNull SeslRecyclerViewLayoutStats stats);
+    }
+
+    /**
+     * Optional interface for an {@link Adapter} with variable height items. When the adapter
+     * implements it, the fast scroller maps its thumb to exact scroll offsets through a
+     * cumulative height index instead of estimating them from item counts.
+     * <p>
+     * The index is rebuilt after data set change notifications, so heights must only change
+     * together with one.
+     */
+    public interface SeslItemHeightProvider {
+        /**
+         * @param position adapter position of the item
+         * @return the vertical space in pixels the item takes once laid out, including its
+         * decorations and margins
+         */
+        int getItemHeight(int position);
+    }
+
     public interface SeslLongPressMultiSelectionListener {
         void onItemSelected(@NonNull RecyclerView view, @NonNull View child, int position, long id);
 
@@ -16038,6 +16447,11 @@ public class RecyclerView extends ViewGroup implements ScrollingView,
     protected void dispatchDraw(@NonNull Canvas canvas) {
         super.dispatchDraw(canvas);
 
+        final boolean traceDispatchDraw = TraceCompat.isEnabled();
+        if (traceDispatchDraw) {
+            Trace.beginSection(TRACE_SESL_DISPATCH_DRAW_TAG);
+        }
+        final long seslDrawStartNs = mLayoutStats != null ? getNanoTime() : 0;
         final int count = mItemDecorations.size();
         for (int i = 0; i < count; i++) {
             mItemDecorations.get(i).seslOnDispatchDraw(canvas, this, mState);
@@ -16088,6 +16502,12 @@ public class RecyclerView extends ViewGroup implements ScrollingView,
         }
 
         mLastItemAnimTop = mBlackTop;
+        if (mLayoutStats != null) {
+            mLayoutStats.addSeslDispatchDraw(getNanoTime() - seslDrawStartNs);
+        }
+        if (traceDispatchDraw) {
+            Trace.endSection();
+        }
     }
 
 
@@ -17335,6 +17755,74 @@ public class RecyclerView extends ViewGroup implements ScrollingView,
         mUsePagingTouchSlopForStylus = enabled;
     }
 
+    /**
+     * Enables a prefetch mode that does not drop work that misses the frame gap.
+     * <p>
+     * Prefetch items that could not be created or bound before the next vsync are retried in the
+     * following frame gaps, ViewHolders of types reported by
+     * {@link Adapter#seslIsViewTypeCreatableInBackground(int)} are created on background threads
+     * ahead of time, and items are ordered by {@link Adapter#seslGetViewTypePrefetchCost(int)}.
+     * Disabled by default.
+     *
+     * @param enabled true to enable async prefetch for this RecyclerView
+     */
+    public void seslSetAsyncPrefetchEnabled(boolean enabled) {
+        mAsyncPrefetchEnabled = enabled;
+    }
+
+    public boolean seslIsAsyncPrefetchEnabled() {
+        return mAsyncPrefetchEnabled;
+    }
+
+    /**
+     * Returns the number of objects the animation info store and the adapter update op pipeline
+     * allocated between the end of the previous layout pass and the end of the last one. Stays
+     * at 0 once the internal buffers have grown to the working set of the list, so it can be
+     * used to verify that steady state layouts are allocation free.
+     */
+    public int seslGetLayoutPassAllocationCount() {
+        return mLayoutPassAllocationCount;
+    }
+
+    /**
+     * Sets a listener receiving {@link SeslRecyclerViewLayoutStats} after every frame this
+     * RecyclerView draws: layout step durations, ViewHolder create and bind counts per view type,
+     * prefetch hits and misses, and decoration draw cost. Collection has a small per-frame cost
+     * and only runs while a listener is set.
+     *
+     * @param listener the listener, or null to stop collecting
+     */
+    public void seslSetOnLayoutStatsListener(@Nullable SeslOnLayoutStatsListener listener) {
+        mLayoutStatsListener = listener;
+        if (listener == null) {
+            mLayoutStats = null;
+        } else if (mLayoutStats == null) {
+            mLayoutStats = new SeslRecyclerViewLayoutStats();
+        }
+    }
+
+    private void seslRegisterPoolCallbacks() {
+        getRecycledViewPool().seslOnAttachedToRecyclerView(this);
+        seslSchedulePoolPrewarm();
+    }
+
+    private void seslUnregisterPoolCallbacks() {
+        getRecycledViewPool().seslOnDetachedFromRecyclerView(this);
+        if (mPoolPrewarmScheduled) {
+            Looper.myQueue().removeIdleHandler(mPoolPrewarmIdleHandler);
+            mPoolPrewarmScheduled = false;
+        }
+    }
+
+    @SuppressWarnings("WeakerAccess") /* synthetic access */
+    void seslSchedulePoolPrewarm() {
+        if (!mPoolPrewarmScheduled && mIsAttached && mAdapter != null && !isInEditMode()
+                && getRecycledViewPool().hasPendingPrewarm()) {
+            mPoolPrewarmScheduled = true;
+            Looper.myQueue().addIdleHandler(mPoolPrewarmIdleHandler);
+        }
+    }
+
     public boolean seslIsPagingTouchSlopForStylusEnabled() {
         return mUsePagingTouchSlopForStylus;
     }
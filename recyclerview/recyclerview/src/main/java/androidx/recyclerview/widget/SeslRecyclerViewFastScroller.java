@@ -57,6 +57,7 @@ import androidx.annotation.RestrictTo;
 import androidx.appcompat.animation.SeslAnimationUtils;
 import androidx.core.graphics.drawable.DrawableCompat;
 import androidx.core.math.MathUtils;
+import androidx.core.view.ViewCompat;
 import androidx.recyclerview.R;
 import androidx.reflect.content.res.SeslConfigurationReflector;
 import androidx.reflect.view.SeslHapticFeedbackConstantsReflector;
@@ -259,6 +260,21 @@ class SeslRecyclerViewFastScroller {
     private int mOldItemCount;
     private int mOldChildCount;
 
+    /** Cumulative item heights, when the adapter is a {@link RecyclerView.SeslItemHeightProvider}. */
+    private final ItemOffsetIndex mItemOffsetIndex = new ItemOffsetIndex();
+
+    /** Thumb position waiting for the next frame, so that a drag relays out at most once a frame. */
+    private float mPendingScrollPosition = -1f;
+    private float mLastScrollPosition = -1f;
+
+    private final Runnable mPendingScrollRunnable = () -> {
+        if (mPendingScrollPosition >= 0f) {
+            final float position = mPendingScrollPosition;
+            mPendingScrollPosition = -1f;
+            scrollTo(position);
+        }
+    };
+
     /**
      * Used to delay hiding fast scroll decorations.
      */
@@ -1057,6 +1073,66 @@ class SeslRecyclerViewFastScroller {
 
     public void onSectionsChanged() {
         mListAdapter = null;
+        mItemOffsetIndex.invalidate();
+    }
+
+    /**
+     * @return the height index if the list can be mapped to exact offsets, null otherwise
+     */
+    private ItemOffsetIndex getItemOffsetIndex() {
+        final RecyclerView.Adapter<?> adapter = mRecyclerView.getAdapter();
+        final RecyclerView.LayoutManager layoutManager = mRecyclerView.getLayoutManager();
+        if (!(adapter instanceof RecyclerView.SeslItemHeightProvider)
+                || !(layoutManager instanceof LinearLayoutManager)
+                || layoutManager instanceof GridLayoutManager
+                || ((LinearLayoutManager) layoutManager).getOrientation()
+                        != RecyclerView.VERTICAL) {
+            return null;
+        }
+        mItemOffsetIndex.ensure((RecyclerView.SeslItemHeightProvider) adapter,
+                adapter.getItemCount());
+        return mItemOffsetIndex;
+    }
+
+    /**
+     * @return how far the list can be scrolled according to the height index
+     */
+    private long getIndexedScrollRange(ItemOffsetIndex index) {
+        return Math.max(0, index.getTotalHeight() + mRecyclerView.getPaddingTop()
+                + mRecyclerView.getPaddingBottom() - mRecyclerView.getHeight());
+    }
+
+    /**
+     * Scrolls to the latest dragged position on the next frame. Move events arriving before
+     * then only update the target.
+     */
+    private void scheduleScrollTo(float position) {
+        final boolean posted = mPendingScrollPosition >= 0f;
+        mPendingScrollPosition = position;
+        if (!posted) {
+            ViewCompat.postOnAnimation(mRecyclerView, mPendingScrollRunnable);
+        }
+    }
+
+    private void cancelPendingScroll() {
+        mPendingScrollPosition = -1f;
+        mRecyclerView.removeCallbacks(mPendingScrollRunnable);
+    }
+
+    /**
+     * Lets {@link GapWorker} prefetch the items following the drag direction once the jump
+     * has been laid out.
+     */
+    private void prefetchInDragDirection(float position) {
+        final float lastPosition = mLastScrollPosition;
+        mLastScrollPosition = position;
+        if (lastPosition < 0f || position == lastPosition || mRecyclerView.mGapWorker == null
+                || mState != STATE_DRAGGING) {
+            return;
+        }
+        final int distance = Math.max(1, mRecyclerView.getHeight() / 2);
+        mRecyclerView.mGapWorker.postFromTraversal(mRecyclerView, 0,
+                position > lastPosition ? distance : -distance);
     }
 
     /**
@@ -1147,6 +1223,16 @@ class SeslRecyclerViewFastScroller {
             } else {
                 ((StaggeredGridLayoutManager) layoutManager).scrollToPositionWithOffset(targetIndex, 0, true);
             }
+        } else if (getItemOffsetIndex() != null) {
+            // exact offsets: the thumb moves the list by the same fraction of its range
+            final ItemOffsetIndex offsetIndex = mItemOffsetIndex;
+            final long scrolled = (long) (position * getIndexedScrollRange(offsetIndex));
+            final int index = MathUtils.clamp(offsetIndex.findPosition(scrolled), 0, count - 1);
+
+            sectionIndex = -1;
+
+            ((LinearLayoutManager) layoutManager).scrollToPositionWithOffset(index,
+                    (int) (offsetIndex.getOffset(index) - scrolled));
         } else {
             final int index = MathUtils.clamp((int) (position * count), 0, count - 1);
 
@@ -1159,6 +1245,8 @@ class SeslRecyclerViewFastScroller {
             }
         }
 
+        prefetchInDragDirection(position);
+
         onScroll(mRecyclerView.findFirstVisibleItemPosition(),
                 mRecyclerView.getChildCount(), mRecyclerView.getAdapter().getItemCount());
 
@@ -1353,6 +1441,11 @@ class SeslRecyclerViewFastScroller {
                 position = 0.0F;
             }
 
+            if ((sectionIndexer == null || mSections == null || mSections.length == 0)
+                    && getItemOffsetIndex() != null) {
+                return getIndexedScrollPosition(firstVisibleItem);
+            }
+
             boolean hasSections;
             checkHasSections: {
                 if (sectionIndexer != null) {
@@ -1447,6 +1540,24 @@ class SeslRecyclerViewFastScroller {
         }
     }
 
+    /**
+     * Calculates the thumb position from the height index and the first visible item's top.
+     */
+    private float getIndexedScrollPosition(int firstVisibleItem) {
+        final ItemOffsetIndex index = mItemOffsetIndex;
+        final long range = getIndexedScrollRange(index);
+        final RecyclerView.LayoutManager layoutManager = mRecyclerView.getLayoutManager();
+        final View firstView = layoutManager.findViewByPosition(firstVisibleItem);
+        if (range <= 0 || firstView == null) {
+            return 0f;
+        }
+        final RecyclerView.LayoutParams lp = (RecyclerView.LayoutParams) firstView.getLayoutParams();
+        final int top = layoutManager.getDecoratedTop(firstView) - lp.topMargin
+                - mRecyclerView.getPaddingTop();
+        final long scrolled = index.getOffset(firstVisibleItem) - top;
+        return MathUtils.clamp((float) scrolled / range, 0f, 1f);
+    }
+
     /**
      * Cancels an ongoing fling event by injecting a
      * {@link MotionEvent#ACTION_CANCEL} into the host view.
@@ -1579,6 +1690,13 @@ class SeslRecyclerViewFastScroller {
             } break;
 
             case MotionEvent.ACTION_UP: {
+                if (mPendingScrollPosition >= 0f) {
+                    // land exactly where the finger was lifted
+                    final float pending = mPendingScrollPosition;
+                    cancelPendingScroll();
+                    scrollTo(pending);
+                }
+
                 if (mPendingDrag >= 0) {
                     // Allow a tap to scroll.
                     beginDrag();
@@ -1637,7 +1755,7 @@ class SeslRecyclerViewFastScroller {
 
                     // If the previous scrollTo is still pending
                     if (mScrollCompleted) {
-                        scrollTo(pos);
+                        scheduleScrollTo(pos);
                     }
 
                     if (mScrollY > containerTop && mScrollY < containerBottom) {
@@ -1656,6 +1774,7 @@ class SeslRecyclerViewFastScroller {
 
             case MotionEvent.ACTION_CANCEL: {
                 cancelPendingDrag();
+                cancelPendingScroll();
 
                 if (mState == STATE_DRAGGING) {
                     setState(STATE_NONE);
@@ -1842,4 +1961,59 @@ class SeslRecyclerViewFastScroller {
         }
 
     }
+
+    /**
+     * Prefix sums of the heights reported by a {@link RecyclerView.SeslItemHeightProvider},
+     * built once per data set change and searched in O(log n) afterwards.
+     */
+    static class ItemOffsetIndex {
+        // mOffsets[i] is the top of item i, mOffsets[mCount] the total height
+        private long[] mOffsets = new long[1];
+        private int mCount = -1;
+
+        void invalidate() {
+            mCount = -1;
+        }
+
+        void ensure(RecyclerView.SeslItemHeightProvider provider, int itemCount) {
+            if (mCount == itemCount) {
+                return;
+            }
+            if (mOffsets.length < itemCount + 1) {
+                mOffsets = new long[itemCount + 1];
+            }
+            long offset = 0;
+            for (int i = 0; i < itemCount; i++) {
+                mOffsets[i] = offset;
+                offset += Math.max(0, provider.getItemHeight(i));
+            }
+            mOffsets[itemCount] = offset;
+            mCount = itemCount;
+        }
+
+        long getTotalHeight() {
+            return mOffsets[mCount];
+        }
+
+        long getOffset(int position) {
+            return mOffsets[MathUtils.clamp(position, 0, mCount)];
+        }
+
+        /**
+         * @return the last item whose top is at or above {@code offset}
+         */
+        int findPosition(long offset) {
+            int low = 0;
+            int high = mCount - 1;
+            while (low < high) {
+                final int mid = (low + high + 1) >>> 1;
+                if (mOffsets[mid] <= offset) {
+                    low = mid;
+                } else {
+                    high = mid - 1;
+                }
+            }
+            return low;
+        }
+    }
 }
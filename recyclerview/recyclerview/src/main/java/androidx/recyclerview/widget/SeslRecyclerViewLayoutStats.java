@@ -0,0 +1,191 @@
+/*
+ * Copyright 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package androidx.recyclerview.widget;
+
+import android.util.SparseIntArray;
+
+import androidx.annotation.NonNull;
+
+/**
+ * Layout and draw statistics a {@link RecyclerView} collected since the previous frame it drew,
+ * reported after each draw through {@link RecyclerView.SeslOnLayoutStatsListener}.
+ * <p>
+ * The same instance is reset and reused for every frame, so listeners must copy the values
+ * they want to keep. Durations are in nanoseconds.
+ */
+public final class SeslRecyclerViewLayoutStats {
+    private final long[] mLayoutStepNs = new long[3];
+    private final int[] mLayoutStepCount = new int[3];
+
+    private final SparseIntArray mCreateCounts = new SparseIntArray();
+    private final SparseIntArray mBindCounts = new SparseIntArray();
+    private long mCreateNs;
+    private long mBindNs;
+
+    private int mPrefetchHitCount;
+    private int mPrefetchMissCount;
+
+    private long mDecorationDrawNs;
+    private long mSeslDispatchDrawNs;
+    private int mLayoutPassAllocationCount;
+
+    SeslRecyclerViewLayoutStats() {
+    }
+
+    /**
+     * @param step 1, 2 or 3 for {@code dispatchLayoutStep1/2/3}
+     * @return the time spent in that layout step, summed over every time it ran this frame
+     */
+    public long getLayoutStepNanos(int step) {
+        return mLayoutStepNs[step - 1];
+    }
+
+    /**
+     * @param step 1, 2 or 3 for {@code dispatchLayoutStep1/2/3}
+     * @return how many times that layout step ran this frame; step 2 may run more than once when
+     * the RecyclerView is measured with a non exact spec
+     */
+    public int getLayoutStepCount(int step) {
+        return mLayoutStepCount[step - 1];
+    }
+
+    /**
+     * @return ViewHolders created this frame, keyed by view type. Must not be modified.
+     */
+    @NonNull
+    public SparseIntArray getCreateCounts() {
+        return mCreateCounts;
+    }
+
+    /**
+     * @return ViewHolders bound this frame, keyed by view type. Must not be modified.
+     */
+    @NonNull
+    public SparseIntArray getBindCounts() {
+        return mBindCounts;
+    }
+
+    /**
+     * @return time spent in {@link RecyclerView.Adapter#createViewHolder} this frame
+     */
+    public long getCreateNanos() {
+        return mCreateNs;
+    }
+
+    /**
+     * @return time spent in {@link RecyclerView.Adapter#bindViewHolder} this frame
+     */
+    public long getBindNanos() {
+        return mBindNs;
+    }
+
+    /**
+     * @return prefetched ViewHolders the layout picked up from the cache this frame
+     */
+    public int getPrefetchHitCount() {
+        return mPrefetchHitCount;
+    }
+
+    /**
+     * @return prefetched ViewHolders that left the cache for the pool unused this frame
+     */
+    public int getPrefetchMissCount() {
+        return mPrefetchMissCount;
+    }
+
+    /**
+     * @return the share of resolved prefetches that were used, or -1 if none was resolved
+     */
+    public float getPrefetchHitRate() {
+        final int total = mPrefetchHitCount + mPrefetchMissCount;
+        return total == 0 ? -1f : (float) mPrefetchHitCount / total;
+    }
+
+    /**
+     * @return time spent in {@link RecyclerView.ItemDecoration#onDraw} and
+     * {@link RecyclerView.ItemDecoration#onDrawOver} this frame
+     */
+    public long getDecorationDrawNanos() {
+        return mDecorationDrawNs;
+    }
+
+    /**
+     * @return time spent in {@link RecyclerView.ItemDecoration#seslOnDispatchDraw} and in drawing
+     * the fill-bottom area and its rounded corners this frame
+     */
+    public long getSeslDispatchDrawNanos() {
+        return mSeslDispatchDrawNs;
+    }
+
+    /**
+     * @return see {@link RecyclerView#seslGetLayoutPassAllocationCount()}, as of the last layout
+     * pass of this frame
+     */
+    public int getLayoutPassAllocationCount() {
+        return mLayoutPassAllocationCount;
+    }
+
+    void addLayoutStep(int step, long durationNs) {
+        mLayoutStepNs[step - 1] += durationNs;
+        mLayoutStepCount[step - 1]++;
+    }
+
+    void addCreate(int viewType, long durationNs) {
+        mCreateCounts.put(viewType, mCreateCounts.get(viewType) + 1);
+        mCreateNs += durationNs;
+    }
+
+    void addBind(int viewType, long durationNs) {
+        mBindCounts.put(viewType, mBindCounts.get(viewType) + 1);
+        mBindNs += durationNs;
+    }
+
+    void addPrefetchHit() {
+        mPrefetchHitCount++;
+    }
+
+    void addPrefetchMiss() {
+        mPrefetchMissCount++;
+    }
+
+    void addDecorationDraw(long durationNs) {
+        mDecorationDrawNs += durationNs;
+    }
+
+    void addSeslDispatchDraw(long durationNs) {
+        mSeslDispatchDrawNs += durationNs;
+    }
+
+    void setLayoutPassAllocationCount(int count) {
+        mLayoutPassAllocationCount = count;
+    }
+
+    void reset() {
+        for (int i = 0; i < 3; i++) {
+            mLayoutStepNs[i] = 0;
+            mLayoutStepCount[i] = 0;
+        }
+        mCreateCounts.clear();
+        mBindCounts.clear();
+        mCreateNs = 0;
+        mBindNs = 0;
+        mPrefetchHitCount = 0;
+        mPrefetchMissCount = 0;
+        mDecorationDrawNs = 0;
+        mSeslDispatchDrawNs = 0;
+    }
+}
@@ -22,7 +22,9 @@ import android.content.Context;
 import android.graphics.Bitmap;
 import android.graphics.Canvas;
 import android.graphics.Color;
+import android.graphics.ColorFilter;
 import android.graphics.Paint;
+import android.graphics.PixelFormat;
 import android.graphics.PorterDuff;
 import android.graphics.Rect;
 import android.graphics.Typeface;
@@ -66,6 +68,19 @@ public class SeslSwipeListAnimator {
     private Paint mTextPaint = null;
     public float mLastRectAlpha = 0.0f;
 
+    private boolean mHardwareLayerSwipeEnabled = true;
+    // reused by every swipe drawn directly into the list canvas
+    private SwipeBackgroundDrawable mSwipeBackgroundDrawable;
+    private View mLayerView;
+    private int mLayerViewPreviousLayerType = View.LAYER_TYPE_NONE;
+    private final int[] mRecyclerViewLocation = new int[2];
+    private final int[] mViewLocation = new int[2];
+    private final Rect mLeftRect = new Rect();
+    private final Rect mRightRect = new Rect();
+    private final Rect mDrawableBounds = new Rect();
+    private final Rect mTextBounds = new Rect();
+    private final Paint.FontMetrics mFontMetrics = new Paint.FontMetrics();
+
     public static class SwipeConfiguration {
         public int UNSET_VALUE = -1;
 
@@ -148,7 +163,29 @@ public class SeslSwipeListAnimator {
         return Math.round(dip * density);
     }
 
+    /**
+     * Sets whether swipes on hardware accelerated lists draw the swipe background straight
+     * into the list canvas and animate the swiped row on a hardware layer, instead of rendering
+     * the background into a bitmap for every swipe. Enabled by default.
+     */
+    public void setHardwareLayerSwipeEnabled(boolean enabled) {
+        mHardwareLayerSwipeEnabled = enabled;
+    }
+
+    public boolean isHardwareLayerSwipeEnabled() {
+        return mHardwareLayerSwipeEnabled;
+    }
+
     public void doMoveAction(@NonNull Canvas c, @NonNull View viewForeground, float deltaX, boolean isCurrentlyActive) {
+        if (mHardwareLayerSwipeEnabled && c.isHardwareAccelerated()) {
+            if (deltaX != 0f || isCurrentlyActive) {
+                doHardwareMoveAction(c, viewForeground, deltaX);
+            } else {
+                clearSwipeAnimation(viewForeground);
+            }
+            return;
+        }
+
         Log.i(TAG, "doMoveAction: viewForeground = " + viewForeground +
                 " deltaX = " + deltaX + ", isCurrentlyActive = " + isCurrentlyActive);
 
@@ -174,112 +211,156 @@ public class SeslSwipeListAnimator {
         }
     }
 
-    private int calculateTopOfList(View view) {
-        final int top = view.getTop();
-        View parent = (View) view.getParent();
-        return (parent != null && !(parent instanceof RecyclerView)) ?
-                top + calculateTopOfList(parent) : top;
-    }
-
-    private Canvas drawRectToBitmapCanvas(View view, float deltaX, float swipeProgress) {
-
-        int[] recyclerViewLocation = new int[2];
-        mRecyclerView.getLocationInWindow(recyclerViewLocation);
+    /**
+     * Draws the swipe background with the reused {@link SwipeBackgroundDrawable} and moves the
+     * live row, which is kept on a hardware layer so that its translation and alpha changes
+     * only update RenderNode properties.
+     */
+    private void doHardwareMoveAction(Canvas c, View viewForeground, float deltaX) {
+        if (mLayerView != viewForeground) {
+            restoreLayerType();
+            mLayerView = viewForeground;
+            mLayerViewPreviousLayerType = viewForeground.getLayerType();
+            if (mLayerViewPreviousLayerType != View.LAYER_TYPE_HARDWARE) {
+                viewForeground.setLayerType(View.LAYER_TYPE_HARDWARE, null);
+            }
+        }
 
-        int[] viewLocation = new int[2];
-        view.setTranslationX(0.0F);
-        view.getLocationInWindow(viewLocation);
-        viewLocation[0] -= recyclerViewLocation[0];
+        updateSwipeRect(viewForeground);
+        final int viewWidth = viewForeground.getWidth();
+        final float alpha = updateSwipeAlpha(viewForeground, deltaX, viewWidth);
 
-        int topOfList = this.calculateTopOfList(view);
-        int viewWidth = view.getWidth();
-        int viewHeight = view.getHeight();
+        viewForeground.setTranslationX(deltaX);
+        float centerX = viewWidth / 2.0f;
+        float opacity = (Math.min(Math.abs(deltaX), centerX) / centerX);
+        viewForeground.setAlpha(Math.min(1.0f - opacity, 1.0f));
 
-        mSwipeRect = new Rect(viewLocation[0] + view.getPaddingLeft(), topOfList,
-                viewLocation[0] + viewWidth - view.getPaddingRight(), topOfList + viewHeight);
+        if (mSwipeBackgroundDrawable == null) {
+            mSwipeBackgroundDrawable = new SwipeBackgroundDrawable();
+        }
+        mSwipeBackgroundDrawable.update(viewWidth, viewForeground.getHeight(), deltaX,
+                deltaX / viewWidth, alpha);
+        mSwipeBackgroundDrawable.setBounds(mSwipeRect);
+        mRecyclerView.invalidate(mSwipeRect);
+        mSwipeBackgroundDrawable.draw(c);
+    }
 
-        if (mSwipeBitmap == null) {
-            mSwipeBitmap = Bitmap.createBitmap(viewWidth, viewHeight, Bitmap.Config.ARGB_8888);
+    private void restoreLayerType() {
+        if (mLayerView != null) {
+            if (mLayerView.getLayerType() != mLayerViewPreviousLayerType) {
+                mLayerView.setLayerType(mLayerViewPreviousLayerType, null);
+            }
+            mLayerView = null;
         }
+    }
 
-        Canvas canvas = new Canvas(this.mSwipeBitmap);
-        canvas.drawColor(0, PorterDuff.Mode.CLEAR);
+    /**
+     * Updates {@link #mSwipeRect} to the bounds of the given row in the list, without its
+     * translation.
+     */
+    private void updateSwipeRect(View view) {
+        mRecyclerView.getLocationInWindow(mRecyclerViewLocation);
+        view.setTranslationX(0.0F);
+        view.getLocationInWindow(mViewLocation);
+        final int left = mViewLocation[0] - mRecyclerViewLocation[0];
+        final int topOfList = calculateTopOfList(view);
+        if (mSwipeRect == null) {
+            mSwipeRect = new Rect();
+        }
+        mSwipeRect.set(left + view.getPaddingLeft(), topOfList,
+                left + view.getWidth() - view.getPaddingRight(), topOfList + view.getHeight());
+    }
 
+    /**
+     * Returns the alpha of the faded part of the swipe background, performing the haptic
+     * feedback when the swipe crosses the middle of the row.
+     */
+    private float updateSwipeAlpha(View view, float deltaX, int viewWidth) {
         float centerX = viewWidth / 2.0f;
-        float absDeltaX = Math.abs(deltaX);
-        float alpha = (Math.min(absDeltaX, centerX) / centerX) * 255.0f;
-
+        float alpha = (Math.min(Math.abs(deltaX), centerX) / centerX) * 255.0f;
         if (mLastRectAlpha != 255.0f && alpha == 255.0f) {
             view.performHapticFeedback(SeslHapticFeedbackConstantsReflector.semGetVibrationIndex((108)));
         } else if (mLastRectAlpha == 255.0f && alpha != 255.0f) {
             view.performHapticFeedback(SeslHapticFeedbackConstantsReflector.semGetVibrationIndex(109));
         }
         mLastRectAlpha = alpha;
+        return alpha;
+    }
 
-        int startX;
+    /**
+     * Draws the swipe background of a row of the given size with its top left corner at the
+     * origin of the canvas, without allocating.
+     */
+    void drawSwipeBackground(Canvas canvas, int viewWidth, int viewHeight, float deltaX,
+            float swipeProgress, float alpha) {
         if (swipeProgress > 0.0F) {
             Drawable dltr = mSwipeConfiguration.drawableLeftToRight;
-
-            Rect drawableBounds;
             if (dltr != null) {
-                drawableBounds = dltr.getBounds();
-                int drawableWidth = drawableBounds.width();
-                int drawableHeight = drawableBounds.height();
-
-                Log.i(TAG, "#1 draw LtoR, d = " + dltr + ", d.getBounds()=" + drawableBounds);
-                int drawablePadding = mSwipeConfiguration.drawablePadding;
-                drawableBounds = new Rect(drawablePadding, 0, drawableWidth + drawablePadding, drawableHeight);
-                drawableBounds.offset(0, (viewHeight - drawableHeight) / 2);
+                final Rect bounds = dltr.getBounds();
+                final int drawableWidth = bounds.width();
+                final int drawableHeight = bounds.height();
+                final int drawablePadding = mSwipeConfiguration.drawablePadding;
+                mDrawableBounds.set(drawablePadding, 0, drawableWidth + drawablePadding,
+                        drawableHeight);
+                mDrawableBounds.offset(0, (viewHeight - drawableHeight) / 2);
             } else {
-                Log.i(TAG, "#2 draw LtoR, d = null");
-                drawableBounds = new Rect(0, 0, 0, 0);
+                mDrawableBounds.set(0, 0, 0, 0);
             }
-
-            startX = (int) deltaX;
-
-            Rect leftRect = new Rect(0, 0, startX, viewHeight);
-            Paint leftPaint = mBgLeftToRight;
-            drawRectInto(canvas, leftRect, drawableBounds, dltr, leftPaint, 255,
-                    mSwipeConfiguration.textLeftToRight,  mSwipeConfiguration.textSize, 0);
-
-            Rect rightRect = new Rect(startX, 0, viewWidth, viewHeight);
-            drawRectInto(canvas, rightRect, drawableBounds, dltr, mBgLeftToRight, (int) alpha,
-                    mSwipeConfiguration.textLeftToRight, mSwipeConfiguration.textSize, 0);
-
+            final int startX = (int) deltaX;
+            mLeftRect.set(0, 0, startX, viewHeight);
+            drawRectInto(canvas, mLeftRect, mDrawableBounds, dltr, mBgLeftToRight, 255,
+                    mSwipeConfiguration.textLeftToRight, viewHeight, 0);
+            mRightRect.set(startX, 0, viewWidth, viewHeight);
+            drawRectInto(canvas, mRightRect, mDrawableBounds, dltr, mBgLeftToRight, (int) alpha,
+                    mSwipeConfiguration.textLeftToRight, viewHeight, 0);
         } else if (swipeProgress < 0.0F) {
             Drawable drtl = mSwipeConfiguration.drawableRightToLeft;
-
-            Rect drawableBounds;
             if (drtl != null) {
-                drawableBounds = drtl.getBounds();
-                int drawableWidth = drawableBounds.width();
-                int drawableHeight = drawableBounds.height();
-                int right = viewWidth - mSwipeConfiguration.drawablePadding;
-                Log.i(TAG, "#3 draw RtoL, d = " + drtl + ", d.getBounds()=" + drawableBounds);
-
-                drawableBounds = new Rect(right - drawableWidth, 0, right, drawableHeight);
-                drawableBounds.offset(0, (viewHeight - drawableHeight) / 2);
+                final Rect bounds = drtl.getBounds();
+                final int drawableWidth = bounds.width();
+                final int drawableHeight = bounds.height();
+                final int right = viewWidth - mSwipeConfiguration.drawablePadding;
+                mDrawableBounds.set(right - drawableWidth, 0, right, drawableHeight);
+                mDrawableBounds.offset(0, (viewHeight - drawableHeight) / 2);
             } else {
-                Log.i(TAG, "#4 draw RtoL, d = null");
-                drawableBounds = new Rect(viewWidth, 0, viewWidth, 0);
+                mDrawableBounds.set(viewWidth, 0, viewWidth, 0);
             }
+            final int left = viewWidth - (int) Math.abs(deltaX);
+            mLeftRect.set(left, 0, viewWidth, viewHeight);
+            drawRectInto(canvas, mLeftRect, mDrawableBounds, drtl, mBgRightToLeft, 255,
+                    mSwipeConfiguration.textRightToLeft, viewHeight, 1);
+            mRightRect.set(0, 0, left, viewHeight);
+            drawRectInto(canvas, mRightRect, mDrawableBounds, drtl, mBgRightToLeft, (int) alpha,
+                    mSwipeConfiguration.textRightToLeft, viewHeight, 1);
+        }
+    }
 
-            int left = viewWidth - (int) absDeltaX;
-            Rect leftRect = new Rect(left, 0, viewWidth, viewHeight);
-            Paint leftPaint = this.mBgRightToLeft;
+    private int calculateTopOfList(View view) {
+        final int top = view.getTop();
+        View parent = (View) view.getParent();
+        return (parent != null && !(parent instanceof RecyclerView)) ?
+                top + calculateTopOfList(parent) : top;
+    }
 
-            drawRectInto(canvas, leftRect, drawableBounds, drtl, leftPaint, 255,
-                    mSwipeConfiguration.textRightToLeft, mSwipeConfiguration.textSize, 1);
+    private Canvas drawRectToBitmapCanvas(View view, float deltaX, float swipeProgress) {
+        updateSwipeRect(view);
+        int viewWidth = view.getWidth();
+        int viewHeight = view.getHeight();
 
-            Rect rightRect = new Rect(0, 0, left, viewHeight);
-            drawRectInto(canvas, rightRect, drawableBounds, drtl, mBgRightToLeft, (int) alpha,
-                    mSwipeConfiguration.textRightToLeft, mSwipeConfiguration.textSize, 1);
+        if (mSwipeBitmap == null) {
+            mSwipeBitmap = Bitmap.createBitmap(viewWidth, viewHeight, Bitmap.Config.ARGB_8888);
         }
+
+        Canvas canvas = new Canvas(this.mSwipeBitmap);
+        canvas.drawColor(0, PorterDuff.Mode.CLEAR);
+
+        float alpha = updateSwipeAlpha(view, deltaX, viewWidth);
+        drawSwipeBackground(canvas, viewWidth, viewHeight, deltaX, swipeProgress, alpha);
         return canvas;
     }
 
     private void drawRectInto(Canvas canvas, Rect destinationRect, Rect sourceRect, Drawable drawable,
-            Paint paint, int alpha, String text, float textStartX, int textAlignment) {
+            Paint paint, int alpha, String text, int height, int textAlignment) {
 
         canvas.save();
         paint.setAlpha(alpha);
@@ -293,21 +374,23 @@ public class SeslSwipeListAnimator {
             drawable.draw(canvas);
         }
 
-        drawSwipeText(canvas, mTextPaint, text, textAlignment, sourceRect);
+        drawSwipeText(canvas, mTextPaint, text, textAlignment, sourceRect, height);
         canvas.restore();
     }
 
 
-    private void drawSwipeText(Canvas canvas, Paint textPaint, String text, int direction, Rect bounds) {
-        Rect textBounds = new Rect();
+    private void drawSwipeText(Canvas canvas, Paint textPaint, String text, int direction, Rect bounds,
+            int height) {
+        Rect textBounds = mTextBounds;
 
         textPaint.setTextAlign(Paint.Align.LEFT);
         textPaint.getTextBounds(text, 0, text.length(), textBounds);
 
-        Paint.FontMetrics fontMetrics = textPaint.getFontMetrics();
+        Paint.FontMetrics fontMetrics = mFontMetrics;
+        textPaint.getFontMetrics(fontMetrics);
 
         float textHeight = Math.abs(fontMetrics.top - fontMetrics.bottom);
-        float centerY = (float) canvas.getHeight() / 2.0F;
+        float centerY = (float) height / 2.0F;
         float textCenter = textHeight / 2.0F;
         float descent = fontMetrics.bottom;
         float y = (centerY + textCenter) - descent;
@@ -336,6 +419,7 @@ public class SeslSwipeListAnimator {
         Log.i(TAG, "clearSwipeAnimation: view = " + view +
                 " mDrawSwipeBitmapDrawable = " + mDrawSwipeBitmapDrawable);
         this.mLastRectAlpha = 0.0f;
+        restoreLayerType();
 
         if (mDrawSwipeBitmapDrawable != null) {
             mDrawSwipeBitmapDrawable.getBitmap().recycle();
@@ -364,6 +448,56 @@ public class SeslSwipeListAnimator {
     }
 
 
+    /**
+     * Background of the swiped row, drawn straight into the list canvas. A single instance is
+     * kept and updated for every move.
+     */
+    private class SwipeBackgroundDrawable extends Drawable {
+        private int mViewWidth;
+        private int mViewHeight;
+        private float mDeltaX;
+        private float mSwipeProgress;
+        private float mBackgroundAlpha;
+
+        void update(int viewWidth, int viewHeight, float deltaX, float swipeProgress,
+                float alpha) {
+            mViewWidth = viewWidth;
+            mViewHeight = viewHeight;
+            mDeltaX = deltaX;
+            mSwipeProgress = swipeProgress;
+            mBackgroundAlpha = alpha;
+        }
+
+        @Override
+        public void draw(@NonNull Canvas canvas) {
+            final Rect bounds = getBounds();
+            if (mViewWidth <= 0 || bounds.isEmpty()) {
+                return;
+            }
+            canvas.save();
+            canvas.clipRect(bounds);
+            canvas.translate(bounds.left, bounds.top);
+            // the bitmap of the row was stretched into the bounds without the row padding
+            canvas.scale(bounds.width() / (float) mViewWidth, 1f);
+            drawSwipeBackground(canvas, mViewWidth, mViewHeight, mDeltaX, mSwipeProgress,
+                    mBackgroundAlpha);
+            canvas.restore();
+        }
+
+        @Override
+        public void setAlpha(int alpha) {
+        }
+
+        @Override
+        public void setColorFilter(@Nullable ColorFilter colorFilter) {
+        }
+
+        @Override
+        public int getOpacity() {
+            return PixelFormat.TRANSLUCENT;
+        }
+    }
+
     private void drawTextToCenter(Canvas canvas, Paint paint, String text) {
         final int height = canvas.getHeight();
         final int width = canvas.getWidth();
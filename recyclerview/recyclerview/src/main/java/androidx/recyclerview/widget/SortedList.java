@@ -25,6 +25,7 @@ import java.lang.reflect.Array;
 import java.util.Arrays;
 import java.util.Collection;
 import java.util.Comparator;
+import java.util.IdentityHashMap;
 
 /**
  * A Sorted list implementation that can keep items in order and also notify for changes in the
@@ -83,6 +84,44 @@ public class SortedList<T> {
     private int mSize;
     private final Class<T> mTClass;
 
+    /**
+     * Whether mutations are buffered until {@link #seslFlushBufferedUpdates()}.
+     */
+    private boolean mBufferingUpdates;
+
+    /**
+     * The buffered adds and removes, one per item. The holders are kept and reused by later
+     * buffers.
+     */
+    private BufferedUpdate<T>[] mBufferedUpdates;
+    private int mBufferedUpdateCount;
+    private int mBufferedUpdateSequence;
+
+    /**
+     * Indices in mData removed while buffering, e.g. by {@link #updateItemAt}.
+     */
+    private boolean[] mBufferedRemovedIndices;
+    private int mBufferedRemovedIndexCount;
+
+    /**
+     * For each index in mData, the buffered update that holds the latest state of the item that
+     * was there, if any.
+     */
+    private BufferedUpdate<T>[] mBufferedIndexUpdates;
+
+    /**
+     * The buffered updates by the item they hold, so that later changes of the same object
+     * replace the earlier ones.
+     */
+    private IdentityHashMap<T, BufferedUpdate<T>> mBufferedUpdatesByItem;
+
+    private Comparator<BufferedUpdate<T>> mBufferedUpdateComparator;
+
+    /**
+     * The data array replaced by the last flush, reused as the target of the next one.
+     */
+    private T[] mSpareData;
+
     /**
      * Creates a new SortedList of type T.
      *
@@ -143,6 +182,10 @@ public class SortedList<T> {
      */
     public int add(T item) {
         throwIfInMutationOperation();
+        if (mBufferingUpdates) {
+            bufferItemUpdate(item, false);
+            return INVALID_POSITION;
+        }
         return add(item, true);
     }
 
@@ -165,6 +208,12 @@ public class SortedList<T> {
         if (items.length == 0) {
             return;
         }
+        if (mBufferingUpdates) {
+            for (T item : items) {
+                bufferItemUpdate(item, false);
+            }
+            return;
+        }
 
         if (mayModifyInput) {
             addAllInternal(items);
@@ -217,6 +266,8 @@ public class SortedList<T> {
      */
     public void replaceAll(@NonNull T[] items, boolean mayModifyInput) {
         throwIfInMutationOperation();
+        // the new items replace whatever was buffered
+        discardBufferedUpdates();
 
         if (mayModifyInput) {
             replaceAllInternal(items);
@@ -540,6 +591,394 @@ public class SortedList<T> {
         }
     }
 
+    /**
+     * Starts buffering the mutations made to this list until {@link #seslFlushBufferedUpdates()}
+     * or {@link #seslEndBufferedUpdates()} is called.
+     * <p>
+     * This is meant for lists that receive a stream of updates in no particular order, such as
+     * live data feeds. Instead of finding and shifting every item as it arrives, the buffered
+     * adds, removes and updates are applied together in a single linear merge, which dispatches
+     * the changes as position ordered {@link Callback#onInserted(int, int)},
+     * {@link Callback#onRemoved(int, int)} and {@link Callback#onChanged(int, int)} ranges through
+     * a {@link BatchedCallback}. Flushing once per frame, e.g. from a
+     * {@link android.view.Choreographer.FrameCallback}, keeps the list up to date with a single
+     * merge per frame.
+     * <p>
+     * While buffering:
+     * <ul>
+     *     <li>{@link #get(int)}, {@link #size()} and {@link #indexOf(Object)} return the data as
+     *     of the last flush, and indices passed to {@link #removeItemAt(int)},
+     *     {@link #updateItemAt(int, Object)} and {@link #recalculatePositionOfItemAt(int)} refer
+     *     to it as well.</li>
+     *     <li>{@link #add(Object)} returns {@link #INVALID_POSITION} and {@link #remove(Object)}
+     *     returns true, since the change is not applied yet.</li>
+     *     <li>Later changes to the same item win over earlier ones, even if they change its sort
+     *     order. A change is matched to an earlier one of the same item by the index it was made
+     *     at, by the position of the item as of the last flush, by object identity, or by
+     *     {@link Callback#areItemsTheSame(Object, Object)} among items that sort equally.</li>
+     *     <li>Items that change position are reported as a removal and an insertion instead of
+     *     {@link Callback#onMoved(int, int)}, like {@link #replaceAll(Object[])} does.</li>
+     *     <li>{@link #clear()} and {@link #replaceAll(Object[])} drop the buffered changes.</li>
+     * </ul>
+     */
+    public void seslBeginBufferedUpdates() {
+        throwIfInMutationOperation();
+        mBufferingUpdates = true;
+    }
+
+    /**
+     * Applies the changes buffered since {@link #seslBeginBufferedUpdates()} or the previous
+     * flush, and keeps buffering.
+     */
+    public void seslFlushBufferedUpdates() {
+        throwIfInMutationOperation();
+        if (mBufferedUpdateCount == 0 && mBufferedRemovedIndexCount == 0) {
+            return;
+        }
+        final int updateCount = sortAndDedupBufferedUpdates();
+        // the merge clears the removed indices as it passes them
+        mergeBufferedUpdates(updateCount);
+        recycleBufferedUpdates();
+        mBufferedRemovedIndexCount = 0;
+    }
+
+    /**
+     * Applies the buffered changes and stops buffering.
+     *
+     * @see #seslBeginBufferedUpdates()
+     */
+    public void seslEndBufferedUpdates() {
+        seslFlushBufferedUpdates();
+        mBufferingUpdates = false;
+    }
+
+    /**
+     * Returns the number of changes waiting for {@link #seslFlushBufferedUpdates()}.
+     */
+    public int seslGetBufferedUpdateCount() {
+        return mBufferedUpdateCount + mBufferedRemovedIndexCount;
+    }
+
+    /**
+     * Buffers an add or a remove by item. If the item, or an earlier state of it, is still in the
+     * data as of the last flush, this replaces the update of its index instead.
+     */
+    private void bufferItemUpdate(T item, boolean remove) {
+        BufferedUpdate<T> update =
+                mBufferedUpdatesByItem == null ? null : mBufferedUpdatesByItem.get(item);
+        if (update == null) {
+            final int index = findIndexOf(item, mData, 0, mSize, DELETION);
+            if (index != INVALID_POSITION) {
+                bufferIndexUpdate(index, item, remove, false);
+                return;
+            }
+            update = obtainBufferedUpdate();
+        }
+        setBufferedUpdate(update, item, remove, false);
+    }
+
+    /**
+     * Buffers the removal of the item at the given index of the data as of the last flush, and
+     * unless {@code remove} is set, the item that takes its place in the sorted order.
+     */
+    private void bufferIndexUpdate(int index, T item, boolean remove, boolean forceChange) {
+        if (mBufferedRemovedIndices == null || mBufferedRemovedIndices.length < mSize) {
+            final int capacity = Math.max(mSize, MIN_CAPACITY);
+            final boolean[] removed = new boolean[capacity];
+            final BufferedUpdate<T>[] indexUpdates = new BufferedUpdate[capacity];
+            if (mBufferedRemovedIndices != null) {
+                System.arraycopy(mBufferedRemovedIndices, 0, removed, 0,
+                        mBufferedRemovedIndices.length);
+                System.arraycopy(mBufferedIndexUpdates, 0, indexUpdates, 0,
+                        mBufferedIndexUpdates.length);
+            }
+            mBufferedRemovedIndices = removed;
+            mBufferedIndexUpdates = indexUpdates;
+        }
+        if (!mBufferedRemovedIndices[index]) {
+            mBufferedRemovedIndices[index] = true;
+            mBufferedRemovedIndexCount++;
+        }
+        BufferedUpdate<T> update = mBufferedIndexUpdates[index];
+        if (update == null) {
+            if (remove) {
+                // removing the index is all there is to do
+                return;
+            }
+            update = obtainBufferedUpdate();
+            update.mIndex = index;
+            mBufferedIndexUpdates[index] = update;
+        }
+        // a removal keeps the item, so that later changes of that object still find the update
+        setBufferedUpdate(update, remove ? update.mItem : item, remove, forceChange);
+    }
+
+    private BufferedUpdate<T> obtainBufferedUpdate() {
+        if (mBufferedUpdates == null) {
+            mBufferedUpdates = new BufferedUpdate[MIN_CAPACITY];
+        } else if (mBufferedUpdateCount == mBufferedUpdates.length) {
+            mBufferedUpdates = Arrays.copyOf(mBufferedUpdates, mBufferedUpdateCount * 2);
+        }
+        BufferedUpdate<T> update = mBufferedUpdates[mBufferedUpdateCount];
+        if (update == null) {
+            update = new BufferedUpdate<>();
+            mBufferedUpdates[mBufferedUpdateCount] = update;
+        }
+        mBufferedUpdateCount++;
+        return update;
+    }
+
+    private void setBufferedUpdate(BufferedUpdate<T> update, T item, boolean remove,
+            boolean forceChange) {
+        if (update.mItem != item) {
+            if (mBufferedUpdatesByItem == null) {
+                mBufferedUpdatesByItem = new IdentityHashMap<>();
+            } else if (update.mItem != null
+                    && mBufferedUpdatesByItem.get(update.mItem) == update) {
+                mBufferedUpdatesByItem.remove(update.mItem);
+            }
+            update.mItem = item;
+            mBufferedUpdatesByItem.put(item, update);
+        }
+        update.mRemove = remove;
+        // a change forced by giving back the same object is not undone by later changes
+        update.mForceChange |= forceChange;
+        update.mSequence = mBufferedUpdateSequence++;
+    }
+
+    private void recycleBufferedUpdates() {
+        for (int i = 0; i < mBufferedUpdateCount; i++) {
+            final BufferedUpdate<T> update = mBufferedUpdates[i];
+            if (update.mIndex != INVALID_POSITION) {
+                mBufferedIndexUpdates[update.mIndex] = null;
+            }
+            update.mItem = null;
+            update.mIndex = INVALID_POSITION;
+            update.mRemove = false;
+            update.mForceChange = false;
+        }
+        mBufferedUpdateCount = 0;
+        mBufferedUpdateSequence = 0;
+        if (mBufferedUpdatesByItem != null) {
+            mBufferedUpdatesByItem.clear();
+        }
+    }
+
+    private void discardBufferedUpdates() {
+        recycleBufferedUpdates();
+        if (mBufferedRemovedIndexCount > 0) {
+            Arrays.fill(mBufferedRemovedIndices, false);
+            mBufferedRemovedIndexCount = 0;
+        }
+    }
+
+    /**
+     * Sorts the buffered updates and drops the ones that have nothing left to merge or are
+     * overridden by a later update of the same item. Updates that are dropped are moved past the
+     * returned count.
+     * <p>
+     * Changes of the same index or the same object already share an update, which leaves
+     * different objects of the same item, matched by {@link Callback#areItemsTheSame} among the
+     * updates that sort equally.
+     *
+     * @return Number of updates to merge at the beginning of the buffer.
+     */
+    private int sortAndDedupBufferedUpdates() {
+        final BufferedUpdate<T>[] updates = mBufferedUpdates;
+        int mergeCount = 0;
+        for (int i = 0; i < mBufferedUpdateCount; i++) {
+            final BufferedUpdate<T> update = updates[i];
+            if (update.mRemove && update.mIndex != INVALID_POSITION) {
+                // only removes its index, which the merge does by itself
+                continue;
+            }
+            updates[i] = updates[mergeCount];
+            updates[mergeCount++] = update;
+        }
+        if (mergeCount == 0) {
+            return 0;
+        }
+        if (mBufferedUpdateComparator == null) {
+            mBufferedUpdateComparator = new Comparator<BufferedUpdate<T>>() {
+                @Override
+                public int compare(BufferedUpdate<T> o1, BufferedUpdate<T> o2) {
+                    final int result = mCallback.compare(o1.mItem, o2.mItem);
+                    // updates of the same item stay in the order they were last changed
+                    return result != 0 ? result : Integer.compare(o1.mSequence, o2.mSequence);
+                }
+            };
+        }
+        Arrays.sort(updates, 0, mergeCount, mBufferedUpdateComparator);
+        int count = 0;
+        int rangeStart = 0;
+        for (int i = 0; i < mergeCount; i++) {
+            final BufferedUpdate<T> update = updates[i];
+            if (count > rangeStart
+                    && mCallback.compare(updates[rangeStart].mItem, update.mItem) != 0) {
+                rangeStart = count;
+            }
+            int same = INVALID_POSITION;
+            for (int pos = rangeStart; pos < count; pos++) {
+                if (mCallback.areItemsTheSame(updates[pos].mItem, update.mItem)) {
+                    same = pos;
+                    break;
+                }
+            }
+            if (same != INVALID_POSITION) {
+                // the later update wins, keep the holder of the earlier one at the dropped end
+                updates[i] = updates[same];
+                updates[same] = update;
+            } else {
+                updates[i] = updates[count];
+                updates[count++] = update;
+            }
+        }
+        return count;
+    }
+
+    /**
+     * Merges the sorted updates with the current data in one pass, skipping the indices that
+     * were removed by index.
+     */
+    private void mergeBufferedUpdates(int updateCount) {
+        final boolean forceBatchedUpdates = !(mCallback instanceof BatchedCallback);
+        if (forceBatchedUpdates) {
+            beginBatchedUpdates();
+        }
+
+        mOldData = mData;
+        mOldDataStart = 0;
+        mOldDataSize = mSize;
+
+        final int mergedCapacity = mSize + updateCount + CAPACITY_GROWTH;
+        if (mSpareData != null && mSpareData.length >= mergedCapacity) {
+            mData = mSpareData;
+        } else {
+            mData = (T[]) Array.newInstance(mTClass, mergedCapacity);
+        }
+        mSpareData = null;
+        mNewDataStart = 0;
+
+        final BufferedUpdate<T>[] updates = mBufferedUpdates;
+        final boolean[] removedIndices = mBufferedRemovedIndices;
+        int updateStart = 0;
+        while (mOldDataStart < mOldDataSize || updateStart < updateCount) {
+            if (mOldDataStart < mOldDataSize && mBufferedRemovedIndexCount > 0
+                    && removedIndices[mOldDataStart]) {
+                removedIndices[mOldDataStart] = false;
+                final T oldItem = mOldData[mOldDataStart];
+                final BufferedUpdate<T> update =
+                        updateStart < updateCount ? updates[updateStart] : null;
+                if (update != null && !update.mRemove
+                        && mCallback.areItemsTheSame(oldItem, update.mItem)
+                        && fitsBeforeNextOldItem(update.mItem)) {
+                    // The item was updated and stays in place, replace it.
+                    updateStart++;
+                    replaceOldItem(oldItem, update);
+                } else {
+                    mOldDataStart++;
+                    mSize--;
+                    mCallback.onRemoved(mNewDataStart, 1);
+                }
+                continue;
+            }
+
+            if (updateStart == updateCount) {
+                // No more updates, keep the old item.
+                mData[mNewDataStart++] = mOldData[mOldDataStart++];
+                continue;
+            }
+
+            final BufferedUpdate<T> update = updates[updateStart];
+            if (mOldDataStart == mOldDataSize) {
+                updateStart++;
+                insertUpdate(update);
+                continue;
+            }
+
+            final T oldItem = mOldData[mOldDataStart];
+            final int compare = mCallback.compare(oldItem, update.mItem);
+            if (compare > 0) {
+                // The update is lower, the item cannot be in the old data.
+                updateStart++;
+                insertUpdate(update);
+            } else if (compare == 0) {
+                final int same = findSameUpdate(oldItem, updateStart, updateCount);
+                if (same == INVALID_POSITION) {
+                    // Different item with the same sort order, the update is applied later.
+                    mData[mNewDataStart++] = oldItem;
+                    mOldDataStart++;
+                    continue;
+                }
+                final BufferedUpdate<T> sameUpdate = updates[same];
+                updates[same] = updates[updateStart];
+                updates[updateStart++] = sameUpdate;
+                if (sameUpdate.mRemove) {
+                    mOldDataStart++;
+                    mSize--;
+                    mCallback.onRemoved(mNewDataStart, 1);
+                } else {
+                    replaceOldItem(oldItem, sameUpdate);
+                }
+            } else {
+                mData[mNewDataStart++] = oldItem;
+                mOldDataStart++;
+            }
+        }
+
+        Arrays.fill(mOldData, 0, mOldDataSize, null);
+        mSpareData = mOldData;
+        mOldData = null;
+
+        if (forceBatchedUpdates) {
+            endBatchedUpdates();
+        }
+    }
+
+    private void insertUpdate(BufferedUpdate<T> update) {
+        if (update.mRemove) {
+            // removal of an item that is not in the list
+            return;
+        }
+        mData[mNewDataStart++] = update.mItem;
+        mSize++;
+        mCallback.onInserted(mNewDataStart - 1, 1);
+    }
+
+    private void replaceOldItem(T oldItem, BufferedUpdate<T> update) {
+        mData[mNewDataStart++] = update.mItem;
+        mOldDataStart++;
+        if (update.mForceChange || !mCallback.areContentsTheSame(oldItem, update.mItem)) {
+            mCallback.onChanged(mNewDataStart - 1, 1,
+                    mCallback.getChangePayload(oldItem, update.mItem));
+        }
+    }
+
+    /**
+     * Returns whether the item sorts before the next old item that is not removed by index.
+     */
+    private boolean fitsBeforeNextOldItem(T item) {
+        int next = mOldDataStart + 1;
+        while (next < mOldDataSize && mBufferedRemovedIndices[next]) {
+            next++;
+        }
+        return next == mOldDataSize || mCallback.compare(item, mOldData[next]) <= 0;
+    }
+
+    private int findSameUpdate(T item, int from, int to) {
+        final T first = mBufferedUpdates[from].mItem;
+        for (int pos = from; pos < to; pos++) {
+            final T updateItem = mBufferedUpdates[pos].mItem;
+            if (pos > from && mCallback.compare(first, updateItem) != 0) {
+                break;
+            }
+            if (mCallback.areItemsTheSame(item, updateItem)) {
+                return pos;
+            }
+        }
+        return INVALID_POSITION;
+    }
+
     private int add(T item, boolean notify) {
         int index = findIndexOf(item, mData, 0, mSize, INSERTION);
         if (index == INVALID_POSITION) {
@@ -574,6 +1013,10 @@ public class SortedList<T> {
      */
     public boolean remove(T item) {
         throwIfInMutationOperation();
+        if (mBufferingUpdates) {
+            bufferItemUpdate(item, true);
+            return true;
+        }
         return remove(item, true);
     }
 
@@ -587,6 +1030,10 @@ public class SortedList<T> {
     public T removeItemAt(int index) {
         throwIfInMutationOperation();
         T item = get(index);
+        if (mBufferingUpdates) {
+            bufferIndexUpdate(index, null, true, false);
+            return item;
+        }
         removeItemAtIndex(index, true);
         return item;
     }
@@ -632,6 +1079,11 @@ public class SortedList<T> {
     public void updateItemAt(int index, T item) {
         throwIfInMutationOperation();
         final T existing = get(index);
+        if (mBufferingUpdates) {
+            // assume changed if the same object is given back
+            bufferIndexUpdate(index, item, false, existing == item);
+            return;
+        }
         // assume changed if the same object is given back
         boolean contentsChanged = existing == item || !mCallback.areContentsTheSame(existing, item);
         if (existing != item) {
@@ -687,6 +1139,10 @@ public class SortedList<T> {
         throwIfInMutationOperation();
         // TODO can be improved
         final T item = get(index);
+        if (mBufferingUpdates) {
+            bufferIndexUpdate(index, item, false, false);
+            return;
+        }
         removeItemAtIndex(index, false);
         int newIndex = add(item, false);
         if (index != newIndex) {
@@ -822,6 +1278,7 @@ public class SortedList<T> {
      */
     public void clear() {
         throwIfInMutationOperation();
+        discardBufferedUpdates();
         if (mSize == 0) {
             return;
         }
@@ -831,6 +1288,24 @@ public class SortedList<T> {
         mCallback.onRemoved(0, prevSize);
     }
 
+    /**
+     * A buffered add or remove, see {@link #seslBeginBufferedUpdates()}.
+     */
+    private static class BufferedUpdate<T2> {
+        T2 mItem;
+        boolean mRemove;
+        boolean mForceChange;
+        /**
+         * The index in the data as of the last flush whose item this update replaces, or
+         * {@link SortedList#INVALID_POSITION}.
+         */
+        int mIndex = INVALID_POSITION;
+        /**
+         * Order of the last change made to this update.
+         */
+        int mSequence;
+    }
+
     /**
      * The class that controls the behavior of the {@link SortedList}.
      * <p>
@@ -820,10 +820,7 @@ public class StaggeredGridLayoutManager extends RecyclerView.LayoutManager imple
         } else {
             anchorInfo.mLayoutFromEnd = mShouldReverseLayout;
         }
-        if (mPendingSavedState.mSpanLookupSize > 1) {
-            mLazySpanLookup.mData = mPendingSavedState.mSpanLookup;
-            mLazySpanLookup.mFullSpanItems = mPendingSavedState.mFullSpanItems;
-        }
+        mLazySpanLookup.restoreFrom(mPendingSavedState);
     }
 
     void updateAnchorInfoForLayout(RecyclerView.State state, AnchorInfo anchorInfo) {
@@ -1249,10 +1246,8 @@ public class StaggeredGridLayoutManager extends RecyclerView.LayoutManager imple
         state.mAnchorLayoutFromEnd = mLastLayoutFromEnd;
         state.mLastLayoutRTL = mLastLayoutRTL;
 
-        if (mLazySpanLookup != null && mLazySpanLookup.mData != null) {
-            state.mSpanLookup = mLazySpanLookup.mData;
-            state.mSpanLookupSize = state.mSpanLookup.length;
-            state.mFullSpanItems = mLazySpanLookup.mFullSpanItems;
+        if (mLazySpanLookup != null && mLazySpanLookup.length() > 0) {
+            mLazySpanLookup.saveTo(state);
         } else {
             state.mSpanLookupSize = 0;
         }
@@ -2888,13 +2883,19 @@ public class StaggeredGridLayoutManager extends RecyclerView.LayoutManager imple
     }
 
     /**
-     * An array of mappings from adapter position to span.
-     * This only grows when a write happens and it grows up to the size of the adapter.
+     * A mapping from adapter position to span.
+     * This only grows when a write happens and it grows up to the size of the adapter. Spans are
+     * stored one byte per position and only widened to ints if a span index does not fit.
+     * <p>
+     * Full span items are kept sorted by position so that they can be looked up with a binary
+     * search.
      */
     static class LazySpanLookup {
 
         private static final int MIN_SIZE = 10;
-        int[] mData;
+        byte[] mData;
+        // only used instead of mData when a span index is larger than Byte.MAX_VALUE
+        int[] mWideData;
         List<FullSpanItem> mFullSpanItems;
 
 
@@ -2903,12 +2904,8 @@ public class StaggeredGridLayoutManager extends RecyclerView.LayoutManager imple
          */
         int forceInvalidateAfter(int position) {
             if (mFullSpanItems != null) {
-                for (int i = mFullSpanItems.size() - 1; i >= 0; i--) {
-                    FullSpanItem fsi = mFullSpanItems.get(i);
-                    if (fsi.mPosition >= position) {
-                        mFullSpanItems.remove(i);
-                    }
-                }
+                final int index = findFullSpanItemIndex(position);
+                mFullSpanItems.subList(index, mFullSpanItems.size()).clear();
             }
             return invalidateAfter(position);
         }
@@ -2917,28 +2914,31 @@ public class StaggeredGridLayoutManager extends RecyclerView.LayoutManager imple
          * returns end position for invalidation.
          */
         int invalidateAfter(int position) {
-            if (mData == null) {
+            final int length = length();
+            if (length == 0) {
                 return RecyclerView.NO_POSITION;
             }
-            if (position >= mData.length) {
+            if (position >= length) {
                 return RecyclerView.NO_POSITION;
             }
             int endPosition = invalidateFullSpansAfter(position);
             if (endPosition == RecyclerView.NO_POSITION) {
-                Arrays.fill(mData, position, mData.length, LayoutParams.INVALID_SPAN_ID);
-                return mData.length;
+                fill(position, length);
+                return length;
             } else {
                 // Just invalidate items in between `position` and the next full span item, or the
                 // end of the tracked spans in mData if it's not been lengthened yet.
-                final int invalidateToIndex = Math.min(endPosition + 1, mData.length);
-                Arrays.fill(mData, position, invalidateToIndex, LayoutParams.INVALID_SPAN_ID);
+                final int invalidateToIndex = Math.min(endPosition + 1, length);
+                fill(position, invalidateToIndex);
                 return invalidateToIndex;
             }
         }
 
         int getSpan(int position) {
-            if (mData == null || position >= mData.length) {
+            if (position >= length()) {
                 return LayoutParams.INVALID_SPAN_ID;
+            } else if (mWideData != null) {
+                return mWideData[position];
             } else {
                 return mData[position];
             }
@@ -2946,11 +2946,29 @@ public class StaggeredGridLayoutManager extends RecyclerView.LayoutManager imple
 
         void setSpan(int position, Span span) {
             ensureSize(position);
-            mData[position] = span.mIndex;
+            if (mWideData == null && span.mIndex > Byte.MAX_VALUE) {
+                mWideData = new int[mData.length];
+                for (int i = 0; i < mData.length; i++) {
+                    mWideData[i] = mData[i];
+                }
+                mData = null;
+            }
+            if (mWideData != null) {
+                mWideData[position] = span.mIndex;
+            } else {
+                mData[position] = (byte) span.mIndex;
+            }
+        }
+
+        int length() {
+            if (mWideData != null) {
+                return mWideData.length;
+            }
+            return mData == null ? 0 : mData.length;
         }
 
         int sizeForPosition(int position) {
-            int len = mData.length;
+            int len = length();
             while (len <= position) {
                 len *= 2;
             }
@@ -2958,33 +2976,100 @@ public class StaggeredGridLayoutManager extends RecyclerView.LayoutManager imple
         }
 
         void ensureSize(int position) {
-            if (mData == null) {
-                mData = new int[Math.max(position, MIN_SIZE) + 1];
-                Arrays.fill(mData, LayoutParams.INVALID_SPAN_ID);
-            } else if (position >= mData.length) {
-                int[] old = mData;
-                mData = new int[sizeForPosition(position)];
-                System.arraycopy(old, 0, mData, 0, old.length);
-                Arrays.fill(mData, old.length, mData.length, LayoutParams.INVALID_SPAN_ID);
+            if (mData == null && mWideData == null) {
+                mData = new byte[Math.max(position, MIN_SIZE) + 1];
+                Arrays.fill(mData, (byte) LayoutParams.INVALID_SPAN_ID);
+            } else if (position >= length()) {
+                final int oldLength = length();
+                final int newLength = sizeForPosition(position);
+                if (mWideData != null) {
+                    mWideData = Arrays.copyOf(mWideData, newLength);
+                } else {
+                    mData = Arrays.copyOf(mData, newLength);
+                }
+                fill(oldLength, newLength);
             }
         }
 
-        void clear() {
-            if (mData != null) {
-                Arrays.fill(mData, LayoutParams.INVALID_SPAN_ID);
+        private void fill(int fromIndex, int toIndex) {
+            if (mWideData != null) {
+                Arrays.fill(mWideData, fromIndex, toIndex, LayoutParams.INVALID_SPAN_ID);
+            } else if (mData != null) {
+                Arrays.fill(mData, fromIndex, toIndex, (byte) LayoutParams.INVALID_SPAN_ID);
+            }
+        }
+
+        private void move(int srcPos, int destPos, int length) {
+            if (mWideData != null) {
+                System.arraycopy(mWideData, srcPos, mWideData, destPos, length);
+            } else {
+                System.arraycopy(mData, srcPos, mData, destPos, length);
             }
+        }
+
+        void clear() {
+            fill(0, length());
             mFullSpanItems = null;
         }
 
+        /**
+         * Writes the span assignments into the saved state, leaving out the unassigned positions
+         * at the end, which are usually most of the lookup. A lookup without any assigned
+         * position is saved as empty, full span items included, and not restored by
+         * {@link #restoreFrom(SavedState)}.
+         */
+        void saveTo(SavedState state) {
+            int size = length();
+            while (size > 0 && getSpan(size - 1) == LayoutParams.INVALID_SPAN_ID) {
+                size--;
+            }
+            if (size == 0) {
+                state.mSpanLookupSize = 0;
+                state.mSpanLookup = null;
+                state.mWideSpanLookup = null;
+                state.mFullSpanItems = null;
+                return;
+            }
+            state.mSpanLookupSize = size;
+            state.mSpanLookup = mWideData == null ? Arrays.copyOf(mData, size) : null;
+            state.mWideSpanLookup = mWideData != null ? Arrays.copyOf(mWideData, size) : null;
+            state.mFullSpanItems = copyFullSpanItems(mFullSpanItems);
+        }
+
+        /**
+         * Replaces the span assignments with the ones written by {@link #saveTo(SavedState)}, if
+         * any. The state is copied, so it can be restored again.
+         */
+        void restoreFrom(SavedState state) {
+            if (state.mSpanLookupSize == 0) {
+                return;
+            }
+            mData = state.mSpanLookup == null ? null : state.mSpanLookup.clone();
+            mWideData = state.mWideSpanLookup == null ? null : state.mWideSpanLookup.clone();
+            mFullSpanItems = copyFullSpanItems(state.mFullSpanItems);
+        }
+
+        private static List<FullSpanItem> copyFullSpanItems(List<FullSpanItem> items) {
+            if (items == null) {
+                return null;
+            }
+            final List<FullSpanItem> copy = new ArrayList<>(items.size());
+            for (int i = 0; i < items.size(); i++) {
+                copy.add(new FullSpanItem(items.get(i)));
+            }
+            return copy;
+        }
+
         void offsetForRemoval(int positionStart, int itemCount) {
-            if (mData == null || positionStart >= mData.length) {
+            final int length = length();
+            if (length == 0 || positionStart >= length) {
                 return;
             }
             ensureSize(positionStart + itemCount);
-            System.arraycopy(mData, positionStart + itemCount, mData, positionStart,
-                    mData.length - positionStart - itemCount);
-            Arrays.fill(mData, mData.length - itemCount, mData.length,
-                    LayoutParams.INVALID_SPAN_ID);
+            final int newLength = length();
+            move(positionStart + itemCount, positionStart,
+                    newLength - positionStart - itemCount);
+            fill(newLength - itemCount, newLength);
             offsetFullSpansForRemoval(positionStart, itemCount);
         }
 
@@ -2993,28 +3078,23 @@ public class StaggeredGridLayoutManager extends RecyclerView.LayoutManager imple
                 return;
             }
             final int end = positionStart + itemCount;
-            for (int i = mFullSpanItems.size() - 1; i >= 0; i--) {
-                FullSpanItem fsi = mFullSpanItems.get(i);
-                if (fsi.mPosition < positionStart) {
-                    continue;
-                }
-                if (fsi.mPosition < end) {
-                    mFullSpanItems.remove(i);
-                } else {
-                    fsi.mPosition -= itemCount;
-                }
+            final int startIndex = findFullSpanItemIndex(positionStart);
+            final int endIndex = findFullSpanItemIndex(end);
+            for (int i = mFullSpanItems.size() - 1; i >= endIndex; i--) {
+                mFullSpanItems.get(i).mPosition -= itemCount;
             }
+            mFullSpanItems.subList(startIndex, endIndex).clear();
         }
 
         void offsetForAddition(int positionStart, int itemCount) {
-            if (mData == null || positionStart >= mData.length) {
+            final int length = length();
+            if (length == 0 || positionStart >= length) {
                 return;
             }
             ensureSize(positionStart + itemCount);
-            System.arraycopy(mData, positionStart, mData, positionStart + itemCount,
-                    mData.length - positionStart - itemCount);
-            Arrays.fill(mData, positionStart, positionStart + itemCount,
-                    LayoutParams.INVALID_SPAN_ID);
+            move(positionStart, positionStart + itemCount,
+                    length() - positionStart - itemCount);
+            fill(positionStart, positionStart + itemCount);
             offsetFullSpansForAddition(positionStart, itemCount);
         }
 
@@ -3022,13 +3102,28 @@ public class StaggeredGridLayoutManager extends RecyclerView.LayoutManager imple
             if (mFullSpanItems == null) {
                 return;
             }
-            for (int i = mFullSpanItems.size() - 1; i >= 0; i--) {
-                FullSpanItem fsi = mFullSpanItems.get(i);
-                if (fsi.mPosition < positionStart) {
-                    continue;
+            final int startIndex = findFullSpanItemIndex(positionStart);
+            for (int i = mFullSpanItems.size() - 1; i >= startIndex; i--) {
+                mFullSpanItems.get(i).mPosition += itemCount;
+            }
+        }
+
+        /**
+         * Returns the index of the first full span item at or after the given position, or the
+         * number of full span items if there is none.
+         */
+        private int findFullSpanItemIndex(int position) {
+            int low = 0;
+            int high = mFullSpanItems.size() - 1;
+            while (low <= high) {
+                final int mid = (low + high) >>> 1;
+                if (mFullSpanItems.get(mid).mPosition < position) {
+                    low = mid + 1;
+                } else {
+                    high = mid - 1;
                 }
-                fsi.mPosition += itemCount;
             }
+            return low;
         }
 
         /**
@@ -3039,23 +3134,14 @@ public class StaggeredGridLayoutManager extends RecyclerView.LayoutManager imple
             if (mFullSpanItems == null) {
                 return RecyclerView.NO_POSITION;
             }
-            final FullSpanItem item = getFullSpanItem(position);
+            final int index = findFullSpanItemIndex(position);
             // if there is an fsi at this position, get rid of it.
-            if (item != null) {
-                mFullSpanItems.remove(item);
-            }
-            int nextFsiIndex = -1;
-            final int count = mFullSpanItems.size();
-            for (int i = 0; i < count; i++) {
-                FullSpanItem fsi = mFullSpanItems.get(i);
-                if (fsi.mPosition >= position) {
-                    nextFsiIndex = i;
-                    break;
-                }
+            if (index < mFullSpanItems.size()
+                    && mFullSpanItems.get(index).mPosition == position) {
+                mFullSpanItems.remove(index);
             }
-            if (nextFsiIndex != -1) {
-                FullSpanItem fsi = mFullSpanItems.get(nextFsiIndex);
-                mFullSpanItems.remove(nextFsiIndex);
+            if (index < mFullSpanItems.size()) {
+                FullSpanItem fsi = mFullSpanItems.remove(index);
                 return fsi.mPosition;
             }
             return RecyclerView.NO_POSITION;
@@ -3065,31 +3151,26 @@ public class StaggeredGridLayoutManager extends RecyclerView.LayoutManager imple
             if (mFullSpanItems == null) {
                 mFullSpanItems = new ArrayList<>();
             }
-            final int size = mFullSpanItems.size();
-            for (int i = 0; i < size; i++) {
-                FullSpanItem other = mFullSpanItems.get(i);
-                if (other.mPosition == fullSpanItem.mPosition) {
-                    if (DEBUG) {
-                        throw new IllegalStateException("two fsis for same position");
-                    } else {
-                        mFullSpanItems.remove(i);
-                    }
-                }
-                if (other.mPosition >= fullSpanItem.mPosition) {
-                    mFullSpanItems.add(i, fullSpanItem);
+            final int index = findFullSpanItemIndex(fullSpanItem.mPosition);
+            if (index < mFullSpanItems.size()
+                    && mFullSpanItems.get(index).mPosition == fullSpanItem.mPosition) {
+                if (DEBUG) {
+                    throw new IllegalStateException("two fsis for same position");
+                } else {
+                    mFullSpanItems.set(index, fullSpanItem);
                     return;
                 }
             }
-            // if it is not added to a position.
-            mFullSpanItems.add(fullSpanItem);
+            mFullSpanItems.add(index, fullSpanItem);
         }
 
         public FullSpanItem getFullSpanItem(int position) {
             if (mFullSpanItems == null) {
                 return null;
             }
-            for (int i = mFullSpanItems.size() - 1; i >= 0; i--) {
-                final FullSpanItem fsi = mFullSpanItems.get(i);
+            final int index = findFullSpanItemIndex(position);
+            if (index < mFullSpanItems.size()) {
+                final FullSpanItem fsi = mFullSpanItems.get(index);
                 if (fsi.mPosition == position) {
                     return fsi;
                 }
@@ -3115,14 +3196,13 @@ public class StaggeredGridLayoutManager extends RecyclerView.LayoutManager imple
             }
             //sel
             final int limit = mFullSpanItems.size();
-            for (int i = 0; i < limit; i++) {
+            for (int i = findFullSpanItemIndex(minPos); i < limit; i++) {
                 FullSpanItem fsi = mFullSpanItems.get(i);
                 if (fsi.mPosition >= maxPos) {
                     return null;
                 }
-                if (fsi.mPosition >= minPos
-                        && (gapDir == 0 || fsi.mGapDir == gapDir
-                        || (hasUnwantedGapAfter && fsi.mHasUnwantedGapAfter))) {
+                if (gapDir == 0 || fsi.mGapDir == gapDir
+                        || (hasUnwantedGapAfter && fsi.mHasUnwantedGapAfter)) {
                     return fsi;
                 }
             }
@@ -3157,6 +3237,13 @@ public class StaggeredGridLayoutManager extends RecyclerView.LayoutManager imple
             FullSpanItem() {
             }
 
+            FullSpanItem(FullSpanItem other) {
+                mPosition = other.mPosition;
+                mGapDir = other.mGapDir;
+                mHasUnwantedGapAfter = other.mHasUnwantedGapAfter;
+                mGapPerSpan = other.mGapPerSpan == null ? null : other.mGapPerSpan.clone();
+            }
+
             int getGapForSpan(int spanIndex) {
                 return mGapPerSpan == null ? 0 : mGapPerSpan[spanIndex];
             }
@@ -3215,7 +3302,9 @@ public class StaggeredGridLayoutManager extends RecyclerView.LayoutManager imple
         int mSpanOffsetsSize;
         int[] mSpanOffsets;
         int mSpanLookupSize;
-        int[] mSpanLookup;
+        byte[] mSpanLookup;
+        // set instead of mSpanLookup if the span indices do not fit in a byte
+        int[] mWideSpanLookup;
         List<LazySpanLookup.FullSpanItem> mFullSpanItems;
         boolean mReverseLayout;
         boolean mAnchorLayoutFromEnd;
@@ -3235,8 +3324,13 @@ public class StaggeredGridLayoutManager extends RecyclerView.LayoutManager imple
 
             mSpanLookupSize = in.readInt();
             if (mSpanLookupSize > 0) {
-                mSpanLookup = new int[mSpanLookupSize];
-                in.readIntArray(mSpanLookup);
+                if (in.readInt() == 1) {
+                    mWideSpanLookup = new int[mSpanLookupSize];
+                    in.readIntArray(mWideSpanLookup);
+                } else {
+                    mSpanLookup = new byte[mSpanLookupSize];
+                    in.readByteArray(mSpanLookup);
+                }
             }
             mReverseLayout = in.readInt() == 1;
             mAnchorLayoutFromEnd = in.readInt() == 1;
@@ -3254,6 +3348,7 @@ public class StaggeredGridLayoutManager extends RecyclerView.LayoutManager imple
             mSpanOffsets = other.mSpanOffsets;
             mSpanLookupSize = other.mSpanLookupSize;
             mSpanLookup = other.mSpanLookup;
+            mWideSpanLookup = other.mWideSpanLookup;
             mReverseLayout = other.mReverseLayout;
             mAnchorLayoutFromEnd = other.mAnchorLayoutFromEnd;
             mLastLayoutRTL = other.mLastLayoutRTL;
@@ -3265,6 +3360,7 @@ public class StaggeredGridLayoutManager extends RecyclerView.LayoutManager imple
             mSpanOffsetsSize = 0;
             mSpanLookupSize = 0;
             mSpanLookup = null;
+            mWideSpanLookup = null;
             mFullSpanItems = null;
         }
 
@@ -3290,7 +3386,13 @@ public class StaggeredGridLayoutManager extends RecyclerView.LayoutManager imple
             }
             dest.writeInt(mSpanLookupSize);
             if (mSpanLookupSize > 0) {
-                dest.writeIntArray(mSpanLookup);
+                if (mWideSpanLookup != null) {
+                    dest.writeInt(1);
+                    dest.writeIntArray(mWideSpanLookup);
+                } else {
+                    dest.writeInt(0);
+                    dest.writeByteArray(mSpanLookup);
+                }
             }
             dest.writeInt(mReverseLayout ? 1 : 0);
             dest.writeInt(mAnchorLayoutFromEnd ? 1 : 0);
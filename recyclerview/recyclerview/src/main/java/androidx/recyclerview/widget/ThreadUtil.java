@@ -41,6 +41,9 @@ interface ThreadUtil<T> {
 
         @SuppressLint("UnknownNullness") // b/240775049: Cannot annotate properly
         void recycleTile(TileList.Tile<T> tile);
+
+        @SuppressLint("UnknownNullness") // b/240775049: Cannot annotate properly
+        void addLoadedTile(int generation, TileList.Tile<T> tile);
     }
 
     MainThreadCallback<T> getMainThreadProxy(MainThreadCallback<T> callback);
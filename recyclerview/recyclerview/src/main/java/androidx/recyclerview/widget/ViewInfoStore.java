@@ -27,22 +27,46 @@ import androidx.annotation.NonNull;
 import androidx.annotation.Nullable;
 import androidx.annotation.VisibleForTesting;
 import androidx.collection.LongSparseArray;
-import androidx.collection.SimpleArrayMap;
-import androidx.core.util.Pools;
+
+import java.util.Arrays;
 
 /**
  * This class abstracts all tracking for Views to run animations.
+ * <p>
+ * Records are kept as parallel arrays rather than one object per ViewHolder. Each tracked
+ * ViewHolder remembers its slot in {@link RecyclerView.ViewHolder#mInfoStoreIndex}, so lookups
+ * do not hash and, once the arrays have grown to the number of children animated in a layout
+ * pass, tracking does not allocate.
  */
 class ViewInfoStore {
 
     private static final boolean DEBUG = false;
 
+    private static final int INITIAL_CAPACITY = 16;
+
+    /**
+     * Slots released on detach above this capacity, to not hold on to large arrays.
+     */
+    private static final int RETAINED_CAPACITY = 64;
+
     /**
-     * View data records for pre-layout
+     * View data records for pre and post layout, indexed by slot.
      */
     @VisibleForTesting
-    final SimpleArrayMap<RecyclerView.ViewHolder, InfoRecord> mLayoutHolderMap =
-            new SimpleArrayMap<>();
+    RecyclerView.ViewHolder[] mHolders = new RecyclerView.ViewHolder[INITIAL_CAPACITY];
+    private int[] mFlags = new int[INITIAL_CAPACITY];
+    private RecyclerView.ItemAnimator.ItemHolderInfo[] mPreInfos =
+            new RecyclerView.ItemAnimator.ItemHolderInfo[INITIAL_CAPACITY];
+    private RecyclerView.ItemAnimator.ItemHolderInfo[] mPostInfos =
+            new RecyclerView.ItemAnimator.ItemHolderInfo[INITIAL_CAPACITY];
+    @VisibleForTesting
+    int mSize;
+
+    /**
+     * Number of times the record arrays had to grow, see
+     * {@link RecyclerView#seslGetLayoutPassAllocationCount()}.
+     */
+    int mAllocationCount;
 
     @VisibleForTesting
     final LongSparseArray<RecyclerView.ViewHolder> mOldChangedHolders = new LongSparseArray<>();
@@ -51,28 +75,84 @@ class ViewInfoStore {
      * Clears the state and all existing tracking data
      */
     void clear() {
-        mLayoutHolderMap.clear();
+        for (int i = 0; i < mSize; i++) {
+            mHolders[i].mInfoStoreIndex = RecyclerView.NO_POSITION;
+        }
+        Arrays.fill(mHolders, 0, mSize, null);
+        Arrays.fill(mPreInfos, 0, mSize, null);
+        Arrays.fill(mPostInfos, 0, mSize, null);
+        mSize = 0;
         mOldChangedHolders.clear();
     }
 
+    /**
+     * Returns the slot of the given ViewHolder, or -1 if it is not tracked.
+     */
+    private int indexOf(RecyclerView.ViewHolder holder) {
+        final int index = holder.mInfoStoreIndex;
+        // the holder may carry a stale slot, e.g. from the store of another RecyclerView
+        if (index >= 0 && index < mSize && mHolders[index] == holder) {
+            return index;
+        }
+        return -1;
+    }
+
+    /**
+     * Returns the slot of the given ViewHolder, adding an empty record for it if needed.
+     */
+    private int obtainIndex(RecyclerView.ViewHolder holder) {
+        int index = indexOf(holder);
+        if (index >= 0) {
+            return index;
+        }
+        if (mSize == mHolders.length) {
+            final int capacity = mSize * 2;
+            mHolders = Arrays.copyOf(mHolders, capacity);
+            mFlags = Arrays.copyOf(mFlags, capacity);
+            mPreInfos = Arrays.copyOf(mPreInfos, capacity);
+            mPostInfos = Arrays.copyOf(mPostInfos, capacity);
+            mAllocationCount++;
+        }
+        index = mSize++;
+        mHolders[index] = holder;
+        mFlags[index] = 0;
+        holder.mInfoStoreIndex = index;
+        return index;
+    }
+
+    /**
+     * Removes the record at the given slot, moving the last record into it.
+     */
+    private void removeAt(int index) {
+        mHolders[index].mInfoStoreIndex = RecyclerView.NO_POSITION;
+        final int last = --mSize;
+        if (index != last) {
+            mHolders[index] = mHolders[last];
+            mFlags[index] = mFlags[last];
+            mPreInfos[index] = mPreInfos[last];
+            mPostInfos[index] = mPostInfos[last];
+            mHolders[index].mInfoStoreIndex = index;
+        }
+        mHolders[last] = null;
+        mFlags[last] = 0;
+        mPreInfos[last] = null;
+        mPostInfos[last] = null;
+    }
+
     /**
      * Adds the item information to the prelayout tracking
      * @param holder The ViewHolder whose information is being saved
      * @param info The information to save
      */
     void addToPreLayout(RecyclerView.ViewHolder holder, RecyclerView.ItemAnimator.ItemHolderInfo info) {
-        InfoRecord record = mLayoutHolderMap.get(holder);
-        if (record == null) {
-            record = InfoRecord.obtain();
-            mLayoutHolderMap.put(holder, record);
-        }
-        record.preInfo = info;
-        record.flags |= FLAG_PRE;
+        final int index = obtainIndex(holder);
+        mPreInfos[index] = info;
+        mFlags[index] |= FLAG_PRE;
     }
 
     boolean isDisappearing(RecyclerView.ViewHolder holder) {
-        final InfoRecord record = mLayoutHolderMap.get(holder);
-        return record != null && ((record.flags & FLAG_DISAPPEARED) != 0);
+        final int index = indexOf(holder);
+        return index >= 0 && ((mFlags[index] & FLAG_DISAPPEARED) != 0);
     }
 
     /**
@@ -98,25 +178,23 @@ class ViewInfoStore {
     }
 
     private RecyclerView.ItemAnimator.ItemHolderInfo popFromLayoutStep(RecyclerView.ViewHolder vh, int flag) {
-        int index = mLayoutHolderMap.indexOfKey(vh);
+        final int index = indexOf(vh);
         if (index < 0) {
             return null;
         }
-        final InfoRecord record = mLayoutHolderMap.valueAt(index);
-        if (record != null && (record.flags & flag) != 0) {
-            record.flags &= ~flag;
+        if ((mFlags[index] & flag) != 0) {
+            mFlags[index] &= ~flag;
             final RecyclerView.ItemAnimator.ItemHolderInfo info;
             if (flag == FLAG_PRE) {
-                info = record.preInfo;
+                info = mPreInfos[index];
             } else if (flag == FLAG_POST) {
-                info = record.postInfo;
+                info = mPostInfos[index];
             } else {
                 throw new IllegalArgumentException("Must provide flag PRE or POST");
             }
             // if not pre-post flag is left, clear.
-            if ((record.flags & (FLAG_PRE | FLAG_POST)) == 0) {
-                mLayoutHolderMap.removeAt(index);
-                InfoRecord.recycle(record);
+            if ((mFlags[index] & (FLAG_PRE | FLAG_POST)) == 0) {
+                removeAt(index);
             }
             return info;
         }
@@ -142,13 +220,9 @@ class ViewInfoStore {
      * @param info The information to save
      */
     void addToAppearedInPreLayoutHolders(RecyclerView.ViewHolder holder, RecyclerView.ItemAnimator.ItemHolderInfo info) {
-        InfoRecord record = mLayoutHolderMap.get(holder);
-        if (record == null) {
-            record = InfoRecord.obtain();
-            mLayoutHolderMap.put(holder, record);
-        }
-        record.flags |= FLAG_APPEAR;
-        record.preInfo = info;
+        final int index = obtainIndex(holder);
+        mFlags[index] |= FLAG_APPEAR;
+        mPreInfos[index] = info;
     }
 
     /**
@@ -158,8 +232,8 @@ class ViewInfoStore {
      * @return True if the ViewHolder is present in preLayout, false otherwise
      */
     boolean isInPreLayout(RecyclerView.ViewHolder viewHolder) {
-        final InfoRecord record = mLayoutHolderMap.get(viewHolder);
-        return record != null && (record.flags & FLAG_PRE) != 0;
+        final int index = indexOf(viewHolder);
+        return index >= 0 && (mFlags[index] & FLAG_PRE) != 0;
     }
 
     /**
@@ -179,13 +253,9 @@ class ViewInfoStore {
      * @param info The information to save
      */
     void addToPostLayout(RecyclerView.ViewHolder holder, RecyclerView.ItemAnimator.ItemHolderInfo info) {
-        InfoRecord record = mLayoutHolderMap.get(holder);
-        if (record == null) {
-            record = InfoRecord.obtain();
-            mLayoutHolderMap.put(holder, record);
-        }
-        record.postInfo = info;
-        record.flags |= FLAG_POST;
+        final int index = obtainIndex(holder);
+        mPostInfos[index] = info;
+        mFlags[index] |= FLAG_POST;
     }
 
     /**
@@ -195,12 +265,8 @@ class ViewInfoStore {
      * @param holder The ViewHolder which disappeared during a layout.
      */
     void addToDisappearedInLayout(RecyclerView.ViewHolder holder) {
-        InfoRecord record = mLayoutHolderMap.get(holder);
-        if (record == null) {
-            record = InfoRecord.obtain();
-            mLayoutHolderMap.put(holder, record);
-        }
-        record.flags |= FLAG_DISAPPEARED;
+        final int index = obtainIndex(holder);
+        mFlags[index] |= FLAG_DISAPPEARED;
     }
 
     /**
@@ -208,47 +274,50 @@ class ViewInfoStore {
      * @param holder The ViewHolder to be removed from the disappearing list.
      */
     void removeFromDisappearedInLayout(RecyclerView.ViewHolder holder) {
-        InfoRecord record = mLayoutHolderMap.get(holder);
-        if (record == null) {
+        final int index = indexOf(holder);
+        if (index < 0) {
             return;
         }
-        record.flags &= ~FLAG_DISAPPEARED;
+        mFlags[index] &= ~FLAG_DISAPPEARED;
     }
 
     void process(ProcessCallback callback) {
-        for (int index = mLayoutHolderMap.size() - 1; index >= 0; index--) {
-            final RecyclerView.ViewHolder viewHolder = mLayoutHolderMap.keyAt(index);
-            final InfoRecord record = mLayoutHolderMap.removeAt(index);
-            if ((record.flags & FLAG_APPEAR_AND_DISAPPEAR) == FLAG_APPEAR_AND_DISAPPEAR) {
+        for (int index = mSize - 1; index >= 0; index = Math.min(index - 1, mSize - 1)) {
+            // the callbacks may stop tracking other holders, so re-check the size every step
+            final RecyclerView.ViewHolder viewHolder = mHolders[index];
+            final int flags = mFlags[index];
+            final RecyclerView.ItemAnimator.ItemHolderInfo preInfo = mPreInfos[index];
+            final RecyclerView.ItemAnimator.ItemHolderInfo postInfo = mPostInfos[index];
+            removeAt(index);
+            if ((flags & FLAG_APPEAR_AND_DISAPPEAR) == FLAG_APPEAR_AND_DISAPPEAR) {
                 // Appeared then disappeared. Not useful for animations.
                 callback.unused(viewHolder);
-            } else if ((record.flags & FLAG_DISAPPEARED) != 0) {
+            } else if ((flags & FLAG_DISAPPEARED) != 0) {
                 // Set as "disappeared" by the LayoutManager (addDisappearingView)
-                if (record.preInfo == null) {
+                if (preInfo == null) {
                     // similar to appear disappear but happened between different layout passes.
                     // this can happen when the layout manager is using auto-measure
                     callback.unused(viewHolder);
                 } else {
-                    callback.processDisappeared(viewHolder, record.preInfo, record.postInfo);
+                    callback.processDisappeared(viewHolder, preInfo, postInfo);
                 }
-            } else if ((record.flags & FLAG_APPEAR_PRE_AND_POST) == FLAG_APPEAR_PRE_AND_POST) {
+            } else if ((flags & FLAG_APPEAR_PRE_AND_POST) == FLAG_APPEAR_PRE_AND_POST) {
                 // Appeared in the layout but not in the adapter (e.g. entered the viewport)
-                callback.processAppeared(viewHolder, record.preInfo, record.postInfo);
-            } else if ((record.flags & FLAG_PRE_AND_POST) == FLAG_PRE_AND_POST) {
+                callback.processAppeared(viewHolder, preInfo, postInfo);
+            } else if ((flags & FLAG_PRE_AND_POST) == FLAG_PRE_AND_POST) {
                 // Persistent in both passes. Animate persistence
-                callback.processPersistent(viewHolder, record.preInfo, record.postInfo);
-            } else if ((record.flags & FLAG_PRE) != 0) {
+                callback.processPersistent(viewHolder, preInfo, postInfo);
+            } else if ((flags & FLAG_PRE) != 0) {
                 // Was in pre-layout, never been added to post layout
-                callback.processDisappeared(viewHolder, record.preInfo, null);
-            } else if ((record.flags & FLAG_POST) != 0) {
+                callback.processDisappeared(viewHolder, preInfo, null);
+            } else if ((flags & FLAG_POST) != 0) {
                 // Was not in pre-layout, been added to post layout
-                callback.processAppeared(viewHolder, record.preInfo, record.postInfo);
-            } else if ((record.flags & FLAG_APPEAR) != 0) {
+                callback.processAppeared(viewHolder, preInfo, postInfo);
+            } else if ((flags & FLAG_APPEAR) != 0) {
                 // Scrap view. RecyclerView will handle removing/recycling this.
             } else if (DEBUG) {
                 throw new IllegalStateException("record without any reasonable flag combination:/");
             }
-            InfoRecord.recycle(record);
         }
     }
 
@@ -263,14 +332,19 @@ class ViewInfoStore {
                 break;
             }
         }
-        final InfoRecord info = mLayoutHolderMap.remove(holder);
-        if (info != null) {
-            InfoRecord.recycle(info);
+        final int index = indexOf(holder);
+        if (index >= 0) {
+            removeAt(index);
         }
     }
 
     void onDetach() {
-        InfoRecord.drainCache();
+        if (mSize == 0 && mHolders.length > RETAINED_CAPACITY) {
+            mHolders = new RecyclerView.ViewHolder[INITIAL_CAPACITY];
+            mFlags = new int[INITIAL_CAPACITY];
+            mPreInfos = new RecyclerView.ItemAnimator.ItemHolderInfo[INITIAL_CAPACITY];
+            mPostInfos = new RecyclerView.ItemAnimator.ItemHolderInfo[INITIAL_CAPACITY];
+        }
     }
 
     public void onViewDetached(RecyclerView.ViewHolder viewHolder) {
@@ -299,31 +373,8 @@ class ViewInfoStore {
         static final int FLAG_APPEAR_AND_DISAPPEAR = FLAG_APPEAR | FLAG_DISAPPEARED;
         static final int FLAG_PRE_AND_POST = FLAG_PRE | FLAG_POST;
         static final int FLAG_APPEAR_PRE_AND_POST = FLAG_APPEAR | FLAG_PRE | FLAG_POST;
-        int flags;
-        @Nullable
-        RecyclerView.ItemAnimator.ItemHolderInfo preInfo;
-        @Nullable
-        RecyclerView.ItemAnimator.ItemHolderInfo postInfo;
-        static Pools.Pool<InfoRecord> sPool = new Pools.SimplePool<>(20);
 
         private InfoRecord() {
         }
-
-        static InfoRecord obtain() {
-            InfoRecord record = sPool.acquire();
-            return record == null ? new InfoRecord() : record;
-        }
-
-        static void recycle(InfoRecord record) {
-            record.flags = 0;
-            record.preInfo = null;
-            record.postInfo = null;
-            sPool.release(record);
-        }
-
-        static void drainCache() {
-            //noinspection StatementWithEmptyBody
-            while (sPool.acquire() != null);
-        }
     }
 }
@@ -85,6 +85,10 @@ interface ViewTypeStorage {
 
         class WrapperViewTypeLookup implements ViewTypeLookup {
             final NestedAdapterWrapper mWrapper;
+            // most adapters repeat the same view type for long runs of items, so remember the
+            // last registered type to skip the map lookup for it
+            private int mLastRegisteredType;
+            private boolean mHasLastRegisteredType;
 
             WrapperViewTypeLookup(NestedAdapterWrapper wrapper) {
                 mWrapper = wrapper;
@@ -92,6 +96,9 @@ interface ViewTypeStorage {
 
             @Override
             public int localToGlobal(int localType) {
+                if (mHasLastRegisteredType && mLastRegisteredType == localType) {
+                    return localType;
+                }
                 // register it first
                 List<NestedAdapterWrapper> wrappers = mGlobalTypeToWrapper.get(
                         localType);
@@ -102,6 +109,8 @@ interface ViewTypeStorage {
                 if (!wrappers.contains(mWrapper)) {
                     wrappers.add(mWrapper);
                 }
+                mLastRegisteredType = localType;
+                mHasLastRegisteredType = true;
                 return localType;
             }
 
@@ -112,6 +121,7 @@ interface ViewTypeStorage {
 
             @Override
             public void dispose() {
+                mHasLastRegisteredType = false;
                 removeWrapper(mWrapper);
             }
         }
@@ -160,6 +170,9 @@ interface ViewTypeStorage {
             private SparseIntArray mLocalToGlobalMapping = new SparseIntArray(1);
             private SparseIntArray mGlobalToLocalMapping = new SparseIntArray(1);
             final NestedAdapterWrapper mWrapper;
+            // last mapping returned by localToGlobal, see SharedIdRangeViewTypeStorage
+            private int mLastLocalType;
+            private int mLastGlobalType = RecyclerView.INVALID_TYPE;
 
             WrapperViewTypeLookup(NestedAdapterWrapper wrapper) {
                 mWrapper = wrapper;
@@ -167,14 +180,21 @@ interface ViewTypeStorage {
 
             @Override
             public int localToGlobal(int localType) {
+                if (mLastGlobalType != RecyclerView.INVALID_TYPE && mLastLocalType == localType) {
+                    return mLastGlobalType;
+                }
                 int index = mLocalToGlobalMapping.indexOfKey(localType);
+                int globalType;
                 if (index > -1) {
-                    return mLocalToGlobalMapping.valueAt(index);
+                    globalType = mLocalToGlobalMapping.valueAt(index);
+                } else {
+                    // get a new key.
+                    globalType = obtainViewType(mWrapper);
+                    mLocalToGlobalMapping.put(localType, globalType);
+                    mGlobalToLocalMapping.put(globalType, localType);
                 }
-                // get a new key.
-                int globalType = obtainViewType(mWrapper);
-                mLocalToGlobalMapping.put(localType, globalType);
-                mGlobalToLocalMapping.put(globalType, localType);
+                mLastLocalType = localType;
+                mLastGlobalType = globalType;
                 return globalType;
             }
 
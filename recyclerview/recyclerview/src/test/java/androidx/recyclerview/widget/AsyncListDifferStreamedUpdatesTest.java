@@ -0,0 +1,303 @@
+/*
+ * Copyright 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package androidx.recyclerview.widget;
+
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertTrue;
+
+import org.junit.Test;
+import org.junit.runner.RunWith;
+import org.junit.runners.JUnit4;
+
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.Collections;
+import java.util.List;
+import java.util.Random;
+
+@RunWith(JUnit4.class)
+public class AsyncListDifferStreamedUpdatesTest {
+
+    @Test
+    public void changesOfOneRangeAroundTheWindowAreGrouped() {
+        // one range of kept items whose changes straddle both ends of the window, with an
+        // insertion before it and a removal after it. DiffUtil dispatches the changes of the
+        // range in ascending order, between the removal and the insertion.
+        final List<Item> oldList = items(0, 12);
+        final List<Item> newList = new ArrayList<>();
+        newList.add(new Item(100, 0));
+        for (int id = 0; id < 10; id++) {
+            newList.add(new Item(id, id >= 2 && id % 2 == 0 ? 1 : 0));
+        }
+
+        final AsyncListDiffer.StreamedUpdates updates = record(oldList, newList, 4, 6);
+        assertEquals(2, updates.mWindowOpCount);
+        assertWindowFirst(updates, 4, 6);
+        assertEquals(newList, dispatch(oldList, newList, updates));
+    }
+
+    @Test
+    public void windowInsertionRecordedAfterEarlierChangeOffsetsIt() {
+        // the change at 2 is recorded first, then the insertion at 0, which reaches into the
+        // window and is dispatched first
+        final List<Item> oldList = items(0, 10);
+        final List<Item> newList = items(100, 10);
+        for (Item item : oldList) {
+            newList.add(item.mId == 2 ? new Item(2, 1) : item);
+        }
+
+        final DiffUtil.DiffResult result = diff(oldList, newList);
+        final AsyncListDiffer.StreamedUpdates updates =
+                AsyncListDiffer.StreamedUpdates.record(result, oldList.size(), newList.size(),
+                        5, 6);
+        assertEquals(1, updates.mWindowOpCount);
+        assertEquals(newList, dispatch(oldList, newList, updates));
+        assertEquals(replayDispatchUpdatesTo(oldList, result), replayStreamed(oldList, updates));
+    }
+
+    @Test
+    public void windowIsDispatchedFirstAndReachesTheNewList() {
+        final Random random = new Random(19);
+        for (int run = 0; run < 500; run++) {
+            final List<Item> oldList = randomList(random, 0);
+            final List<Item> newList = mutate(random, oldList);
+            final int first = random.nextInt(oldList.size() + 1) - 1;
+            final int last = first < 0 ? -1 : first + random.nextInt(10);
+
+            final DiffUtil.DiffResult result = diff(oldList, newList);
+            final AsyncListDiffer.StreamedUpdates updates =
+                    AsyncListDiffer.StreamedUpdates.record(result, oldList.size(),
+                            newList.size(), first, last);
+            assertWindowFirst(updates, first, last);
+            assertEquals("run " + run, newList, dispatch(oldList, newList, updates));
+            assertEquals("run " + run, replayDispatchUpdatesTo(oldList, result),
+                    replayStreamed(oldList, updates));
+        }
+    }
+
+    private static void assertWindowFirst(AsyncListDiffer.StreamedUpdates updates, int first,
+            int last) {
+        int windowOps = 0;
+        for (int op = 0; op < updates.size(); op++) {
+            if (overlaps(updates, op, first, last)) {
+                windowOps++;
+            }
+        }
+        assertEquals(windowOps, updates.mWindowOpCount);
+        for (int i = 0; i < updates.mWindowOpCount; i++) {
+            assertTrue("op at " + updates.mPositions[updates.mOrder[i]]
+                            + " dispatched with the window",
+                    overlaps(updates, updates.mOrder[i], first, last));
+        }
+    }
+
+    private static boolean overlaps(AsyncListDiffer.StreamedUpdates updates, int op, int first,
+            int last) {
+        return updates.mPositions[op] <= last
+                && updates.mPositions[op] + updates.mCounts[op] > first;
+    }
+
+    /** Applies the updates in their streamed order, like AsyncListDiffer does per frame. */
+    private static List<Item> dispatch(List<Item> oldList, List<Item> newList,
+            AsyncListDiffer.StreamedUpdates updates) {
+        final List<Item> list = new ArrayList<>(oldList);
+        for (int i = 0; i < updates.size(); i++) {
+            final int op = updates.mOrder[i];
+            final int position = updates.dispatchPosition(op);
+            final int count = updates.mCounts[op];
+            final int newIndex = updates.mNewIndices[op];
+            switch (updates.mTypes[op]) {
+                case AsyncListDiffer.StreamedUpdates.TYPE_INSERT:
+                    list.addAll(position, newList.subList(newIndex, newIndex + count));
+                    break;
+                case AsyncListDiffer.StreamedUpdates.TYPE_REMOVE:
+                    list.subList(position, position + count).clear();
+                    break;
+                default:
+                    for (int j = 0; j < count; j++) {
+                        list.set(position + j, newList.get(newIndex + j));
+                    }
+                    break;
+            }
+        }
+        return list;
+    }
+
+    /**
+     * Applies the updates of {@link DiffUtil.DiffResult#dispatchUpdatesTo(ListUpdateCallback)}
+     * to the old items, marking inserted and changed slots.
+     */
+    private static List<String> replayDispatchUpdatesTo(List<Item> oldList,
+            DiffUtil.DiffResult result) {
+        final List<String> slots = slots(oldList);
+        result.dispatchUpdatesTo(new ListUpdateCallback() {
+            @Override
+            public void onInserted(int position, int count) {
+                slots.addAll(position, Collections.nCopies(count, "new"));
+            }
+
+            @Override
+            public void onRemoved(int position, int count) {
+                slots.subList(position, position + count).clear();
+            }
+
+            @Override
+            public void onMoved(int fromPosition, int toPosition) {
+                throw new AssertionError("moves are not streamed");
+            }
+
+            @Override
+            public void onChanged(int position, int count, Object payload) {
+                for (int i = position; i < position + count; i++) {
+                    slots.set(i, slots.get(i) + "*");
+                }
+            }
+        });
+        return slots;
+    }
+
+    /** The same as {@link #replayDispatchUpdatesTo}, in the streamed order. */
+    private static List<String> replayStreamed(List<Item> oldList,
+            AsyncListDiffer.StreamedUpdates updates) {
+        final List<String> slots = slots(oldList);
+        for (int i = 0; i < updates.size(); i++) {
+            final int op = updates.mOrder[i];
+            final int position = updates.dispatchPosition(op);
+            final int count = updates.mCounts[op];
+            switch (updates.mTypes[op]) {
+                case AsyncListDiffer.StreamedUpdates.TYPE_INSERT:
+                    slots.addAll(position, Collections.nCopies(count, "new"));
+                    break;
+                case AsyncListDiffer.StreamedUpdates.TYPE_REMOVE:
+                    slots.subList(position, position + count).clear();
+                    break;
+                default:
+                    for (int j = position; j < position + count; j++) {
+                        slots.set(j, slots.get(j) + "*");
+                    }
+                    break;
+            }
+        }
+        return slots;
+    }
+
+    private static List<String> slots(List<Item> items) {
+        final List<String> slots = new ArrayList<>();
+        for (Item item : items) {
+            slots.add(item.toString());
+        }
+        return slots;
+    }
+
+    private static AsyncListDiffer.StreamedUpdates record(List<Item> oldList,
+            List<Item> newList, int first, int last) {
+        return AsyncListDiffer.StreamedUpdates.record(diff(oldList, newList), oldList.size(),
+                newList.size(), first, last);
+    }
+
+    private static DiffUtil.DiffResult diff(final List<Item> oldList, final List<Item> newList) {
+        return DiffUtil.calculateDiff(new DiffUtil.Callback() {
+            @Override
+            public int getOldListSize() {
+                return oldList.size();
+            }
+
+            @Override
+            public int getNewListSize() {
+                return newList.size();
+            }
+
+            @Override
+            public boolean areItemsTheSame(int oldItemPosition, int newItemPosition) {
+                return oldList.get(oldItemPosition).mId == newList.get(newItemPosition).mId;
+            }
+
+            @Override
+            public boolean areContentsTheSame(int oldItemPosition, int newItemPosition) {
+                return oldList.get(oldItemPosition).equals(newList.get(newItemPosition));
+            }
+        }, false);
+    }
+
+    private static List<Item> items(int firstId, int count) {
+        final List<Item> list = new ArrayList<>();
+        for (int i = 0; i < count; i++) {
+            list.add(new Item(firstId + i, 0));
+        }
+        return list;
+    }
+
+    private static List<Item> randomList(Random random, int firstId) {
+        return items(firstId, 10 + random.nextInt(60));
+    }
+
+    private static List<Item> mutate(Random random, List<Item> oldList) {
+        final List<Item> list = new ArrayList<>();
+        int nextId = 1000;
+        if (random.nextInt(4) == 0) {
+            // a burst at the start, which shifts everything recorded before it
+            for (int i = random.nextInt(12); i > 0; i--) {
+                list.add(new Item(nextId++, 0));
+            }
+        }
+        for (Item item : oldList) {
+            final int action = random.nextInt(10);
+            if (action == 0) {
+                continue; // removed
+            }
+            if (action == 1) {
+                for (int i = 1 + random.nextInt(5); i > 0; i--) {
+                    list.add(new Item(nextId++, 0)); // inserted
+                }
+            }
+            list.add(action < 5 ? new Item(item.mId, item.mVersion + 1) : item);
+        }
+        if (random.nextBoolean()) {
+            list.add(new Item(nextId, 0));
+        }
+        return list;
+    }
+
+    static final class Item {
+        final int mId;
+        final int mVersion;
+
+        Item(int id, int version) {
+            mId = id;
+            mVersion = version;
+        }
+
+        @Override
+        public boolean equals(Object o) {
+            if (!(o instanceof Item)) {
+                return false;
+            }
+            final Item other = (Item) o;
+            return mId == other.mId && mVersion == other.mVersion;
+        }
+
+        @Override
+        public int hashCode() {
+            return Arrays.hashCode(new int[]{mId, mVersion});
+        }
+
+        @Override
+        public String toString() {
+            return mId + "v" + mVersion;
+        }
+    }
+}
@@ -0,0 +1,288 @@
+/*
+ * Copyright 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package androidx.recyclerview.widget;
+
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertTrue;
+
+import org.junit.After;
+import org.junit.Test;
+import org.junit.runner.RunWith;
+import org.junit.runners.JUnit4;
+
+import java.util.ArrayList;
+import java.util.List;
+import java.util.Random;
+import java.util.concurrent.Executor;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+
+/**
+ * Compares {@link DiffUtil#calculateDiff(DiffUtil.Callback, boolean, Executor)} with
+ * {@link DiffUtil#calculateDiff(DiffUtil.Callback, boolean)}.
+ */
+@RunWith(JUnit4.class)
+public class DiffUtilCalculateDiffTest {
+    private final ExecutorService mExecutor = Executors.newFixedThreadPool(4);
+
+    @After
+    public void tearDown() {
+        mExecutor.shutdownNow();
+    }
+
+    @Test
+    public void trimmedMatchesCalculateDiff() {
+        final Random random = new Random(7);
+        for (int run = 0; run < 300; run++) {
+            final List<Item> oldList = items(random.nextInt(80));
+            final List<Item> newList = mutate(random, oldList, random.nextInt(30));
+            final Callback cb = new Callback(oldList, newList, false);
+            assertSameEdits("run " + run, cb, DiffUtil.calculateDiff(cb, false),
+                    DiffUtil.calculateDiff(cb, false, null));
+        }
+    }
+
+    @Test
+    public void stableIdsMatchCalculateDiff() {
+        final Random random = new Random(11);
+        for (int run = 0; run < 300; run++) {
+            final List<Item> oldList = items(random.nextInt(80));
+            final List<Item> newList = mutate(random, oldList, random.nextInt(30));
+            final Callback cb = new Callback(oldList, newList, true);
+            assertSameEdits("run " + run, cb, DiffUtil.calculateDiff(cb, false),
+                    DiffUtil.calculateDiff(cb, false, null));
+            // with moves, the edit scripts differ but must still produce the new list
+            assertReachesNewList("run " + run, cb, DiffUtil.calculateDiff(cb, true, null));
+        }
+    }
+
+    @Test
+    public void parallelMatchesCalculateDiff() {
+        final Random random = new Random(13);
+        for (int run = 0; run < 20; run++) {
+            // large enough to be split into several ranges of at least PARALLEL_MIN_RANGE_SIZE
+            final List<Item> oldList = items(4000 + random.nextInt(4000));
+            final List<Item> newList = mutate(random, oldList, 200 + random.nextInt(400));
+            final Callback cb = new Callback(oldList, newList, false);
+            assertSameEdits("run " + run, cb, DiffUtil.calculateDiff(cb, false),
+                    DiffUtil.calculateDiff(cb, false, mExecutor));
+        }
+    }
+
+    @Test
+    public void parallelOnDirectExecutor() {
+        // helpers run on the calling thread before it drains the queue itself
+        final Random random = new Random(17);
+        final List<Item> oldList = items(5000);
+        final List<Item> newList = mutate(random, oldList, 300);
+        final Callback cb = new Callback(oldList, newList, false);
+        assertSameEdits("direct", cb, DiffUtil.calculateDiff(cb, false),
+                DiffUtil.calculateDiff(cb, false, new Executor() {
+                    @Override
+                    public void execute(Runnable command) {
+                        command.run();
+                    }
+                }));
+    }
+
+    /**
+     * Both results must produce the new list and, being minimal, remove and insert the same
+     * number of items.
+     */
+    private static void assertSameEdits(String message, Callback cb, DiffUtil.DiffResult expected,
+            DiffUtil.DiffResult actual) {
+        final Replay expectedReplay = assertReachesNewList(message, cb, expected);
+        final Replay actualReplay = assertReachesNewList(message, cb, actual);
+        assertEquals(message, expectedReplay.mInserted, actualReplay.mInserted);
+        assertEquals(message, expectedReplay.mRemoved, actualReplay.mRemoved);
+    }
+
+    /**
+     * Replays the result on the slots of the old list and checks that every slot ends up at its
+     * position in the new list, marked as changed exactly when its contents changed.
+     */
+    private static Replay assertReachesNewList(String message, Callback cb,
+            DiffUtil.DiffResult result) {
+        final Replay replay = new Replay(cb.mOldList.size());
+        result.dispatchUpdatesTo(replay);
+        assertEquals(message, cb.mNewList.size(), replay.mSlots.size());
+        for (int i = 0; i < replay.mSlots.size(); i++) {
+            final Slot slot = replay.mSlots.get(i);
+            final Item newItem = cb.mNewList.get(i);
+            if (slot.mOldPosition == DiffUtil.DiffResult.NO_POSITION) {
+                assertEquals(message, DiffUtil.DiffResult.NO_POSITION,
+                        result.convertNewPositionToOld(i));
+                continue;
+            }
+            final Item oldItem = cb.mOldList.get(slot.mOldPosition);
+            assertEquals(message, oldItem.mId, newItem.mId);
+            assertEquals(message, i, result.convertOldPositionToNew(slot.mOldPosition));
+            assertEquals(message, oldItem.mVersion != newItem.mVersion, slot.mChanged);
+        }
+        return replay;
+    }
+
+    private static List<Item> items(int count) {
+        final List<Item> list = new ArrayList<>();
+        for (int id = 0; id < count; id++) {
+            list.add(new Item(id, 0));
+        }
+        return list;
+    }
+
+    /** Applies the given number of random edits, each touching a short run of items. */
+    private static List<Item> mutate(Random random, List<Item> oldList, int edits) {
+        final List<Item> list = new ArrayList<>(oldList);
+        int nextId = oldList.size();
+        for (int edit = 0; edit < edits; edit++) {
+            final int position = random.nextInt(list.size() + 1);
+            final int count = 1 + random.nextInt(4);
+            switch (random.nextInt(4)) {
+                case 0:
+                    for (int i = 0; i < count; i++) {
+                        list.add(position, new Item(nextId++, 0));
+                    }
+                    break;
+                case 1:
+                    for (int i = 0; i < count && position < list.size(); i++) {
+                        list.remove(position);
+                    }
+                    break;
+                case 2:
+                    if (position < list.size()) {
+                        // moved
+                        final Item moved = list.remove(position);
+                        list.add(random.nextInt(list.size() + 1), moved);
+                    }
+                    break;
+                default:
+                    for (int i = position; i < position + count && i < list.size(); i++) {
+                        final Item item = list.get(i);
+                        list.set(i, new Item(item.mId, item.mVersion + 1));
+                    }
+                    break;
+            }
+        }
+        return list;
+    }
+
+    static final class Item {
+        final int mId;
+        final int mVersion;
+
+        Item(int id, int version) {
+            mId = id;
+            mVersion = version;
+        }
+    }
+
+    static final class Callback extends DiffUtil.Callback {
+        final List<Item> mOldList;
+        final List<Item> mNewList;
+        private final boolean mStableIds;
+
+        Callback(List<Item> oldList, List<Item> newList, boolean stableIds) {
+            mOldList = oldList;
+            mNewList = newList;
+            mStableIds = stableIds;
+        }
+
+        @Override
+        public int getOldListSize() {
+            return mOldList.size();
+        }
+
+        @Override
+        public int getNewListSize() {
+            return mNewList.size();
+        }
+
+        @Override
+        public boolean areItemsTheSame(int oldItemPosition, int newItemPosition) {
+            return mOldList.get(oldItemPosition).mId == mNewList.get(newItemPosition).mId;
+        }
+
+        @Override
+        public boolean areContentsTheSame(int oldItemPosition, int newItemPosition) {
+            return mOldList.get(oldItemPosition).mVersion
+                    == mNewList.get(newItemPosition).mVersion;
+        }
+
+        @Override
+        public boolean hasStableIds() {
+            return mStableIds;
+        }
+
+        @Override
+        public long getOldItemId(int oldItemPosition) {
+            return mOldList.get(oldItemPosition).mId;
+        }
+
+        @Override
+        public long getNewItemId(int newItemPosition) {
+            return mNewList.get(newItemPosition).mId;
+        }
+    }
+
+    static final class Slot {
+        final int mOldPosition;
+        boolean mChanged;
+
+        Slot(int oldPosition) {
+            mOldPosition = oldPosition;
+        }
+    }
+
+    static final class Replay implements ListUpdateCallback {
+        final List<Slot> mSlots = new ArrayList<>();
+        int mInserted;
+        int mRemoved;
+
+        Replay(int oldSize) {
+            for (int i = 0; i < oldSize; i++) {
+                mSlots.add(new Slot(i));
+            }
+        }
+
+        @Override
+        public void onInserted(int position, int count) {
+            mInserted += count;
+            for (int i = 0; i < count; i++) {
+                mSlots.add(position, new Slot(DiffUtil.DiffResult.NO_POSITION));
+            }
+        }
+
+        @Override
+        public void onRemoved(int position, int count) {
+            mRemoved += count;
+            mSlots.subList(position, position + count).clear();
+        }
+
+        @Override
+        public void onMoved(int fromPosition, int toPosition) {
+            mSlots.add(toPosition, mSlots.remove(fromPosition));
+        }
+
+        @Override
+        public void onChanged(int position, int count, Object payload) {
+            for (int i = position; i < position + count; i++) {
+                assertTrue(mSlots.get(i).mOldPosition != DiffUtil.DiffResult.NO_POSITION);
+                mSlots.get(i).mChanged = true;
+            }
+        }
+    }
+}
@@ -0,0 +1,213 @@
+/*
+ * Copyright 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package androidx.recyclerview.widget;
+
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertSame;
+import static org.junit.Assert.assertTrue;
+
+import androidx.annotation.Nullable;
+
+import org.junit.Before;
+import org.junit.Test;
+import org.junit.runner.RunWith;
+import org.junit.runners.JUnit4;
+
+import java.util.ArrayList;
+import java.util.HashMap;
+import java.util.List;
+import java.util.Map;
+import java.util.Random;
+
+@RunWith(JUnit4.class)
+public class SortedListTest {
+    private SortedList<Item> mList;
+    private int mSize;
+    private int mChanged;
+
+    @Before
+    public void setUp() {
+        mSize = 0;
+        mChanged = 0;
+        mList = new SortedList<>(Item.class, new SortedList.Callback<Item>() {
+            @Override
+            public int compare(Item o1, Item o2) {
+                return compareItems(o1, o2);
+            }
+
+            @Override
+            public void onInserted(int position, int count) {
+                mSize += count;
+            }
+
+            @Override
+            public void onRemoved(int position, int count) {
+                mSize -= count;
+            }
+
+            @Override
+            public void onMoved(int fromPosition, int toPosition) {
+            }
+
+            @Override
+            public void onChanged(int position, int count) {
+                mChanged += count;
+            }
+
+            @Override
+            public boolean areContentsTheSame(Item oldItem, Item newItem) {
+                return oldItem.mCmpField == newItem.mCmpField && oldItem.mData == newItem.mData;
+            }
+
+            @Override
+            public boolean areItemsTheSame(Item item1, Item item2) {
+                return item1.mId == item2.mId;
+            }
+
+            @Nullable
+            @Override
+            public Object getChangePayload(Item item1, Item item2) {
+                return null;
+            }
+        });
+        for (int i = 0; i < 5; i++) {
+            mList.add(new Item(i, i * 10));
+        }
+    }
+
+    @Test
+    public void bufferedRepeatedUpdateWithChangedKey() {
+        mList.seslBeginBufferedUpdates();
+        mList.updateItemAt(1, new Item(1, 25));
+        final Item last = new Item(1, 45);
+        mList.updateItemAt(1, last);
+        mList.seslEndBufferedUpdates();
+
+        assertIds(0, 2, 3, 4, 1);
+        assertSame(last, mList.get(4));
+        assertEquals(mList.size(), mSize);
+    }
+
+    @Test
+    public void bufferedUpdateThenRemove() {
+        mList.seslBeginBufferedUpdates();
+        final Item updated = new Item(1, 25);
+        mList.updateItemAt(1, updated);
+        mList.remove(updated);
+        // the item as of the last flush, with its old sort key
+        mList.updateItemAt(3, new Item(3, 5));
+        mList.remove(new Item(3, 30));
+        mList.seslEndBufferedUpdates();
+
+        assertIds(0, 2, 4);
+        assertEquals(mList.size(), mSize);
+    }
+
+    @Test
+    public void bufferedRemoveThenAdd() {
+        mList.seslBeginBufferedUpdates();
+        final Item updated = new Item(2, 35);
+        mList.updateItemAt(2, updated);
+        mList.remove(updated);
+        mList.add(updated);
+        mList.seslEndBufferedUpdates();
+
+        assertIds(0, 1, 3, 2, 4);
+        assertEquals(mList.size(), mSize);
+    }
+
+    @Test
+    public void bufferedUpdateBurstsMixedWithAdds() {
+        final Random random = new Random(17);
+        final Map<Integer, Item> expected = new HashMap<>();
+        for (int i = 0; i < mList.size(); i++) {
+            expected.put(mList.get(i).mId, mList.get(i));
+        }
+        int nextId = mList.size();
+        mList.seslBeginBufferedUpdates();
+        for (int frame = 0; frame < 20; frame++) {
+            final int flushedSize = mList.size();
+            for (int i = 0; i < 50; i++) {
+                if (random.nextInt(3) == 0) {
+                    final Item item = new Item(nextId++, random.nextInt(1000));
+                    mList.add(item);
+                    expected.put(item.mId, item);
+                } else if (flushedSize > 0) {
+                    final int index = random.nextInt(flushedSize);
+                    final Item item = new Item(mList.get(index).mId, random.nextInt(1000));
+                    item.mData = i;
+                    mList.updateItemAt(index, item);
+                    expected.put(item.mId, item);
+                }
+            }
+            mList.seslFlushBufferedUpdates();
+
+            assertEquals(expected.size(), mList.size());
+            assertEquals(mList.size(), mSize);
+            for (int i = 0; i < mList.size(); i++) {
+                final Item item = mList.get(i);
+                assertSame(expected.get(item.mId), item);
+                if (i > 0) {
+                    assertTrue(compareItems(mList.get(i - 1), item) < 0);
+                }
+            }
+        }
+        mList.seslEndBufferedUpdates();
+    }
+
+    @Test
+    public void bufferedUpdateInPlaceIsChange() {
+        mList.seslBeginBufferedUpdates();
+        final Item updated = new Item(2, 20);
+        updated.mData = 1;
+        mList.updateItemAt(2, updated);
+        mList.seslEndBufferedUpdates();
+
+        assertIds(0, 1, 2, 3, 4);
+        assertSame(updated, mList.get(2));
+        assertEquals(1, mChanged);
+        assertEquals(5, mSize);
+    }
+
+    static int compareItems(Item o1, Item o2) {
+        final int result = Integer.compare(o1.mCmpField, o2.mCmpField);
+        return result != 0 ? result : Integer.compare(o1.mId, o2.mId);
+    }
+
+    private void assertIds(int... ids) {
+        final List<Integer> actual = new ArrayList<>();
+        for (int i = 0; i < mList.size(); i++) {
+            actual.add(mList.get(i).mId);
+        }
+        final List<Integer> expected = new ArrayList<>();
+        for (int id : ids) {
+            expected.add(id);
+        }
+        assertEquals(expected, actual);
+    }
+
+    static class Item {
+        final int mId;
+        final int mCmpField;
+        int mData;
+
+        Item(int id, int cmpField) {
+            mId = id;
+            mCmpField = cmpField;
+        }
+    }
+}
@@ -17,6 +17,7 @@
 package androidx.swiperefreshlayout.widget;
 
 import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertFalse;
 import static org.junit.Assert.assertTrue;
 import static org.mockito.ArgumentMatchers.any;
 import static org.mockito.ArgumentMatchers.anyBoolean;
@@ -29,8 +30,10 @@ import android.graphics.Canvas;
 import android.graphics.Paint;
 import android.graphics.Rect;
 import android.graphics.RectF;
+import android.graphics.drawable.AnimatedVectorDrawable;
 
 import androidx.test.ext.junit.runners.AndroidJUnit4;
+import androidx.test.filters.SdkSuppress;
 import androidx.test.filters.SmallTest;
 
 import org.junit.Before;
@@ -40,6 +43,9 @@ import org.junit.runner.RunWith;
 import org.mockito.ArgumentCaptor;
 import org.mockito.Mock;
 
+import java.util.concurrent.CountDownLatch;
+import java.util.concurrent.TimeUnit;
+
 /**
  * Tests for CircularProgressDrawable
  */
@@ -97,4 +103,38 @@ public class CircularProgressDrawableTest {
         assertEquals((radius + strokeWidth / 2f) * 2, boundsCaptor.getValue().width(), 0.5);
         assertEquals((radius + strokeWidth / 2f) * 2, boundsCaptor.getValue().height(), 0.5);
     }
+
+    @Test
+    @SmallTest
+    @SdkSuppress(minSdkVersion = 25)
+    public void endCallbackSetWhileLoopingFiresAfterOneCycle() throws Throwable {
+        final CountDownLatch ended = new CountDownLatch(1);
+        final AnimatedVectorDrawable oneShot =
+                (AnimatedVectorDrawable) mDrawableUnderTest.mDotAnimation;
+        mActivityTestRule.runOnUiThread(new Runnable() {
+            @Override
+            public void run() {
+                mDrawableUnderTest.startDotAnimation();
+                // no callback yet, so the RenderThread loops the dots
+                assertTrue(mDrawableUnderTest.isRunning());
+                assertFalse(oneShot.isRunning());
+
+                mDrawableUnderTest.setOnAnimationEndCallback(
+                        new CircularProgressDrawable.OnAnimationEndCallback() {
+                            @Override
+                            public void OnAnimationEnd() {
+                                ended.countDown();
+                            }
+                        });
+                assertTrue(oneShot.isRunning());
+            }
+        });
+        assertTrue(ended.await(3, TimeUnit.SECONDS));
+        mActivityTestRule.runOnUiThread(new Runnable() {
+            @Override
+            public void run() {
+                mDrawableUnderTest.stop();
+            }
+        });
+    }
 }
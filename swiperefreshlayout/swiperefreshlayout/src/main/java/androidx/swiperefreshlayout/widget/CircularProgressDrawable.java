@@ -97,6 +97,15 @@ public class CircularProgressDrawable extends Drawable implements Animatable {
             0.4f,
             1.0f);
     Drawable mDotAnimation;
+    /**
+     * Repeating variant of {@link #mDotAnimation}, or null below API 25. It is picked when the
+     * dot animation starts with no {@link OnAnimationEndCallback} set: the RenderThread loops it
+     * by itself, so the dots keep moving while the main thread is busy, which is when a refresh
+     * spinner is usually visible. Setting a callback while it runs switches back to
+     * {@link #mDotAnimation}, whose cycles end.
+     */
+    private Drawable mDotLoopAnimation;
+    private Animatable2.AnimationCallback mDotAnimationCallback;
     final float mScreenDensity;
     private Animator mRotateAnimtior;
 
@@ -140,6 +149,11 @@ public class CircularProgressDrawable extends Drawable implements Animatable {
 
         mDotAnimation.setAlpha(0);
         mFourDot.setDotAnimtion(mDotAnimation);
+        if (Build.VERSION.SDK_INT >= Build.VERSION_CODES.N_MR1) {
+            mDotLoopAnimation = contextThemeWrapper.getResources().getDrawable(
+                    R.drawable.sesl_swipe_refresh_animated_loop, contextThemeWrapper.getTheme());
+            mDotLoopAnimation.setAlpha(0);
+        }
         //sesl
 
         setupAnimators();
@@ -272,7 +286,9 @@ public class CircularProgressDrawable extends Drawable implements Animatable {
     @Override
     public boolean isRunning() {
         return mAnimator.isRunning()
-                || ((AnimatedVectorDrawable) mDotAnimation).isRunning()/*sesl*/;
+                || ((AnimatedVectorDrawable) mDotAnimation).isRunning()/*sesl*/
+                || (mDotLoopAnimation != null
+                        && ((AnimatedVectorDrawable) mDotLoopAnimation).isRunning())/*sesl*/;
     }
 
     /**
@@ -299,6 +315,10 @@ public class CircularProgressDrawable extends Drawable implements Animatable {
             ((AnimatedVectorDrawable) mDotAnimation).clearAnimationCallbacks();
         }
         mDotAnimation.setAlpha(0);
+        if (mDotLoopAnimation != null) {
+            ((AnimatedVectorDrawable) mDotLoopAnimation).stop();
+            mDotLoopAnimation.setAlpha(0);
+        }
         mFourDot.setPosition(0);
         mFourDot.setIsRunning(false);
         mRotateAnimtior.cancel();
@@ -365,7 +385,6 @@ public class CircularProgressDrawable extends Drawable implements Animatable {
                 //Sesl
                 fourDot.setRotation(0);
                 fourDot.setIsRunning(true);
-                mDotAnimation.setAlpha(255);
                 fourDot.setAlpha(0);
                 startDotAnimation();
                 //sesl
@@ -400,6 +419,7 @@ public class CircularProgressDrawable extends Drawable implements Animatable {
         float mRotation = 0f;
         //Sesl
         final Paint mDotPaint = new Paint();
+        final RectF mDotBounds = new RectF();
         Drawable mDotAnimation;
         float mPosition = 0f;
         float mDotRadius;
@@ -428,7 +448,7 @@ public class CircularProgressDrawable extends Drawable implements Animatable {
          * Draw the progress spinner
          */
         void draw(Canvas c, Rect bounds) {
-            final RectF dotBounds = new RectF();
+            final RectF dotBounds = mDotBounds;
             dotBounds.set(bounds.centerX() - mCenterRadius,
                     bounds.centerY() - mCenterRadius,
                     bounds.centerX() + mCenterRadius,
@@ -552,24 +572,47 @@ public class CircularProgressDrawable extends Drawable implements Animatable {
 
     //Sesl
     void startDotAnimation() {
+        if (mDotLoopAnimation != null && mAnimationEndCallback == null) {
+            mFourDot.setDotAnimtion(mDotLoopAnimation);
+            mDotLoopAnimation.setAlpha(255);
+            ((AnimatedVectorDrawable) mDotLoopAnimation).start();
+            return;
+        }
+
+        mFourDot.setDotAnimtion(mDotAnimation);
+        mDotAnimation.setAlpha(255);
         ((AnimatedVectorDrawable) mDotAnimation).start();
         if (Build.VERSION.SDK_INT >= Build.VERSION_CODES.M) {
-            ((AnimatedVectorDrawable) mDotAnimation).registerAnimationCallback(new Animatable2.AnimationCallback() {
-                @Override
-                public void onAnimationEnd(Drawable drawable) {
-                    if (mAnimationEndCallback != null) {
-                        mAnimationEndCallback.OnAnimationEnd();
+            if (mDotAnimationCallback == null) {
+                mDotAnimationCallback = new Animatable2.AnimationCallback() {
+                    @Override
+                    public void onAnimationEnd(Drawable drawable) {
+                        if (mAnimationEndCallback != null) {
+                            mAnimationEndCallback.OnAnimationEnd();
+                        }
+                        ((AnimatedVectorDrawable) mDotAnimation).start();
+                        invalidateSelf();
                     }
-                    ((AnimatedVectorDrawable) mDotAnimation).start();
-                    invalidateSelf();
-                }
-            });
+                };
+            }
+            // start() may run again before stop(), which would otherwise register it twice
+            ((AnimatedVectorDrawable) mDotAnimation).unregisterAnimationCallback(
+                    mDotAnimationCallback);
+            ((AnimatedVectorDrawable) mDotAnimation).registerAnimationCallback(
+                    mDotAnimationCallback);
         }
     }
 
     @RestrictTo(LIBRARY)
     void setOnAnimationEndCallback(OnAnimationEndCallback callback) {
         mAnimationEndCallback = callback;
+        if (callback != null && mDotLoopAnimation != null
+                && ((AnimatedVectorDrawable) mDotLoopAnimation).isRunning()) {
+            // the loop never ends a cycle, so the dots go on with the one-shot drawable
+            ((AnimatedVectorDrawable) mDotLoopAnimation).stop();
+            mDotLoopAnimation.setAlpha(0);
+            startDotAnimation();
+        }
     }
 
     /**
@@ -0,0 +1,153 @@
+/*
+ * Copyright 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package androidx.viewpager2.adapter;
+
+import static androidx.viewpager2.adapter.SavedStateBudgetActivity.PAGE_COUNT;
+import static androidx.viewpager2.adapter.SavedStateBudgetActivity.sRestored;
+
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertFalse;
+import static org.junit.Assert.assertTrue;
+
+import android.os.Bundle;
+
+import androidx.test.core.app.ActivityScenario;
+import androidx.test.ext.junit.runners.AndroidJUnit4;
+import androidx.test.filters.LargeTest;
+import androidx.test.platform.app.InstrumentationRegistry;
+
+import org.junit.After;
+import org.junit.Before;
+import org.junit.Test;
+import org.junit.runner.RunWith;
+
+import java.util.Arrays;
+
+@RunWith(AndroidJUnit4.class)
+@LargeTest
+public class FragmentStateAdapterSavedStateTest {
+
+    private ActivityScenario<SavedStateBudgetActivity> mScenario;
+
+    @Before
+    public void setUp() {
+        SavedStateBudgetActivity.sSavedStateBudget =
+                FragmentStateAdapter.SAVED_STATE_BUDGET_UNLIMITED;
+        Arrays.fill(sRestored, false);
+        mScenario = ActivityScenario.launch(SavedStateBudgetActivity.class);
+    }
+
+    @After
+    public void tearDown() {
+        mScenario.close();
+    }
+
+    @Test
+    public void budgetEvictsStatesFarthestFromCurrentItem() {
+        visitAllPages();
+        final long[] usage = new long[2];
+        mScenario.onActivity(activity -> {
+            usage[0] = activity.mAdapter.getSavedStateSizeBytes();
+            usage[1] = activity.mAdapter.getSavedStateCount();
+        });
+        // nothing is measured without a budget
+        assertEquals(0, usage[0]);
+        assertTrue(usage[1] > 4);
+
+        final int[] budget = new int[1];
+        mScenario.onActivity(activity -> {
+            // measures every state, then keeps about three
+            final FragmentStateAdapter adapter = activity.mAdapter;
+            adapter.setSavedStateBudget(Integer.MAX_VALUE);
+            final long stateSize = adapter.getSavedStateSizeBytes() / adapter.getSavedStateCount();
+            budget[0] = (int) (stateSize * 3 + stateSize / 2);
+            adapter.setSavedStateBudget(budget[0]);
+            assertTrue(adapter.getSavedStateSizeBytes() <= budget[0]);
+        });
+
+        setCurrentItem(5);
+        assertTrue(sRestored[5]);
+        setCurrentItem(0);
+        assertFalse(sRestored[0]);
+        mScenario.onActivity(activity ->
+                assertTrue(activity.mAdapter.getSavedStateSizeBytes() <= budget[0]));
+    }
+
+    @Test
+    public void restoredStatesAreReadWhenTheirPageIsBound() {
+        visitAllPages();
+        final int[] savedStateCount = new int[1];
+        mScenario.onActivity(activity ->
+                savedStateCount[0] = activity.mAdapter.getSavedStateCount());
+
+        mScenario.recreate();
+        mScenario.onActivity(activity ->
+                assertEquals(savedStateCount[0], activity.mAdapter.getSavedStateCount()));
+
+        setCurrentItem(0);
+        assertTrue(sRestored[0]);
+    }
+
+    @Test
+    public void restoredStatesKeepToTheBudget() {
+        visitAllPages();
+        final int[] budget = new int[1];
+        mScenario.onActivity(activity -> {
+            final FragmentStateAdapter adapter = activity.mAdapter;
+            adapter.setSavedStateBudget(Integer.MAX_VALUE);
+            final long stateSize = adapter.getSavedStateSizeBytes() / adapter.getSavedStateCount();
+            budget[0] = (int) (stateSize * 2 + stateSize / 2);
+        });
+        SavedStateBudgetActivity.sSavedStateBudget = budget[0];
+
+        mScenario.recreate();
+        InstrumentationRegistry.getInstrumentation().waitForIdleSync();
+        // the restored states are measured and trimmed before their pages are bound
+        mScenario.onActivity(activity -> {
+            final FragmentStateAdapter adapter = activity.mAdapter;
+            assertTrue(adapter.getSavedStateSizeBytes() <= budget[0]);
+            assertTrue(adapter.getSavedStateCount() <= 2);
+            final Bundle savedState = (Bundle) adapter.saveState();
+            int stateCount = 0;
+            for (String key : savedState.keySet()) {
+                if (key.startsWith("s#")) {
+                    stateCount++;
+                }
+            }
+            assertTrue(stateCount <= 2);
+        });
+
+        // the states nearest to the current item are the ones kept
+        setCurrentItem(PAGE_COUNT - 2);
+        assertTrue(sRestored[PAGE_COUNT - 2]);
+        setCurrentItem(0);
+        assertFalse(sRestored[0]);
+        mScenario.onActivity(activity ->
+                assertTrue(activity.mAdapter.getSavedStateSizeBytes() <= budget[0]));
+    }
+
+    private void visitAllPages() {
+        for (int page = 0; page < PAGE_COUNT; page++) {
+            setCurrentItem(page);
+        }
+    }
+
+    private void setCurrentItem(int page) {
+        mScenario.onActivity(activity -> activity.mViewPager.setCurrentItem(page, false));
+        InstrumentationRegistry.getInstrumentation().waitForIdleSync();
+    }
+}
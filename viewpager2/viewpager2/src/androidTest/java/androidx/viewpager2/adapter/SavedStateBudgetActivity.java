@@ -0,0 +1,96 @@
+/*
+ * Copyright 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package androidx.viewpager2.adapter;
+
+import android.os.Bundle;
+import android.view.LayoutInflater;
+import android.view.View;
+import android.view.ViewGroup;
+import android.widget.TextView;
+
+import androidx.annotation.NonNull;
+import androidx.annotation.Nullable;
+import androidx.fragment.app.Fragment;
+import androidx.fragment.app.FragmentActivity;
+import androidx.viewpager2.test.R;
+import androidx.viewpager2.widget.ViewPager2;
+
+/**
+ * Hosts a {@link ViewPager2} of {@link PageFragment}s, recording for each page whether its
+ * latest Fragment was created from a saved state.
+ */
+public class SavedStateBudgetActivity extends FragmentActivity {
+    static final int PAGE_COUNT = 10;
+
+    /** Budget set before the adapter is attached, survives recreation. */
+    static int sSavedStateBudget = FragmentStateAdapter.SAVED_STATE_BUDGET_UNLIMITED;
+    static final boolean[] sRestored = new boolean[PAGE_COUNT];
+
+    ViewPager2 mViewPager;
+    FragmentStateAdapter mAdapter;
+
+    @Override
+    protected void onCreate(@Nullable Bundle savedInstanceState) {
+        super.onCreate(savedInstanceState);
+        setContentView(R.layout.activity_test_layout);
+        mViewPager = findViewById(R.id.view_pager);
+        mAdapter = new FragmentStateAdapter(this) {
+            @NonNull
+            @Override
+            public Fragment createFragment(int position) {
+                final PageFragment fragment = new PageFragment();
+                final Bundle args = new Bundle();
+                args.putInt(PageFragment.ARG_PAGE, position);
+                fragment.setArguments(args);
+                return fragment;
+            }
+
+            @Override
+            public int getItemCount() {
+                return PAGE_COUNT;
+            }
+        };
+        mAdapter.setSavedStateBudget(sSavedStateBudget);
+        mViewPager.setAdapter(mAdapter);
+    }
+
+    public static class PageFragment extends Fragment {
+        static final String ARG_PAGE = "page";
+        private static final String KEY_SAVED = "saved";
+
+        @Override
+        public void onCreate(@Nullable Bundle savedInstanceState) {
+            super.onCreate(savedInstanceState);
+            sRestored[requireArguments().getInt(ARG_PAGE)] = savedInstanceState != null
+                    && savedInstanceState.getBoolean(KEY_SAVED);
+        }
+
+        @Override
+        public View onCreateView(@NonNull LayoutInflater inflater, @Nullable ViewGroup container,
+                @Nullable Bundle savedInstanceState) {
+            final TextView view = new TextView(inflater.getContext());
+            view.setText(String.valueOf(requireArguments().getInt(ARG_PAGE)));
+            return view;
+        }
+
+        @Override
+        public void onSaveInstanceState(@NonNull Bundle outState) {
+            super.onSaveInstanceState(outState);
+            outState.putBoolean(KEY_SAVED, true);
+        }
+    }
+}
@@ -25,7 +25,9 @@ import static androidx.viewpager2.adapter.FragmentStateAdapter.FragmentTransacti
 import android.os.Bundle;
 import android.os.Handler;
 import android.os.Looper;
+import android.os.Parcel;
 import android.os.Parcelable;
+import android.view.Display;
 import android.view.View;
 import android.view.ViewGroup;
 import android.view.ViewParent;
@@ -38,6 +40,7 @@ import androidx.annotation.OptIn;
 import androidx.annotation.RequiresOptIn;
 import androidx.collection.ArraySet;
 import androidx.collection.LongSparseArray;
+import androidx.core.view.ViewCompat;
 import androidx.fragment.app.Fragment;
 import androidx.fragment.app.FragmentActivity;
 import androidx.fragment.app.FragmentManager;
@@ -53,6 +56,7 @@ import java.util.Collections;
 import java.util.List;
 import java.util.Set;
 import java.util.concurrent.CopyOnWriteArrayList;
+import java.util.concurrent.TimeUnit;
 
 /**
  * Similar in behavior to {@link androidx.fragment.app.FragmentStatePagerAdapter
@@ -72,6 +76,13 @@ import java.util.concurrent.CopyOnWriteArrayList;
  */
 public abstract class FragmentStateAdapter extends
         RecyclerView.Adapter<FragmentViewHolder> implements StatefulAdapter {
+    /**
+     * Budget value that keeps every saved state in memory. This is the default.
+     *
+     * @see #setSavedStateBudget(int)
+     */
+    public static final int SAVED_STATE_BUDGET_UNLIMITED = -1;
+
     // State saving config
     private static final String KEY_PREFIX_FRAGMENT = "f#";
     private static final String KEY_PREFIX_STATE = "s#";
@@ -90,8 +101,23 @@ public abstract class FragmentStateAdapter extends
     private final LongSparseArray<Fragment.SavedState> mSavedStates = new LongSparseArray<>();
     private final LongSparseArray<Integer> mItemIdToViewHolder = new LongSparseArray<>();
 
+    // Saved state budget, see #setSavedStateBudget
+    private int mSavedStateBudgetBytes = SAVED_STATE_BUDGET_UNLIMITED;
+    private final LongSparseArray<SavedStateInfo> mSavedStateInfo = new LongSparseArray<>();
+    private long mSavedStateBytes;
+    private long mSavedStateAccessCount;
+    // states restored by #restoreState, unparcelled only once their page is bound
+    private Bundle mPendingStates;
+    private final Set<Long> mPendingStateIds = new ArraySet<>();
+
     private FragmentMaxLifecycleEnforcer mFragmentMaxLifecycleEnforcer;
 
+    // Page pre-creation, see #setPreCreatePageCount
+    private int mPreCreatePageCount = 0;
+    @SuppressWarnings("WeakerAccess") // to avoid creation of a synthetic accessor
+    final LongSparseArray<Integer> mPreCreatedItems = new LongSparseArray<>();
+    private FragmentPreCreator mFragmentPreCreator;
+
     @SuppressWarnings("WeakerAccess") // to avoid creation of a synthetic accessor
             FragmentEventDispatcher mFragmentEventDispatcher = new FragmentEventDispatcher();
 
@@ -141,15 +167,52 @@ public abstract class FragmentStateAdapter extends
         checkArgument(mFragmentMaxLifecycleEnforcer == null);
         mFragmentMaxLifecycleEnforcer = new FragmentMaxLifecycleEnforcer();
         mFragmentMaxLifecycleEnforcer.register(recyclerView);
+        mFragmentPreCreator = new FragmentPreCreator();
+        mFragmentPreCreator.register(recyclerView);
     }
 
     @CallSuper
     @Override
     public void onDetachedFromRecyclerView(@NonNull RecyclerView recyclerView) {
+        mFragmentPreCreator.unregister(recyclerView);
+        mFragmentPreCreator = null;
         mFragmentMaxLifecycleEnforcer.unregister(recyclerView);
         mFragmentMaxLifecycleEnforcer = null;
     }
 
+    /**
+     * Sets how many pages on each side of the current item should have their {@link Fragment}
+     * created ahead of time, beyond the pages {@link ViewPager2#setOffscreenPageLimit} already
+     * lays out.
+     * <p>
+     * Pre-created Fragments are added and moved up to {@link Lifecycle.State#STARTED STARTED},
+     * which builds their views, one page per frame and only while the pager is not settling and
+     * the frame has time left for it. Pages in the predicted swipe direction come first. When such
+     * a page is later laid out, its ready-made view is just attached to the page container, which
+     * takes {@link Fragment#onCreateView} out of the scroll frames.
+     * <p>
+     * Views of pre-created Fragments are inflated without a parent, as they are after a
+     * configuration change, so their root layout params fall back to {@code MATCH_PARENT}.
+     *
+     * @param count number of pages to pre-create per side, {@code 0} (default) disables
+     * pre-creation
+     */
+    public void setPreCreatePageCount(int count) {
+        checkArgument(count >= 0);
+        mPreCreatePageCount = count;
+        if (mFragmentPreCreator != null) {
+            mFragmentPreCreator.schedule();
+        }
+    }
+
+    /**
+     * @return number of pages pre-created on each side of the current item
+     * @see #setPreCreatePageCount(int)
+     */
+    public int getPreCreatePageCount() {
+        return mPreCreatePageCount;
+    }
+
     /**
      * Provide a new Fragment associated with the specified position.
      * <p>
@@ -181,6 +244,7 @@ public abstract class FragmentStateAdapter extends
         }
 
         mItemIdToViewHolder.put(itemId, viewHolderId); // this might overwrite an existing entry
+        mPreCreatedItems.remove(itemId); // from now on owned by the ViewHolder
         ensureFragment(position);
 
         /* Special case when {@link RecyclerView} decides to keep the {@link container}
@@ -215,13 +279,14 @@ public abstract class FragmentStateAdapter extends
 
             for (int ix = 0; ix < mFragments.size(); ix++) {
                 long itemId = mFragments.keyAt(ix);
-                if (!isFragmentViewBound(itemId)) {
+                if (!isFragmentViewBound(itemId) && !mPreCreatedItems.containsKey(itemId)) {
                     toRemove.add(itemId);
                 }
             }
         }
 
         for (Long itemId : toRemove) {
+            mPreCreatedItems.remove(itemId);
             removeFragment(itemId);
         }
     }
@@ -260,12 +325,26 @@ public abstract class FragmentStateAdapter extends
 
     private void ensureFragment(int position) {
         long itemId = getItemId(position);
+        if (isSavedStateBudgetEnabled()) {
+            // before obtaining the state, so that a restored state is not trimmed as farthest
+            SavedStateInfo info = mSavedStateInfo.get(itemId);
+            if (info == null) {
+                info = new SavedStateInfo();
+                mSavedStateInfo.put(itemId, info);
+            }
+            info.mPosition = position;
+            info.mLastAccess = ++mSavedStateAccessCount;
+        }
         if (!mFragments.containsKey(itemId)) {
             // TODO(133419201): check if a Fragment provided here is a new Fragment
             Fragment newFragment = createFragment(position);
-            newFragment.setInitialSavedState(mSavedStates.get(itemId));
+            newFragment.setInitialSavedState(obtainSavedState(itemId));
             mFragments.put(itemId, newFragment);
         }
+        if (isSavedStateBudgetEnabled()) {
+            // states restored earlier are trimmed once the current item is known
+            trimSavedStates();
+        }
     }
 
     @Override
@@ -449,11 +528,12 @@ public abstract class FragmentStateAdapter extends
         }
 
         if (!containsItem(itemId)) {
-            mSavedStates.remove(itemId);
+            removeSavedState(itemId);
         }
 
         if (!fragment.isAdded()) {
             mFragments.remove(itemId);
+            pruneSavedStateInfo(itemId);
             return;
         }
 
@@ -468,18 +548,83 @@ public abstract class FragmentStateAdapter extends
             Fragment.SavedState savedState = mFragmentManager.saveFragmentInstanceState(fragment);
             mFragmentEventDispatcher.dispatchPostEvents(onPost);
 
-            mSavedStates.put(itemId, savedState);
+            putSavedState(itemId, savedState);
         }
         List<OnPostEventListener> onPost =
                 mFragmentEventDispatcher.dispatchPreRemoved(fragment);
         try {
             mFragmentManager.beginTransaction().remove(fragment).commitNow();
             mFragments.remove(itemId);
+            pruneSavedStateInfo(itemId);
+        } finally {
+            mFragmentEventDispatcher.dispatchPostEvents(onPost);
+        }
+    }
+
+    /**
+     * Creates the Fragment for {@code position} and takes it to {@link Lifecycle.State#STARTED}
+     * without a container, see {@link #setPreCreatePageCount(int)}.
+     */
+    @SuppressWarnings("WeakerAccess") // to avoid creation of a synthetic accessor
+    void preCreateFragment(int position) {
+        long itemId = getItemId(position);
+        ensureFragment(position);
+        Fragment fragment = mFragments.get(itemId);
+        mPreCreatedItems.put(itemId, position);
+        if (fragment.isAdded()) {
+            return;
+        }
+        List<OnPostEventListener> onPost = mFragmentEventDispatcher.dispatchPreAdded(fragment);
+        try {
+            fragment.setMenuVisibility(false); // appropriate for maxLifecycle == STARTED
+            mFragmentManager.beginTransaction()
+                    .add(fragment, "f" + itemId)
+                    .setMaxLifecycle(fragment, STARTED)
+                    .commitNow();
         } finally {
             mFragmentEventDispatcher.dispatchPostEvents(onPost);
         }
     }
 
+    /**
+     * @return how far from the current item Fragments are pre-created: the pages laid out by
+     * {@link ViewPager2#setOffscreenPageLimit} plus {@link #setPreCreatePageCount(int)}
+     */
+    @SuppressWarnings("WeakerAccess") // to avoid creation of a synthetic accessor
+    int getPreCreateReach() {
+        return Math.max(0, mFragmentMaxLifecycleEnforcer.getOffscreenPageLimit())
+                + mPreCreatePageCount;
+    }
+
+    /**
+     * Removes pre-created Fragments that were not laid out and are now outside of the window
+     * around {@code currentItem}. One page of slack avoids churn on back and forth swipes.
+     */
+    @SuppressWarnings("WeakerAccess") // to avoid creation of a synthetic accessor
+    void trimPreCreatedFragments(int currentItem) {
+        int reach = mPreCreatePageCount == 0 ? -1 : getPreCreateReach() + 1;
+        for (int ix = mPreCreatedItems.size() - 1; ix >= 0; ix--) {
+            long itemId = mPreCreatedItems.keyAt(ix);
+            int position = mPreCreatedItems.valueAt(ix);
+            if (!containsItem(itemId) || Math.abs(position - currentItem) > reach) {
+                mPreCreatedItems.removeAt(ix);
+                if (!isFragmentViewBound(itemId)) {
+                    removeFragment(itemId);
+                }
+            }
+        }
+    }
+
+    /** Hands pre-created Fragments over to the regular GC once their positions are stale. */
+    @SuppressWarnings("WeakerAccess") // to avoid creation of a synthetic accessor
+    void releasePreCreatedFragments() {
+        if (!mPreCreatedItems.isEmpty()) {
+            mPreCreatedItems.clear();
+            mHasStaleFragments = true;
+            gcFragments();
+        }
+    }
+
     @SuppressWarnings("WeakerAccess") // to avoid creation of a synthetic accessor
     boolean shouldDelayFragmentTransactions() {
         return mFragmentManager.isStateSaved();
@@ -518,10 +663,213 @@ public abstract class FragmentStateAdapter extends
                         + "takes care of setting the flag.");
     }
 
+    /**
+     * Bounds the memory used by the saved states of pages that are no longer displayed.
+     * <p>
+     * Whenever the in-memory saved states exceed {@code maxBytes} (measured as their parcelled
+     * size), the states of the pages farthest from the current item are evicted first, with the
+     * least recently bound page losing ties. Evicted states are dropped and their pages start
+     * fresh when bound again.
+     * <p>
+     * Measuring a saved state parcels it once, so a budget adds a small cost to each page that
+     * leaves the offscreen window. States handed to {@link #restoreState(Parcelable)} are read
+     * back and measured right away while a budget is set, instead of when their page is bound.
+     *
+     * @param maxBytes budget in bytes, or {@link #SAVED_STATE_BUDGET_UNLIMITED} to keep every
+     * saved state in memory
+     */
+    public void setSavedStateBudget(int maxBytes) {
+        checkArgument(maxBytes >= 0 || maxBytes == SAVED_STATE_BUDGET_UNLIMITED);
+        boolean wasEnabled = isSavedStateBudgetEnabled();
+        mSavedStateBudgetBytes = maxBytes;
+        if (!isSavedStateBudgetEnabled()) {
+            mSavedStateInfo.clear();
+            mSavedStateBytes = 0;
+            return;
+        }
+        if (!wasEnabled) {
+            for (int ix = 0; ix < mSavedStates.size(); ix++) {
+                SavedStateInfo info = new SavedStateInfo();
+                info.mSizeBytes = measureSavedState(mSavedStates.valueAt(ix));
+                mSavedStateInfo.put(mSavedStates.keyAt(ix), info);
+                mSavedStateBytes += info.mSizeBytes;
+            }
+            adoptPendingStates();
+        }
+        trimSavedStates();
+    }
+
+    /**
+     * @return the parcelled size in bytes of the saved states currently kept in memory, as
+     * measured while a budget is set
+     * @see #setSavedStateBudget(int)
+     */
+    public long getSavedStateSizeBytes() {
+        return mSavedStateBytes;
+    }
+
+    /**
+     * @return the number of saved states held by the adapter, whether in memory or not yet read
+     * back after {@link #restoreState(Parcelable)}
+     */
+    public int getSavedStateCount() {
+        return mSavedStates.size() + mPendingStateIds.size();
+    }
+
+    private boolean isSavedStateBudgetEnabled() {
+        return mSavedStateBudgetBytes != SAVED_STATE_BUDGET_UNLIMITED;
+    }
+
+    private @Nullable Fragment.SavedState obtainSavedState(long itemId) {
+        Fragment.SavedState state = mSavedStates.get(itemId);
+        if (state != null) {
+            return state;
+        }
+        if (mPendingStateIds.remove(itemId)) {
+            state = (Fragment.SavedState) getPendingState(createKey(KEY_PREFIX_STATE, itemId));
+            if (mPendingStateIds.isEmpty()) {
+                mPendingStates = null;
+            }
+        }
+        if (state != null) {
+            putSavedState(itemId, state);
+        }
+        return state;
+    }
+
+    /**
+     * Reads back the states restored by {@link #restoreState(Parcelable)} and measures them, so
+     * that the budget covers them as well.
+     */
+    private void adoptPendingStates() {
+        for (Long itemId : mPendingStateIds) {
+            Fragment.SavedState state = (Fragment.SavedState) getPendingState(
+                    createKey(KEY_PREFIX_STATE, itemId));
+            if (state == null) {
+                continue;
+            }
+            mSavedStates.put(itemId, state);
+            SavedStateInfo info = mSavedStateInfo.get(itemId);
+            if (info == null) {
+                info = new SavedStateInfo();
+                info.mPosition = positionOfRestoredItem(itemId);
+                mSavedStateInfo.put(itemId, info);
+            }
+            mSavedStateBytes -= info.mSizeBytes;
+            info.mSizeBytes = measureSavedState(state);
+            mSavedStateBytes += info.mSizeBytes;
+        }
+        mPendingStateIds.clear();
+        mPendingStates = null;
+    }
+
+    /**
+     * @return the position of a page that has not been bound since its state was restored, as
+     * far as it can be told from the ids, or {@link RecyclerView#NO_POSITION}
+     */
+    private int positionOfRestoredItem(long itemId) {
+        // exact for the default ids, which are the positions
+        if (itemId >= 0 && itemId < getItemCount() && getItemId((int) itemId) == itemId) {
+            return (int) itemId;
+        }
+        return RecyclerView.NO_POSITION;
+    }
+
+    private void putSavedState(long itemId, @Nullable Fragment.SavedState state) {
+        mSavedStates.put(itemId, state);
+        if (!isSavedStateBudgetEnabled()) {
+            return;
+        }
+        SavedStateInfo info = mSavedStateInfo.get(itemId);
+        if (info == null) {
+            info = new SavedStateInfo();
+            mSavedStateInfo.put(itemId, info);
+        }
+        mSavedStateBytes -= info.mSizeBytes;
+        info.mSizeBytes = state != null ? measureSavedState(state) : 0;
+        mSavedStateBytes += info.mSizeBytes;
+        trimSavedStates();
+    }
+
+    private void removeSavedState(long itemId) {
+        mSavedStates.remove(itemId);
+        SavedStateInfo info = mSavedStateInfo.get(itemId);
+        if (info != null) {
+            mSavedStateBytes -= info.mSizeBytes;
+            mSavedStateInfo.remove(itemId);
+        }
+        if (mPendingStateIds.remove(itemId) && mPendingStateIds.isEmpty()) {
+            mPendingStates = null;
+        }
+    }
+
+    /** Forgets the bind bookkeeping of a page that has neither a Fragment nor a saved state. */
+    private void pruneSavedStateInfo(long itemId) {
+        if (isSavedStateBudgetEnabled() && !mSavedStates.containsKey(itemId)) {
+            mSavedStateInfo.remove(itemId);
+        }
+    }
+
+    /** Evicts saved states, farthest from the current item first, until within budget. */
+    private void trimSavedStates() {
+        int currentItem = mFragmentMaxLifecycleEnforcer != null
+                ? mFragmentMaxLifecycleEnforcer.getCurrentItem() : RecyclerView.NO_POSITION;
+        while (mSavedStateBytes > mSavedStateBudgetBytes) {
+            int victim = -1;
+            long victimDistance = -1;
+            long victimAccess = Long.MAX_VALUE;
+            for (int ix = 0; ix < mSavedStates.size(); ix++) {
+                SavedStateInfo info = mSavedStateInfo.get(mSavedStates.keyAt(ix));
+                if (info == null || info.mSizeBytes == 0) {
+                    continue;
+                }
+                long distance = currentItem == RecyclerView.NO_POSITION
+                        || info.mPosition == RecyclerView.NO_POSITION
+                        ? Long.MAX_VALUE : Math.abs((long) info.mPosition - currentItem);
+                if (distance > victimDistance
+                        || (distance == victimDistance && info.mLastAccess < victimAccess)) {
+                    victim = ix;
+                    victimDistance = distance;
+                    victimAccess = info.mLastAccess;
+                }
+            }
+            if (victim < 0) {
+                return;
+            }
+            evictSavedState(mSavedStates.keyAt(victim));
+        }
+    }
+
+    private void evictSavedState(long itemId) {
+        mSavedStates.remove(itemId);
+        SavedStateInfo info = mSavedStateInfo.get(itemId);
+        mSavedStateBytes -= info.mSizeBytes;
+        if (mFragments.containsKey(itemId)) {
+            // the live Fragment outdates this state and saves a fresh one once removed
+            info.mSizeBytes = 0;
+            return;
+        }
+        mSavedStateInfo.remove(itemId);
+    }
+
+    private static int measureSavedState(@NonNull Fragment.SavedState state) {
+        Parcel parcel = Parcel.obtain();
+        try {
+            parcel.writeParcelable(state, 0);
+            return parcel.dataSize();
+        } finally {
+            parcel.recycle();
+        }
+    }
+
     @Override
     public final @NonNull Parcelable saveState() {
         /* TODO(b/122670461): use custom {@link Parcelable} instead of Bundle to save space */
-        Bundle savedState = new Bundle(mFragments.size() + mSavedStates.size());
+        if (isSavedStateBudgetEnabled()) {
+            // restored states not bound since are only trimmed on the next bind
+            trimSavedStates();
+        }
+        Bundle savedState = new Bundle(mFragments.size() + getSavedStateCount() + 1);
 
         /* save references to active fragments */
         for (int ix = 0; ix < mFragments.size(); ix++) {
@@ -542,13 +890,22 @@ public abstract class FragmentStateAdapter extends
             }
         }
 
+        /* States restored earlier but never bound are handed over as they are, there are none
+         * while a budget is set */
+        for (Long itemId : mPendingStateIds) {
+            if (containsItem(itemId)) {
+                String key = createKey(KEY_PREFIX_STATE, itemId);
+                savedState.putParcelable(key, getPendingState(key));
+            }
+        }
+
         return savedState;
     }
 
     @Override
     @SuppressWarnings("deprecation")
     public final void restoreState(@NonNull Parcelable savedState) {
-        if (!mSavedStates.isEmpty() || !mFragments.isEmpty()) {
+        if (getSavedStateCount() > 0 || !mFragments.isEmpty()) {
             throw new IllegalStateException(
                     "Expected the adapter to be 'fresh' while restoring state.");
         }
@@ -569,9 +926,10 @@ public abstract class FragmentStateAdapter extends
 
             if (isValidKey(key, KEY_PREFIX_STATE)) {
                 long itemId = parseIdFromKey(key, KEY_PREFIX_STATE);
-                Fragment.SavedState state = bundle.getParcelable(key);
                 if (containsItem(itemId)) {
-                    mSavedStates.put(itemId, state);
+                    // unparcelled lazily in #obtainSavedState once the page is bound
+                    mPendingStates = bundle;
+                    mPendingStateIds.add(itemId);
                 }
                 continue;
             }
@@ -579,6 +937,11 @@ public abstract class FragmentStateAdapter extends
             throw new IllegalArgumentException("Unexpected key in savedState: " + key);
         }
 
+        if (isSavedStateBudgetEnabled()) {
+            // trimmed on the next bind, the current item is not restored yet
+            adoptPendingStates();
+        }
+
         if (!mFragments.isEmpty()) {
             mHasStaleFragments = true;
             mIsInGracePeriod = true;
@@ -611,6 +974,11 @@ public abstract class FragmentStateAdapter extends
         handler.postDelayed(runnable, GRACE_WINDOW_TIME_MS);
     }
 
+    @SuppressWarnings("deprecation")
+    private @Nullable Parcelable getPendingState(@NonNull String key) {
+        return mPendingStates.getParcelable(key);
+    }
+
     // Helper function for dealing with save / restore state
     private static @NonNull String createKey(@NonNull String prefix, long id) {
         return prefix + id;
@@ -684,6 +1052,14 @@ public abstract class FragmentStateAdapter extends
             mViewPager = null;
         }
 
+        int getCurrentItem() {
+            return mViewPager != null ? mViewPager.getCurrentItem() : RecyclerView.NO_POSITION;
+        }
+
+        int getOffscreenPageLimit() {
+            return mViewPager != null ? mViewPager.getOffscreenPageLimit() : 0;
+        }
+
         void updateFragmentMaxLifecycle(boolean dataSetChanged) {
             if (shouldDelayFragmentTransactions()) {
                 return; /* recovery step via {@link #mLifecycleObserver} */
@@ -761,6 +1137,174 @@ public abstract class FragmentStateAdapter extends
         }
     }
 
+    /**
+     * Pre-creates the Fragments of upcoming pages in frames that have time to spare, see
+     * {@link #setPreCreatePageCount(int)}.
+     */
+    class FragmentPreCreator implements Runnable {
+        // frames an over-budget page may be postponed while idle before it is created anyway
+        private static final int MAX_DEFERRED_FRAMES = 4;
+
+        private ViewPager2.OnPageChangeCallback mPageChangeCallback;
+        private RecyclerView.AdapterDataObserver mDataObserver;
+        private ViewPager2 mViewPager;
+        private long mFrameIntervalNs;
+        private long mAverageCreateNs;
+        private int mDeferredFrames;
+        private int mScrollState = ViewPager2.SCROLL_STATE_IDLE;
+        private int mPredictedDirection = 1;
+        private boolean mScheduled;
+
+        void register(@NonNull RecyclerView recyclerView) {
+            mViewPager = (ViewPager2) recyclerView.getParent();
+            mPageChangeCallback = new ViewPager2.OnPageChangeCallback() {
+                @Override
+                public void onPageScrolled(int position, float positionOffset,
+                        int positionOffsetPixels) {
+                    // ScrollEventAdapter reports the page left of the viewport's start edge, so
+                    // it only lags behind the current item while moving backwards
+                    if (mScrollState == ViewPager2.SCROLL_STATE_DRAGGING && positionOffset > 0) {
+                        mPredictedDirection = position < mViewPager.getCurrentItem() ? -1 : 1;
+                    }
+                }
+
+                @Override
+                public void onPageScrollStateChanged(int state) {
+                    mScrollState = state;
+                    schedule();
+                }
+
+                @Override
+                public void onPageSelected(int position) {
+                    schedule();
+                }
+            };
+            mViewPager.registerOnPageChangeCallback(mPageChangeCallback);
+
+            mDataObserver = new DataSetChangeObserver() {
+                @Override
+                public void onChanged() {
+                    releasePreCreatedFragments();
+                    schedule();
+                }
+            };
+            registerAdapterDataObserver(mDataObserver);
+        }
+
+        void unregister(@NonNull RecyclerView recyclerView) {
+            mViewPager.unregisterOnPageChangeCallback(mPageChangeCallback);
+            unregisterAdapterDataObserver(mDataObserver);
+            recyclerView.removeCallbacks(this);
+            mViewPager.removeCallbacks(this);
+            mScheduled = false;
+            mViewPager = null;
+        }
+
+        void schedule() {
+            if (mScheduled || mViewPager == null
+                    || (mPreCreatePageCount == 0 && mPreCreatedItems.isEmpty())) {
+                return;
+            }
+            mScheduled = true;
+            mDeferredFrames = 0;
+            // runs after the current frame, like RecyclerView's prefetch
+            mViewPager.post(this);
+        }
+
+        @Override
+        public void run() {
+            mScheduled = false;
+            if (mViewPager == null || shouldDelayFragmentTransactions()
+                    || mScrollState == ViewPager2.SCROLL_STATE_SETTLING) {
+                return; // re-scheduled by the next scroll state change
+            }
+            int currentItem = mViewPager.getCurrentItem();
+            int itemCount = getItemCount();
+            if (currentItem >= itemCount) {
+                return;
+            }
+            trimPreCreatedFragments(currentItem);
+
+            int position = nextPositionToCreate(currentItem, itemCount);
+            if (position == RecyclerView.NO_POSITION) {
+                return;
+            }
+
+            long startNs = System.nanoTime();
+            long deadlineNs = getNextFrameNs();
+            boolean fits = mAverageCreateNs == 0 || deadlineNs == 0
+                    || startNs + mAverageCreateNs < deadlineNs;
+            boolean mayOverrun = mScrollState == ViewPager2.SCROLL_STATE_IDLE
+                    && mDeferredFrames >= MAX_DEFERRED_FRAMES;
+            if (!fits && !mayOverrun) {
+                mDeferredFrames++;
+                postNextFrame();
+                return;
+            }
+
+            mDeferredFrames = 0;
+            preCreateFragment(position);
+            long createNs = System.nanoTime() - startNs;
+            mAverageCreateNs = mAverageCreateNs == 0
+                    ? createNs : (mAverageCreateNs / 4 * 3) + (createNs / 4);
+
+            if (nextPositionToCreate(currentItem, itemCount) != RecyclerView.NO_POSITION) {
+                postNextFrame(); // one page per frame
+            }
+        }
+
+        private int nextPositionToCreate(int currentItem, int itemCount) {
+            if (mPreCreatePageCount == 0) {
+                return RecyclerView.NO_POSITION;
+            }
+            int reach = getPreCreateReach();
+            // pages within the offscreen page limit are normally laid out already
+            for (int distance = 1; distance <= reach; distance++) {
+                for (int side = 0; side < 2; side++) {
+                    int position = currentItem + (side == 0 ? mPredictedDirection
+                            : -mPredictedDirection) * distance;
+                    if (position >= 0 && position < itemCount
+                            && !mFragments.containsKey(getItemId(position))) {
+                        return position;
+                    }
+                }
+            }
+            return RecyclerView.NO_POSITION;
+        }
+
+        private void postNextFrame() {
+            mScheduled = true;
+            ViewCompat.postOnAnimation(mViewPager, this);
+        }
+
+        private long getNextFrameNs() {
+            if (mFrameIntervalNs == 0) {
+                // break 60 fps assumption if data from display appears valid
+                Display display = ViewCompat.getDisplay(mViewPager);
+                float refreshRate = 60.0f;
+                if (display != null && display.getRefreshRate() >= 30.0f) {
+                    refreshRate = display.getRefreshRate();
+                }
+                mFrameIntervalNs = (long) (1000000000 / refreshRate);
+            }
+            long lastFrameMs = mViewPager.getDrawingTime();
+            if (lastFrameMs == 0) {
+                return 0;
+            }
+            return TimeUnit.MILLISECONDS.toNanos(lastFrameMs) + mFrameIntervalNs;
+        }
+    }
+
+    /**
+     * Budget bookkeeping for a page: where it was last bound and the size of its in-memory saved
+     * state, if any.
+     */
+    private static class SavedStateInfo {
+        int mPosition = RecyclerView.NO_POSITION;
+        long mLastAccess;
+        int mSizeBytes;
+    }
+
     /**
      * Simplified {@link RecyclerView.AdapterDataObserver} for clients interested in any data-set
      * changes regardless of their nature.